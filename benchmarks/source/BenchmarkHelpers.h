@@ -0,0 +1,73 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include "PluginProcessor.h"
+
+#include <cstdint>
+#include <vector>
+
+
+//==============================================================================
+// Shared setup of the benchmarks. The sweeps report two counters besides the
+// time per block:
+//
+//	ns_per_sample		wall clock per sample frame (all channels of one sample)
+//	realtime_factor		seconds of audio processed per second, 1 is just realtime
+//
+// Run the target with --benchmark_out=<file> --benchmark_out_format=json (or
+// the run_benchmarks target) to keep the results for comparing commits.
+//==============================================================================
+
+namespace BenchmarkHelpers
+{
+
+// Sweep ranges shared by all effects
+const std::vector<int64_t> sweepBlockSizes	= {32, 128, 512, 1024, 4096};
+const std::vector<int64_t> sweepSampleRates = {48000, 96000};
+const std::vector<int64_t> sweepChannels	= {1, 2};
+
+
+// A fresh block every iteration, processing the output again would decay into denormals
+template <typename SampleType>
+void fillWithSine(juce::AudioBuffer<SampleType> &buffer, double sampleRate, SampleType amplitude = SampleType(0.5))
+{
+	for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+	{
+		auto *data = buffer.getWritePointer(channel);
+
+		for (int i = 0; i < buffer.getNumSamples(); ++i)
+			data[i] = amplitude * std::sin(juce::MathConstants<SampleType>::twoPi * SampleType(220) * static_cast<SampleType>(i) / static_cast<SampleType>(sampleRate));
+	}
+}
+
+
+inline void reportSampleCounters(benchmark::State &state, int blockSize, double sampleRate)
+{
+	const double numSamples = static_cast<double>(state.iterations()) * blockSize;
+
+	state.SetItemsProcessed(state.iterations() * blockSize);
+	state.counters["ns_per_sample"]	  = benchmark::Counter(numSamples * 1.0e-9, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+	state.counters["realtime_factor"] = benchmark::Counter(numSamples / sampleRate, benchmark::Counter::kIsRate);
+}
+
+
+// Processes a copy of the same sine block every iteration and reports the sample counters
+template <typename SampleType, typename Process>
+void runBlocks(benchmark::State &state, int numChannels, int blockSize, double sampleRate, Process &&process)
+{
+	juce::AudioBuffer<SampleType> source(numChannels, blockSize);
+	juce::AudioBuffer<SampleType> buffer(numChannels, blockSize);
+	fillWithSine(source, sampleRate);
+
+	for (auto _ : state)
+	{
+		buffer.makeCopyOf(source, true);
+		process(buffer);
+		benchmark::DoNotOptimize(buffer.getReadPointer(0));
+	}
+
+	reportSampleCounters(state, blockSize, sampleRate);
+}
+
+} // namespace BenchmarkHelpers
@@ -0,0 +1,168 @@
+#include "BenchmarkHelpers.h"
+
+
+namespace
+{
+constexpr double delayBenchmarkSampleRate = 48000.0;
+constexpr int	 delayBenchmarkChannels	  = 2;
+constexpr int	 delayBenchmarkBlockSize  = 512;
+} // namespace
+
+
+// Arguments: interpolation, modulated delay time (sample path) or constant delay time (block path)
+static void BM_DelayInterpolation(benchmark::State &state)
+{
+	const auto				 interpolation = static_cast<DelayInterpolation>(state.range(0));
+	const bool				 modulated	   = state.range(1) != 0;
+
+	Delay<float>			 delay;
+	juce::dsp::ProcessSpec	 spec{delayBenchmarkSampleRate, static_cast<juce::uint32>(delayBenchmarkBlockSize), delayBenchmarkChannels};
+	delay.prepare(spec, 2000.0f);
+	delay.setInterpolation(interpolation);
+	delay.setMix(0.5f);
+	delay.setFeedback(0.4f);
+	delay.setChannelDelayTime(0, 250.3f);
+	delay.setChannelDelayTime(1, 375.7f);
+
+	juce::AudioBuffer<float> source(delayBenchmarkChannels, delayBenchmarkBlockSize);
+	juce::AudioBuffer<float> buffer(delayBenchmarkChannels, delayBenchmarkBlockSize);
+	BenchmarkHelpers::fillWithSine(source, delayBenchmarkSampleRate);
+
+	bool toggle = false;
+
+	for (auto _ : state)
+	{
+		// Retargeting every block keeps the delay time smoothing active
+		if (modulated)
+		{
+			toggle = !toggle;
+			delay.setChannelDelayTime(0, toggle ? 251.1f : 250.3f);
+			delay.setChannelDelayTime(1, toggle ? 376.9f : 375.7f);
+		}
+
+		buffer.makeCopyOf(source, true);
+		delay.process(buffer);
+		benchmark::DoNotOptimize(buffer.getReadPointer(0));
+	}
+
+	state.SetItemsProcessed(state.iterations() * delayBenchmarkBlockSize);
+}
+
+BENCHMARK(BM_DelayInterpolation)
+	->ArgNames({"interpolation", "modulated"})
+	->ArgsProduct({{LinearInterpolation, LagrangeInterpolation, ThiranInterpolation}, {0, 1}});
+
+
+// Arguments: delay type, modulated delay time. Ping pong processes both channels in one pass and should cost no more than single tap
+static void BM_DelayType(benchmark::State &state)
+{
+	const bool				 modulated = state.range(1) != 0;
+
+	Delay<float>			 delay;
+	juce::dsp::ProcessSpec	 spec{delayBenchmarkSampleRate, static_cast<juce::uint32>(delayBenchmarkBlockSize), delayBenchmarkChannels};
+	delay.prepare(spec, 2000.0f);
+	delay.setDelayType(static_cast<DelayType>(state.range(0)));
+	delay.setMix(0.5f);
+	delay.setFeedback(0.4f);
+	delay.setChannelDelayTime(0, 250.3f);
+	delay.setChannelDelayTime(1, 375.7f);
+
+	juce::AudioBuffer<float> source(delayBenchmarkChannels, delayBenchmarkBlockSize);
+	juce::AudioBuffer<float> buffer(delayBenchmarkChannels, delayBenchmarkBlockSize);
+	BenchmarkHelpers::fillWithSine(source, delayBenchmarkSampleRate);
+
+	bool toggle = false;
+
+	for (auto _ : state)
+	{
+		if (modulated)
+		{
+			toggle = !toggle;
+			delay.setChannelDelayTime(0, toggle ? 251.1f : 250.3f);
+			delay.setChannelDelayTime(1, toggle ? 376.9f : 375.7f);
+		}
+
+		buffer.makeCopyOf(source, true);
+		delay.process(buffer);
+		benchmark::DoNotOptimize(buffer.getReadPointer(0));
+	}
+
+	state.SetItemsProcessed(state.iterations() * delayBenchmarkBlockSize);
+}
+
+BENCHMARK(BM_DelayType)->ArgNames({"type", "modulated"})->ArgsProduct({{SingleTap, PingPong}, {0, 1}});
+
+
+// Arguments: number of taps. The line is written once per block, so each further tap only adds its read
+static void BM_DelayMultiTap(benchmark::State &state)
+{
+	const int				 numTaps = static_cast<int>(state.range(0));
+
+	Delay<float>			 delay;
+	juce::dsp::ProcessSpec	 spec{delayBenchmarkSampleRate, static_cast<juce::uint32>(delayBenchmarkBlockSize), delayBenchmarkChannels};
+	delay.prepare(spec, 2000.0f);
+	delay.setDelayType(DelayType::MultiTap);
+	delay.setMix(0.5f);
+	delay.setFeedback(0.4f);
+	delay.setNumTaps(numTaps);
+
+	for (int tap = 0; tap < numTaps; ++tap)
+	{
+		delay.setTapTime(tap, 62.5f * static_cast<float>(tap + 1) + 0.3f);
+		delay.setTapPan(tap, tap % 2 == 0 ? -0.5f : 0.5f);
+	}
+
+	juce::AudioBuffer<float> source(delayBenchmarkChannels, delayBenchmarkBlockSize);
+	juce::AudioBuffer<float> buffer(delayBenchmarkChannels, delayBenchmarkBlockSize);
+	BenchmarkHelpers::fillWithSine(source, delayBenchmarkSampleRate);
+
+	for (auto _ : state)
+	{
+		buffer.makeCopyOf(source, true);
+		delay.process(buffer);
+		benchmark::DoNotOptimize(buffer.getReadPointer(0));
+	}
+
+	state.SetItemsProcessed(state.iterations() * delayBenchmarkBlockSize);
+}
+
+BENCHMARK(BM_DelayMultiTap)->ArgName("taps")->Arg(1)->Arg(2)->Arg(4)->Arg(8);
+
+
+// Arguments: block size, sample rate, channels, delay type. Ping pong needs a second channel and falls back to single tap on mono
+template <typename SampleType>
+static void BM_DelaySweep(benchmark::State &state)
+{
+	const int				 blockSize	 = static_cast<int>(state.range(0));
+	const double			 sampleRate	 = static_cast<double>(state.range(1));
+	const int				 numChannels = static_cast<int>(state.range(2));
+	const auto				 type		 = static_cast<DelayType>(state.range(3));
+
+	Delay<SampleType>		 delay;
+	juce::dsp::ProcessSpec	 spec{sampleRate, static_cast<juce::uint32>(blockSize), static_cast<juce::uint32>(numChannels)};
+	delay.prepare(spec, 2000.0f);
+	delay.setDelayType(type);
+	delay.setMix(0.5f);
+	delay.setFeedback(0.4f);
+
+	for (int channel = 0; channel < numChannels; ++channel)
+		delay.setChannelDelayTime(channel, 250.3f + 125.0f * static_cast<float>(channel));
+
+	if (type == DelayType::MultiTap)
+	{
+		delay.setNumTaps(delayMaxTaps);
+
+		for (int tap = 0; tap < delayMaxTaps; ++tap)
+			delay.setTapTime(tap, 62.5f * static_cast<float>(tap + 1) + 0.3f);
+	}
+
+	BenchmarkHelpers::runBlocks<SampleType>(state, numChannels, blockSize, sampleRate, [&delay](auto &buffer) { delay.process(buffer); });
+}
+
+BENCHMARK_TEMPLATE(BM_DelaySweep, float)
+	->ArgNames({"block", "rate", "channels", "type"})
+	->ArgsProduct({BenchmarkHelpers::sweepBlockSizes, BenchmarkHelpers::sweepSampleRates, BenchmarkHelpers::sweepChannels, {SingleTap, PingPong, MultiTap}});
+
+BENCHMARK_TEMPLATE(BM_DelaySweep, double)
+	->ArgNames({"block", "rate", "channels", "type"})
+	->ArgsProduct({BenchmarkHelpers::sweepBlockSizes, BenchmarkHelpers::sweepSampleRates, BenchmarkHelpers::sweepChannels, {SingleTap, PingPong, MultiTap}});
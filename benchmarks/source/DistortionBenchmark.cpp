@@ -0,0 +1,161 @@
+#include "BenchmarkHelpers.h"
+
+
+namespace
+{
+constexpr double benchmarkSampleRate = 48000.0;
+constexpr int	 benchmarkChannels	 = 2;
+} // namespace
+
+
+// Arguments: block size, oversampling factor, oversampling filter
+static void BM_DistortionOversampling(benchmark::State &state)
+{
+	const int				 blockSize = static_cast<int>(state.range(0));
+
+	Distortion<float>		 distortion;
+	juce::dsp::ProcessSpec	 spec{benchmarkSampleRate, static_cast<juce::uint32>(blockSize), benchmarkChannels};
+	distortion.prepare(spec);
+	distortion.setCurrentDistortionType(DistortionType::saturation);
+	distortion.setOversamplingFactor(static_cast<OversamplingFactor>(state.range(1)));
+	distortion.setOversamplingFilter(static_cast<OversamplingFilter>(state.range(2)));
+	distortion.setDrive(18.0f);
+	distortion.setMix(1.0f);
+
+	juce::AudioBuffer<float> source(benchmarkChannels, blockSize);
+	juce::AudioBuffer<float> buffer(benchmarkChannels, blockSize);
+	BenchmarkHelpers::fillWithSine(source, benchmarkSampleRate, 0.8f);
+
+	for (auto _ : state)
+	{
+		buffer.makeCopyOf(source, true);
+		distortion.process(buffer);
+		benchmark::DoNotOptimize(buffer.getReadPointer(0));
+	}
+
+	state.SetItemsProcessed(state.iterations() * blockSize);
+	state.counters["latency"] = distortion.getLatencyInSamples();
+}
+
+BENCHMARK(BM_DistortionOversampling)
+	->ArgNames({"block", "factor", "filter"})
+	->ArgsProduct({{512}, {NoOversampling, Oversampling2x, Oversampling4x, Oversampling8x}, {PolyphaseIIR, LinearPhaseFIR}});
+
+
+// Arguments: block size, distortion type, anti-aliasing mode
+static void BM_DistortionAntialiasing(benchmark::State &state)
+{
+	const int				 blockSize = static_cast<int>(state.range(0));
+
+	Distortion<float>		 distortion;
+	juce::dsp::ProcessSpec	 spec{benchmarkSampleRate, static_cast<juce::uint32>(blockSize), benchmarkChannels};
+	distortion.prepare(spec);
+	distortion.setCurrentDistortionType(static_cast<DistortionType>(state.range(1)));
+	distortion.setAntialiasingMode(static_cast<AntialiasingMode>(state.range(2)));
+	distortion.setDrive(18.0f);
+	distortion.setMix(1.0f);
+
+	juce::AudioBuffer<float> source(benchmarkChannels, blockSize);
+	juce::AudioBuffer<float> buffer(benchmarkChannels, blockSize);
+	BenchmarkHelpers::fillWithSine(source, benchmarkSampleRate, 0.8f);
+
+	for (auto _ : state)
+	{
+		buffer.makeCopyOf(source, true);
+		distortion.process(buffer);
+		benchmark::DoNotOptimize(buffer.getReadPointer(0));
+	}
+
+	state.SetItemsProcessed(state.iterations() * blockSize);
+}
+
+BENCHMARK(BM_DistortionAntialiasing)
+	->ArgNames({"block", "type", "adaa"})
+	->ArgsProduct({{512}, {hardClipping, softClipping, saturation}, {AntialiasingOff, FirstOrderADAA, SecondOrderADAA}});
+
+
+// Arguments: block size, DC filter. The filter alone, the Linkwitz-Riley against the one pole DC blocker
+template <typename SampleType>
+static void BM_DCFilter(benchmark::State &state)
+{
+	const int									blockSize = static_cast<int>(state.range(0));
+	const bool									isOnePole = state.range(1) != DCFilterLinkwitzRiley;
+
+	juce::dsp::LinkwitzRileyFilter<SampleType>	linkwitzRiley;
+	DCBlocker<SampleType>						dcBlocker;
+	juce::dsp::ProcessSpec						spec{benchmarkSampleRate, static_cast<juce::uint32>(blockSize), benchmarkChannels};
+	linkwitzRiley.prepare(spec);
+	linkwitzRiley.setCutoffFrequency(SampleType(10));
+	linkwitzRiley.setType(juce::dsp::LinkwitzRileyFilter<SampleType>::Type::highpass);
+	dcBlocker.prepare(benchmarkSampleRate, benchmarkChannels);
+
+	BenchmarkHelpers::runBlocks<SampleType>(state, benchmarkChannels, blockSize, benchmarkSampleRate,
+											[&](auto &buffer)
+											{
+												if (isOnePole)
+												{
+													dcBlocker.process(buffer, 0, blockSize);
+													return;
+												}
+
+												for (int channel = 0; channel < benchmarkChannels; ++channel)
+												{
+													auto *data = buffer.getWritePointer(channel);
+
+													for (int i = 0; i < blockSize; ++i)
+														data[i] = linkwitzRiley.processSample(channel, data[i]);
+												}
+											});
+}
+
+BENCHMARK_TEMPLATE(BM_DCFilter, float)->ArgNames({"block", "filter"})->ArgsProduct({{512}, {DCFilterLinkwitzRiley, DCFilterOnePole}});
+
+BENCHMARK_TEMPLATE(BM_DCFilter, double)->ArgNames({"block", "filter"})->ArgsProduct({{512}, {DCFilterLinkwitzRiley, DCFilterOnePole}});
+
+
+// Arguments: block size, DC filter mode, saturation at its default settings otherwise
+static void BM_DistortionDCFilter(benchmark::State &state)
+{
+	const int				 blockSize = static_cast<int>(state.range(0));
+
+	Distortion<float>		 distortion;
+	juce::dsp::ProcessSpec	 spec{benchmarkSampleRate, static_cast<juce::uint32>(blockSize), benchmarkChannels};
+	distortion.prepare(spec);
+	distortion.setCurrentDistortionType(DistortionType::saturation);
+	distortion.setDCFilterMode(static_cast<DCFilterMode>(state.range(1)));
+	distortion.setDrive(18.0f);
+	distortion.setMix(1.0f);
+
+	BenchmarkHelpers::runBlocks<float>(state, benchmarkChannels, blockSize, benchmarkSampleRate, [&distortion](auto &buffer) { distortion.process(buffer); });
+}
+
+BENCHMARK(BM_DistortionDCFilter)
+	->ArgNames({"block", "dcfilter"})
+	->ArgsProduct({{512}, {DCFilterLinkwitzRiley, DCFilterOnePole, DCFilterAfterSaturation}});
+
+
+// Arguments: block size, sample rate, channels, distortion type. Default oversampling and anti-aliasing
+template <typename SampleType>
+static void BM_DistortionSweep(benchmark::State &state)
+{
+	const int				 blockSize	 = static_cast<int>(state.range(0));
+	const double			 sampleRate	 = static_cast<double>(state.range(1));
+	const int				 numChannels = static_cast<int>(state.range(2));
+
+	Distortion<SampleType>	 distortion;
+	juce::dsp::ProcessSpec	 spec{sampleRate, static_cast<juce::uint32>(blockSize), static_cast<juce::uint32>(numChannels)};
+	distortion.prepare(spec);
+	distortion.setCurrentDistortionType(static_cast<DistortionType>(state.range(3)));
+	distortion.setDrive(18.0f);
+	distortion.setMix(1.0f);
+
+	BenchmarkHelpers::runBlocks<SampleType>(state, numChannels, blockSize, sampleRate, [&distortion](auto &buffer) { distortion.process(buffer); });
+}
+
+BENCHMARK_TEMPLATE(BM_DistortionSweep, float)
+	->ArgNames({"block", "rate", "channels", "type"})
+	->ArgsProduct({BenchmarkHelpers::sweepBlockSizes, BenchmarkHelpers::sweepSampleRates, BenchmarkHelpers::sweepChannels, {hardClipping, softClipping, saturation}});
+
+BENCHMARK_TEMPLATE(BM_DistortionSweep, double)
+	->ArgNames({"block", "rate", "channels", "type"})
+	->ArgsProduct({BenchmarkHelpers::sweepBlockSizes, BenchmarkHelpers::sweepSampleRates, BenchmarkHelpers::sweepChannels, {hardClipping, softClipping, saturation}});
@@ -0,0 +1,105 @@
+#include "BenchmarkHelpers.h"
+
+
+namespace
+{
+constexpr double chainBenchmarkSampleRate = 48000.0;
+constexpr int	 chainBenchmarkChannels	  = 2;
+
+
+// The effects of the processor in their default setting
+struct ChainEffects
+{
+	explicit ChainEffects(int blockSize)
+	{
+		juce::dsp::ProcessSpec spec{chainBenchmarkSampleRate, static_cast<juce::uint32>(blockSize), chainBenchmarkChannels};
+
+		distortion.prepare(spec);
+		distortion.setCurrentDistortionType(DistortionType::softClipping);
+		distortion.setDrive(12.0f);
+
+		delay.prepare(spec, 2000.0f);
+		delay.setMix(0.5f);
+		delay.setFeedback(0.4f);
+		delay.setChannelDelayTime(0, 250.0f);
+		delay.setChannelDelayTime(1, 375.0f);
+
+		panner.prepare(spec);
+	}
+
+	Distortion<float>	 distortion;
+	Delay<float>		 delay;
+	PannerManager<float> panner;
+};
+
+
+template <typename Chain>
+void runChain(benchmark::State &state, Chain &chain, int blockSize)
+{
+	BenchmarkHelpers::runBlocks<float>(state, chainBenchmarkChannels, blockSize, chainBenchmarkSampleRate, [&chain](auto &buffer) { chain.process(buffer); });
+}
+} // namespace
+
+
+// Arguments: block size. Order and bypass decoded from the plan word, effects called through EffectBase
+static void BM_EffectChainDynamic(benchmark::State &state)
+{
+	const int		   blockSize = static_cast<int>(state.range(0));
+
+	ChainEffects	   effects(blockSize);
+	EffectChain<float> chain;
+	chain.addEffect(effects.distortion);
+	chain.addEffect(effects.delay);
+	chain.addEffect(effects.panner);
+
+	runChain(state, chain, blockSize);
+}
+
+BENCHMARK(BM_EffectChainDynamic)->ArgName("block")->Arg(32)->Arg(128)->Arg(512);
+
+
+// Arguments: block size. Same effects in the default order, called through their concrete type
+static void BM_EffectChainStatic(benchmark::State &state)
+{
+	const int	 blockSize = static_cast<int>(state.range(0));
+
+	ChainEffects effects(blockSize);
+	StaticEffectChain<float, Distortion<float>, Delay<float>, PannerManager<float>> chain(effects.distortion, effects.delay, effects.panner);
+
+	runChain(state, chain, blockSize);
+}
+
+BENCHMARK(BM_EffectChainStatic)->ArgName("block")->Arg(32)->Arg(128)->Arg(512);
+
+
+// Arguments: block size, execution (0 = branches on the audio thread, 1 = always on the pool, 2 = cost model decides).
+// The delay runs with eight taps so the branches carry comparable work
+static void BM_EffectChainParallel(benchmark::State &state)
+{
+	const int		   blockSize = static_cast<int>(state.range(0));
+	const int		   execution = static_cast<int>(state.range(1));
+
+	ChainEffects	   effects(blockSize);
+	effects.delay.setDelayType(DelayType::MultiTap);
+	effects.delay.setNumTaps(delayMaxTaps);
+	effects.distortion.setOversamplingFactor(OversamplingFactor::Oversampling4x);
+
+	RealtimeThreadPool pool;
+	pool.start(NumEffectSlots - 1);
+
+	EffectChain<float> chain;
+	chain.addEffect(effects.distortion);
+	chain.addEffect(effects.delay);
+	chain.addEffect(effects.panner);
+	chain.prepare(chainBenchmarkChannels, blockSize);
+	chain.setRouting(ChainRouting::ParallelRouting);
+
+	if (execution > 0)
+		chain.setThreadPool(&pool);
+
+	chain.setCostModelEnabled(execution == 2);
+
+	runChain(state, chain, blockSize);
+}
+
+BENCHMARK(BM_EffectChainParallel)->ArgNames({"block", "execution"})->ArgsProduct({{32, 512, 4096}, {0, 1, 2}})->UseRealTime();
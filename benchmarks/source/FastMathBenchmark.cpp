@@ -0,0 +1,95 @@
+#include <benchmark/benchmark.h>
+
+#include "FastMath.h"
+#include "PluginProcessor.h"
+
+
+namespace
+{
+constexpr int mathBlockSize = 512;
+
+
+template <typename T>
+std::vector<T> makeInput(T start, T end)
+{
+	std::vector<T> input(mathBlockSize);
+
+	for (int i = 0; i < mathBlockSize; ++i)
+		input[static_cast<size_t>(i)] = start + (end - start) * static_cast<T>(i) / static_cast<T>(mathBlockSize);
+
+	return input;
+}
+} // namespace
+
+
+// Throughput of a single function over a block, libm against the FastMath approximation
+template <typename T, typename Function>
+static void BM_MathFunction(benchmark::State &state, Function function, T start, T end)
+{
+	const auto	   input = makeInput(start, end);
+	std::vector<T> output(mathBlockSize);
+
+	for (auto _ : state)
+	{
+		for (int i = 0; i < mathBlockSize; ++i)
+			output[static_cast<size_t>(i)] = function(input[static_cast<size_t>(i)]);
+
+		benchmark::DoNotOptimize(output.data());
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * mathBlockSize);
+}
+
+BENCHMARK_CAPTURE(BM_MathFunction, tanhExactFloat, [](float x) { return std::tanh(x); }, -4.0f, 4.0f);
+BENCHMARK_CAPTURE(BM_MathFunction, tanhFastFloat, [](float x) { return FastMath::tanh(x); }, -4.0f, 4.0f);
+BENCHMARK_CAPTURE(BM_MathFunction, sinhExactFloat, [](float x) { return std::sinh(x); }, -4.0f, 4.0f);
+BENCHMARK_CAPTURE(BM_MathFunction, sinhFastFloat, [](float x) { return FastMath::sinh(x); }, -4.0f, 4.0f);
+BENCHMARK_CAPTURE(BM_MathFunction, sinExactFloat, [](float x) { return std::sin(x); }, -10.0f, 10.0f);
+BENCHMARK_CAPTURE(BM_MathFunction, sinFastFloat, [](float x) { return FastMath::sin(x); }, -10.0f, 10.0f);
+BENCHMARK_CAPTURE(BM_MathFunction, cosExactFloat, [](float x) { return std::cos(x); }, -10.0f, 10.0f);
+BENCHMARK_CAPTURE(BM_MathFunction, cosFastFloat, [](float x) { return FastMath::cos(x); }, -10.0f, 10.0f);
+BENCHMARK_CAPTURE(BM_MathFunction, atanExactFloat, [](float x) { return std::atan(x); }, -4.0f, 4.0f);
+BENCHMARK_CAPTURE(BM_MathFunction, atanFastFloat, [](float x) { return FastMath::atan(x); }, -4.0f, 4.0f);
+BENCHMARK_CAPTURE(BM_MathFunction, dbToGainExactFloat, [](float x) { return juce::Decibels::decibelsToGain(x); }, -60.0f, 24.0f);
+BENCHMARK_CAPTURE(BM_MathFunction, dbToGainFastFloat, [](float x) { return FastMath::dbToGain(x); }, -60.0f, 24.0f);
+
+BENCHMARK_CAPTURE(BM_MathFunction, tanhExactDouble, [](double x) { return std::tanh(x); }, -4.0, 4.0);
+BENCHMARK_CAPTURE(BM_MathFunction, tanhFastDouble, [](double x) { return FastMath::tanh(x); }, -4.0, 4.0);
+BENCHMARK_CAPTURE(BM_MathFunction, sinExactDouble, [](double x) { return std::sin(x); }, -10.0, 10.0);
+BENCHMARK_CAPTURE(BM_MathFunction, sinFastDouble, [](double x) { return FastMath::sin(x); }, -10.0, 10.0);
+BENCHMARK_CAPTURE(BM_MathFunction, atanExactDouble, [](double x) { return std::atan(x); }, -4.0, 4.0);
+BENCHMARK_CAPTURE(BM_MathFunction, atanFastDouble, [](double x) { return FastMath::atan(x); }, -4.0, 4.0);
+
+
+// Arguments: distortion type, math precision
+static void BM_DistortionPrecision(benchmark::State &state)
+{
+	constexpr int			 numChannels = 2;
+
+	Distortion<float>		 distortion;
+	juce::dsp::ProcessSpec	 spec{48000.0, static_cast<juce::uint32>(mathBlockSize), numChannels};
+	distortion.prepare(spec);
+	distortion.setCurrentDistortionType(static_cast<DistortionType>(state.range(0)));
+	distortion.setMathPrecision(static_cast<MathPrecision>(state.range(1)));
+	distortion.setDrive(18.0f);
+	distortion.setMix(1.0f);
+
+	juce::AudioBuffer<float> source(numChannels, mathBlockSize);
+	juce::AudioBuffer<float> buffer(numChannels, mathBlockSize);
+
+	for (int channel = 0; channel < numChannels; ++channel)
+		for (int i = 0; i < mathBlockSize; ++i)
+			source.setSample(channel, i, 0.8f * std::sin(juce::MathConstants<float>::twoPi * 220.0f * static_cast<float>(i) / 48000.0f));
+
+	for (auto _ : state)
+	{
+		buffer.makeCopyOf(source, true);
+		distortion.process(buffer);
+		benchmark::DoNotOptimize(buffer.getReadPointer(0));
+	}
+
+	state.SetItemsProcessed(state.iterations() * mathBlockSize);
+}
+
+BENCHMARK(BM_DistortionPrecision)->ArgNames({"type", "precision"})->ArgsProduct({{softClipping, saturation}, {PrecisionExact, PrecisionFast}});
@@ -0,0 +1,185 @@
+#include "BenchmarkHelpers.h"
+
+#include "Panner/MonoPanner.h"
+#include "Panner/MultichannelPanner.h"
+#include "Panner/PannerManager.h"
+#include "Panner/StereoPanner.h"
+
+
+// Arguments: block size, sample rate, LFO enabled. The mono panner spreads one input channel onto a stereo pair
+template <typename SampleType>
+static void BM_MonoPannerSweep(benchmark::State &state)
+{
+	const int				 blockSize	= static_cast<int>(state.range(0));
+	const double			 sampleRate = static_cast<double>(state.range(1));
+
+	MonoPanner<SampleType>	 panner;
+	juce::dsp::ProcessSpec	 spec{sampleRate, static_cast<juce::uint32>(blockSize), 2};
+	panner.prepare(spec);
+	panner.setPan(0.3f);
+	panner.setLfoRate(2.0f);
+	panner.setLfoDepth(0.5f);
+	panner.enableLFO(state.range(2) != 0);
+
+	BenchmarkHelpers::runBlocks<SampleType>(state, 2, blockSize, sampleRate, [&panner](auto &buffer) { panner.process(buffer); });
+}
+
+BENCHMARK_TEMPLATE(BM_MonoPannerSweep, float)
+	->ArgNames({"block", "rate", "lfo"})
+	->ArgsProduct({BenchmarkHelpers::sweepBlockSizes, BenchmarkHelpers::sweepSampleRates, {0, 1}});
+
+BENCHMARK_TEMPLATE(BM_MonoPannerSweep, double)
+	->ArgNames({"block", "rate", "lfo"})
+	->ArgsProduct({BenchmarkHelpers::sweepBlockSizes, BenchmarkHelpers::sweepSampleRates, {0, 1}});
+
+
+// Arguments: block size, sample rate, LFO enabled
+template <typename SampleType>
+static void BM_StereoPannerSweep(benchmark::State &state)
+{
+	const int				 blockSize	= static_cast<int>(state.range(0));
+	const double			 sampleRate = static_cast<double>(state.range(1));
+
+	StereoPanner<SampleType> panner;
+	juce::dsp::ProcessSpec	 spec{sampleRate, static_cast<juce::uint32>(blockSize), 2};
+	panner.prepare(spec);
+	panner.setLeftChannelPan(-0.5f);
+	panner.setRightChannelPan(0.5f);
+	panner.setLeftChannelLfoRate(2.0f);
+	panner.setRightChannelLfoRate(3.0f);
+	panner.setLeftChannelLfoDepth(0.5f);
+	panner.setRightChannelLfoDepth(0.5f);
+	panner.enableLFO(state.range(2) != 0);
+
+	BenchmarkHelpers::runBlocks<SampleType>(state, 2, blockSize, sampleRate, [&panner](auto &buffer) { panner.process(buffer); });
+}
+
+BENCHMARK_TEMPLATE(BM_StereoPannerSweep, float)
+	->ArgNames({"block", "rate", "lfo"})
+	->ArgsProduct({BenchmarkHelpers::sweepBlockSizes, BenchmarkHelpers::sweepSampleRates, {0, 1}});
+
+BENCHMARK_TEMPLATE(BM_StereoPannerSweep, double)
+	->ArgNames({"block", "rate", "lfo"})
+	->ArgsProduct({BenchmarkHelpers::sweepBlockSizes, BenchmarkHelpers::sweepSampleRates, {0, 1}});
+
+
+// Arguments: block size, control interval of the LFO. 1 is the per sample reference
+template <typename SampleType>
+static void BM_StereoPannerControlInterval(benchmark::State &state)
+{
+	const int				 blockSize = static_cast<int>(state.range(0));
+	constexpr double		 sampleRate = 48000.0;
+
+	StereoPanner<SampleType> panner;
+	juce::dsp::ProcessSpec	 spec{sampleRate, static_cast<juce::uint32>(blockSize), 2};
+	panner.prepare(spec);
+	panner.setLeftChannelPan(-0.5f);
+	panner.setRightChannelPan(0.5f);
+	panner.setLeftChannelLfoRate(2.0f);
+	panner.setRightChannelLfoRate(3.0f);
+	panner.setLeftChannelLfoDepth(0.5f);
+	panner.setRightChannelLfoDepth(0.5f);
+	panner.setControlInterval(static_cast<int>(state.range(1)));
+	panner.enableLFO(true);
+
+	BenchmarkHelpers::runBlocks<SampleType>(state, 2, blockSize, sampleRate, [&panner](auto &buffer) { panner.process(buffer); });
+}
+
+BENCHMARK_TEMPLATE(BM_StereoPannerControlInterval, float)
+	->ArgNames({"block", "interval"})
+	->ArgsProduct({{64, 512}, {1, 16, 32}});
+
+
+// Arguments: block size, gains (0 static, 1 ramp, 2 per sample). The 2x2 matrix kernel on its own
+template <typename SampleType>
+static void BM_StereoMatrix(benchmark::State &state)
+{
+	const int								 blockSize = static_cast<int>(state.range(0));
+	const int								 mode	   = static_cast<int>(state.range(1));
+
+	const typename StereoMatrix<SampleType>::Gains start{SampleType(0.9), SampleType(0.2), SampleType(0.4), SampleType(0.8)};
+	const typename StereoMatrix<SampleType>::Gains end{SampleType(0.8), SampleType(0.3), SampleType(0.5), SampleType(0.7)};
+
+	juce::AudioBuffer<SampleType>			 gains(4, blockSize);
+	for (int row = 0; row < 4; ++row)
+		juce::FloatVectorOperations::fill(gains.getWritePointer(row), SampleType(0.5), blockSize);
+
+	const typename StereoMatrix<SampleType>::GainArrays gainArrays{gains.getReadPointer(0), gains.getReadPointer(1), gains.getReadPointer(2), gains.getReadPointer(3)};
+
+	BenchmarkHelpers::runBlocks<SampleType>(state, 2, blockSize, 48000.0,
+											[&](auto &buffer)
+											{
+												auto *left	= buffer.getWritePointer(0);
+												auto *right = buffer.getWritePointer(1);
+
+												if (mode == 0)
+													StereoMatrix<SampleType>::process(left, right, start, blockSize);
+												else if (mode == 1)
+													StereoMatrix<SampleType>::process(left, right, start, end, blockSize);
+												else
+													StereoMatrix<SampleType>::process(left, right, gainArrays, blockSize);
+											});
+}
+
+BENCHMARK_TEMPLATE(BM_StereoMatrix, float)
+	->ArgNames({"block", "gains"})
+	->ArgsProduct({{64, 512}, {0, 1, 2}});
+
+BENCHMARK_TEMPLATE(BM_StereoMatrix, double)
+	->ArgNames({"block", "gains"})
+	->ArgsProduct({{64, 512}, {0, 1, 2}});
+
+
+// Arguments: block size, layout (0 5.1, 1 7.1, 2 7.1.4), LFO enabled
+template <typename SampleType>
+static void BM_MultichannelPanner(benchmark::State &state)
+{
+	const int					  blockSize	 = static_cast<int>(state.range(0));
+	constexpr double			  sampleRate = 48000.0;
+
+	const juce::AudioChannelSet	  layouts[]	 = {juce::AudioChannelSet::create5point1(), juce::AudioChannelSet::create7point1(), juce::AudioChannelSet::create7point1point4()};
+	const auto					 &layout	 = layouts[state.range(1)];
+
+	MultichannelPanner<SampleType> panner;
+	juce::dsp::ProcessSpec		  spec{sampleRate, static_cast<juce::uint32>(blockSize), static_cast<juce::uint32>(layout.size())};
+	panner.setChannelLayout(layout);
+	panner.prepare(spec);
+	panner.setAzimuth(40.0f);
+	panner.setElevation(20.0f);
+	panner.setLfoRate(2.0f);
+	panner.setLfoDepth(0.5f);
+	panner.enableLFO(state.range(2) != 0);
+
+	BenchmarkHelpers::runBlocks<SampleType>(state, layout.size(), blockSize, sampleRate, [&panner](auto &buffer) { panner.process(buffer); });
+}
+
+BENCHMARK_TEMPLATE(BM_MultichannelPanner, float)
+	->ArgNames({"block", "layout", "lfo"})
+	->ArgsProduct({{64, 512}, {0, 1, 2}, {0, 1}});
+
+
+// Arguments: block size, path (0 the stereo panner on its own, 1 through the manager). The difference is the
+// dispatch and the silence check of the manager, which matter most at small blocks
+template <typename SampleType>
+static void BM_PannerManagerDispatch(benchmark::State &state)
+{
+	const int				   blockSize  = static_cast<int>(state.range(0));
+	constexpr double		   sampleRate = 48000.0;
+
+	StereoPanner<SampleType>   panner;
+	PannerManager<SampleType>  manager;
+	juce::dsp::ProcessSpec	   spec{sampleRate, static_cast<juce::uint32>(blockSize), 2};
+	panner.prepare(spec);
+	manager.prepare(spec);
+	panner.setLeftChannelPan(-0.5f);
+	manager.setParameter(ParamId::StereoLeftPanValue, -0.5f);
+
+	if (state.range(1) == 0)
+		BenchmarkHelpers::runBlocks<SampleType>(state, 2, blockSize, sampleRate, [&panner](auto &buffer) { panner.process(buffer); });
+	else
+		BenchmarkHelpers::runBlocks<SampleType>(state, 2, blockSize, sampleRate, [&manager](auto &buffer) { manager.process(buffer); });
+}
+
+BENCHMARK_TEMPLATE(BM_PannerManagerDispatch, float)
+	->ArgNames({"block", "manager"})
+	->ArgsProduct({{8, 32, 128}, {0, 1}});
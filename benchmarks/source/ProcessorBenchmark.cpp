@@ -0,0 +1,36 @@
+#include "BenchmarkHelpers.h"
+
+
+// Arguments: block size, sample rate, channels, routing. The whole processBlock with the default parameters,
+// including the parameter pull, the input and output gain and the effect chain. Stereo only, the mono panner
+// needs an output pair that a mono layout does not have. The double variant runs the double precision path
+// a host with a 64 bit mix bus selects.
+template <typename SampleType>
+static void BM_ProcessBlock(benchmark::State &state)
+{
+	const int		   blockSize   = static_cast<int>(state.range(0));
+	const double	   sampleRate  = static_cast<double>(state.range(1));
+	const int		   numChannels = static_cast<int>(state.range(2));
+
+	PluginProcessor	   processor;
+	juce::MidiBuffer   midi;
+
+	// Two choices, so the index is the normalised value
+	processor.getParameters()[toIndex(ParamId::ChainRouting)]->setValueNotifyingHost(static_cast<float>(state.range(3)));
+
+	processor.setProcessingPrecision(std::is_same_v<SampleType, double> ? juce::AudioProcessor::doublePrecision : juce::AudioProcessor::singlePrecision);
+	processor.setPlayConfigDetails(numChannels, numChannels, sampleRate, blockSize);
+	processor.prepareToPlay(sampleRate, blockSize);
+
+	BenchmarkHelpers::runBlocks<SampleType>(state, numChannels, blockSize, sampleRate, [&processor, &midi](auto &buffer) { processor.processBlock(buffer, midi); });
+}
+
+BENCHMARK_TEMPLATE(BM_ProcessBlock, float)
+	->ArgNames({"block", "rate", "channels", "routing"})
+	->ArgsProduct({BenchmarkHelpers::sweepBlockSizes, BenchmarkHelpers::sweepSampleRates, {2}, {SerialRouting, ParallelRouting}})
+	->UseRealTime();
+
+BENCHMARK_TEMPLATE(BM_ProcessBlock, double)
+	->ArgNames({"block", "rate", "channels", "routing"})
+	->ArgsProduct({BenchmarkHelpers::sweepBlockSizes, BenchmarkHelpers::sweepSampleRates, {2}, {SerialRouting, ParallelRouting}})
+	->UseRealTime();
@@ -23,47 +23,106 @@ CircularBuffer<SampleType>::~CircularBuffer()
 
 
 template <typename SampleType>
-void CircularBuffer<SampleType>::prepare(double sampleRate, int numSamples, int numChannels, int bufferLengthInSeconds)
+void CircularBuffer<SampleType>::prepare(int numChannels, int minimumCapacity)
 {
-	mNumChannels				 = numChannels;
-	mSizeOfBufferInSeconds		 = bufferLengthInSeconds;
+	jassert(numChannels > 0 && minimumCapacity > 0);
 
-	const int circularBufferSize = mSizeOfBufferInSeconds * (sampleRate + numSamples);
-	mCircularBuffer.setSize(numChannels, circularBufferSize);
+	mNumChannels			   = juce::jmax(1, numChannels);
+
+	// Largest power of two capacity that stays inside the memory budget
+	const size_t bytesPerFrame = sizeof(SampleType) * static_cast<size_t>(mNumChannels);
+	int			 maxCapacity   = 1;
+
+	while (static_cast<size_t>(maxCapacity) * 2 * bytesPerFrame <= maxMemoryInBytes)
+		maxCapacity *= 2;
+
+	const int capacity = juce::nextPowerOfTwo(juce::jmax(1, minimumCapacity));
+
+	jassert(capacity <= maxCapacity); // The requested delay does not fit into the memory budget and gets shortened!
+
+	mCapacity	   = juce::jmin(capacity, maxCapacity);
+	mMask		   = mCapacity - 1;
+	mWritePosition = 0;
+
+	mCircularBuffer.setSize(mNumChannels, mCapacity);
+	mCircularBuffer.clear();
+}
+
+
+template <typename SampleType>
+void CircularBuffer<SampleType>::reset()
+{
 	mCircularBuffer.clear();
+	mWritePosition = 0;
+}
+
+
+template <typename SampleType>
+typename CircularBuffer<SampleType>::Regions CircularBuffer<SampleType>::getRegions(int start, int numSamples) const
+{
+	jassert(numSamples <= mCapacity);
+
+	Regions regions;
+	regions.start1 = wrap(start);
+	regions.size1  = juce::jmin(numSamples, mCapacity - regions.start1);
+	regions.start2 = 0;
+	regions.size2  = numSamples - regions.size1;
+
+	return regions;
+}
+
+
+template <typename SampleType>
+typename CircularBuffer<SampleType>::Regions CircularBuffer<SampleType>::getWriteRegions(int numSamples) const
+{
+	return getRegions(mWritePosition, numSamples);
+}
+
+
+template <typename SampleType>
+typename CircularBuffer<SampleType>::Regions CircularBuffer<SampleType>::getReadRegions(int delayInSamples, int numSamples) const
+{
+	return getRegions(mWritePosition - delayInSamples, numSamples);
+}
+
+
+template <typename SampleType>
+void CircularBuffer<SampleType>::write(int channel, const SampleType *source, int numSamples)
+{
+	const auto regions = getWriteRegions(numSamples);
+	auto	  *data	   = mCircularBuffer.getWritePointer(channel);
+
+	juce::FloatVectorOperations::copy(data + regions.start1, source, regions.size1);
+
+	if (regions.size2 > 0)
+		juce::FloatVectorOperations::copy(data + regions.start2, source + regions.size1, regions.size2);
+}
+
+
+template <typename SampleType>
+void CircularBuffer<SampleType>::read(int channel, SampleType *destination, int delayInSamples, int numSamples) const
+{
+	const auto	regions = getReadRegions(delayInSamples, numSamples);
+	const auto *data	= mCircularBuffer.getReadPointer(channel);
+
+	juce::FloatVectorOperations::copy(destination, data + regions.start1, regions.size1);
+
+	if (regions.size2 > 0)
+		juce::FloatVectorOperations::copy(destination + regions.size1, data + regions.start2, regions.size2);
 }
 
 
 template <typename SampleType>
 void CircularBuffer<SampleType>::copyFromBufferToCircularBuffer(juce::AudioBuffer<SampleType> &buffer)
 {
-	for (int channel = 0; channel < mNumChannels; ++channel)
-	{
-		const int		  bufferLength		   = buffer.getNumSamples();
-		const int		  circularBufferLength = mCircularBuffer.getNumSamples();
-
-		const SampleType *bufferData		   = buffer.getReadPointer(channel);
-		const SampleType *circularBufferData   = mCircularBuffer.getReadPointer(channel);
-
-		// Copy Data
-		if (circularBufferLength > bufferLength + mWritePosition)
-		{
-			mCircularBuffer.copyFrom(channel, mWritePosition, bufferData, bufferLength);
-		}
-		else
-		{
-			const int bufferRemain = circularBufferLength - mWritePosition;
-
-			// Copy remaining samples to buffer
-			mCircularBuffer.copyFrom(channel, mWritePosition, bufferData, bufferRemain);
-
-			// Fill up the circular buffer
-			mCircularBuffer.copyFrom(channel, 0, bufferData, bufferLength - bufferRemain);
-		}
-
-		mWritePosition += bufferLength;
-		mWritePosition %= circularBufferLength;
-	}
+	const int numChannels = juce::jmin(mNumChannels, buffer.getNumChannels());
+	const int numSamples  = juce::jmin(mCapacity, buffer.getNumSamples());
+
+	for (int channel = 0; channel < numChannels; ++channel)
+		write(channel, buffer.getReadPointer(channel), numSamples);
+
+	// All channels share the write position, so it moves once per block
+	advance(numSamples);
 }
 
 
@@ -20,18 +20,60 @@ public:
 	CircularBuffer();
 	~CircularBuffer();
 
-	void						  prepare(double sampleRate, int numSamples, int numChannels, int bufferLengthInSeconds);
+	// Upper bound for the memory of one buffer (all channels), larger requests are clamped
+	static constexpr size_t maxMemoryInBytes = 32 * 1024 * 1024;
 
-	void						  copyFromBufferToCircularBuffer(juce::AudioBuffer<SampleType> &buffer);
+	// Allocates at least minimumCapacity samples per channel, rounded up to the next power of two
+	void					prepare(int numChannels, int minimumCapacity);
 
-	juce::AudioBuffer<SampleType>& getBuffer();
+	void					reset();
+
+	// Contiguous parts of a block inside the ring, the second one is empty if the block does not wrap
+	struct Regions
+	{
+		int start1{0};
+		int size1{0};
+		int start2{0};
+		int size2{0};
+	};
+
+	// Block of numSamples starting at the write position
+	Regions					getWriteRegions(int numSamples) const;
+
+	// Block of numSamples starting delayInSamples behind the write position
+	Regions					getReadRegions(int delayInSamples, int numSamples) const;
+
+	// Copies a block to / from the ring, the write position is not moved
+	void					write(int channel, const SampleType *source, int numSamples);
+	void					read(int channel, SampleType *destination, int delayInSamples, int numSamples) const;
+
+	// Writes all channels of the buffer and advances the write position
+	void					copyFromBufferToCircularBuffer(juce::AudioBuffer<SampleType> &buffer);
+
+	// Moves the write position once all channels of a block have been processed
+	void					advance(int numSamples) { mWritePosition = wrap(mWritePosition + numSamples); }
+
+	int						wrap(int index) const noexcept { return index & mMask; }
+
+	int						getWritePosition() const noexcept { return mWritePosition; }
+	int						getCapacity() const noexcept { return mCapacity; }
+	int						getNumChannels() const noexcept { return mNumChannels; }
+
+	SampleType			   *getWritePointer(int channel) { return mCircularBuffer.getWritePointer(channel); }
+	const SampleType	   *getReadPointer(int channel) const { return mCircularBuffer.getReadPointer(channel); }
+
+	juce::AudioBuffer<SampleType> &getBuffer();
 
 private:
-	juce::AudioBuffer<SampleType> mCircularBuffer;
+	Regions							getRegions(int start, int numSamples) const;
+
+	juce::AudioBuffer<SampleType>	mCircularBuffer;
+
+	int								mNumChannels{0}; // Set in prepare()
 
-	int							  mNumChannels{0};			  // Set in prepare()
+	int								mCapacity{0};	 // Power of two
 
-	int							  mWritePosition{0};
+	int								mMask{0};		 // mCapacity - 1
 
-	int							  mSizeOfBufferInSeconds = 2; // number of seconds the buffer will be in size of
+	int								mWritePosition{0};
 };
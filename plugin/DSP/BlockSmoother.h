@@ -0,0 +1,117 @@
+/*
+  ==============================================================================
+
+	Module			BlockSmoother
+	Description		Renders the ramp of a smoothed parameter once per block for all channels
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <vector>
+
+
+//==============================================================================
+// Advancing a juce::SmoothedValue inside a per channel loop moves it on once
+// per channel and sample, so every channel sees a different part of the ramp.
+// The block smoother advances the smoother once per block instead: while it is
+// smoothing, the values are rendered into a ramp buffer, otherwise only the
+// constant value is kept. The channels then apply the block with vector
+// operations, which take the scalar overloads for a constant value.
+//
+// process() may run a mapping on every value (e.g. decibels to gain), so the
+// mapping is not repeated for every channel either. The ramp buffer is
+// allocated in prepare(), blocks must not exceed the prepared size.
+//==============================================================================
+
+template <typename SampleType>
+class BlockSmoother
+{
+public:
+	void prepare(int maxBlockSize)
+	{
+		mRamp.assign(static_cast<size_t>(juce::jmax(1, maxBlockSize)), SampleType(0));
+		mIsSmoothing = false;
+	}
+
+	int getMaxBlockSize() const noexcept { return static_cast<int>(mRamp.size()); }
+
+	// Advances the smoother by the block and keeps the mapped values
+	template <typename Mapping>
+	void process(juce::SmoothedValue<float> &smoother, int numSamples, Mapping &&mapping) noexcept
+	{
+		jassert(numSamples <= getMaxBlockSize()); // Call ::prepare with the maximum block size!
+		numSamples = juce::jmin(numSamples, getMaxBlockSize());
+
+		mIsSmoothing = smoother.isSmoothing();
+
+		if (!mIsSmoothing)
+		{
+			mValue = static_cast<SampleType>(mapping(smoother.getTargetValue()));
+			return;
+		}
+
+		for (int i = 0; i < numSamples; ++i)
+			mRamp[static_cast<size_t>(i)] = static_cast<SampleType>(mapping(smoother.getNextValue()));
+
+		mValue = mRamp[static_cast<size_t>(juce::jmax(0, numSamples - 1))];
+	}
+
+	void process(juce::SmoothedValue<float> &smoother, int numSamples) noexcept
+	{
+		process(smoother, numSamples, [](float value) { return value; });
+	}
+
+	bool			  isSmoothing() const noexcept { return mIsSmoothing; }
+
+	// The constant value, or the last value of the ramp
+	SampleType		  getValue() const noexcept { return mValue; }
+
+	SampleType		  getValue(int sample) const noexcept { return mIsSmoothing ? mRamp[static_cast<size_t>(sample)] : mValue; }
+
+	// Only rendered while smoothing
+	const SampleType *getRamp() const noexcept { return mRamp.data(); }
+
+	// data *= value
+	void			  multiply(SampleType *data, int numSamples) const noexcept
+	{
+		if (mIsSmoothing)
+			juce::FloatVectorOperations::multiply(data, mRamp.data(), numSamples);
+		else
+			juce::FloatVectorOperations::multiply(data, mValue, numSamples);
+	}
+
+	// destination += source * value
+	void addWithMultiply(SampleType *destination, const SampleType *source, int numSamples) const noexcept
+	{
+		if (mIsSmoothing)
+			juce::FloatVectorOperations::addWithMultiply(destination, source, mRamp.data(), numSamples);
+		else
+			juce::FloatVectorOperations::addWithMultiply(destination, source, mValue, numSamples);
+	}
+
+	// dry = (1 - value) * dry + value * wet, the value being the wet share of a mix
+	void mix(SampleType *dry, const SampleType *wet, int numSamples) const noexcept
+	{
+		if (!mIsSmoothing)
+		{
+			juce::FloatVectorOperations::multiply(dry, SampleType(1) - mValue, numSamples);
+			juce::FloatVectorOperations::addWithMultiply(dry, wet, mValue, numSamples);
+			return;
+		}
+
+		const SampleType *ramp = mRamp.data();
+
+		for (int i = 0; i < numSamples; ++i)
+			dry[i] = (SampleType(1) - ramp[i]) * dry[i] + ramp[i] * wet[i];
+	}
+
+private:
+	std::vector<SampleType> mRamp;
+
+	SampleType				mValue{0};
+
+	bool					mIsSmoothing{false};
+};
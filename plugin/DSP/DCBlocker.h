@@ -0,0 +1,134 @@
+/*
+  ==============================================================================
+
+	Module			DCBlocker
+	Description		One pole, one zero highpass removing the DC offset of several channels
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+
+//==============================================================================
+// y[n] = x[n] - x[n-1] + R * y[n-1], with the pole R = exp(-2 pi fc / fs).
+// The zero at DC removes the offset, the pole sets the corner frequency. Per
+// sample it costs one multiply and two adds, a fraction of the two biquads of
+// a 4th order Linkwitz-Riley highpass.
+//
+// The recursion runs along time, so it is not vectorised over the samples of
+// a channel, its speed is bound by the latency of the multiply-add chain. The
+// buffer overload runs two channels in the same loop instead, their chains are
+// independent and overlap (the compiler may pack them into one register).
+// The state is allocated in prepare(), process() never allocates.
+//==============================================================================
+
+template <typename SampleType>
+class DCBlocker
+{
+public:
+	static constexpr double defaultCutoff = 10.0;
+
+	void prepare(double sampleRate, int numChannels, double cutoff = defaultCutoff)
+	{
+		jassert(sampleRate > 0.0);
+
+		mSampleRate = sampleRate;
+		mStates.assign(static_cast<size_t>(juce::jmax(0, numChannels)), State{});
+		setCutoffFrequency(cutoff);
+	}
+
+	void setCutoffFrequency(double cutoff) noexcept
+	{
+		jassert(cutoff > 0.0 && cutoff < 0.5 * mSampleRate);
+		mPole = static_cast<SampleType>(std::exp(-juce::MathConstants<double>::twoPi * cutoff / mSampleRate));
+	}
+
+	void reset() noexcept { std::fill(mStates.begin(), mStates.end(), State{}); }
+
+	void process(SampleType *data, int numSamples, int channel) noexcept
+	{
+		jassert(channel < static_cast<int>(mStates.size())); // Call ::prepare with enough channels!
+		if (channel >= static_cast<int>(mStates.size()))
+			return;
+
+		auto			&state = mStates[static_cast<size_t>(channel)];
+		const SampleType pole  = mPole;
+		SampleType		 x1	   = state.x1;
+		SampleType		 y1	   = state.y1;
+
+		for (int i = 0; i < numSamples; ++i)
+		{
+			const SampleType x = data[i];
+			y1				   = x - x1 + pole * y1;
+			x1				   = x;
+			data[i]			   = y1;
+		}
+
+		state.x1 = x1;
+		state.y1 = flushDenormal(y1);
+	}
+
+	void process(juce::AudioBuffer<SampleType> &buffer, int startSample, int numSamples) noexcept
+	{
+		const int numChannels = juce::jmin(buffer.getNumChannels(), static_cast<int>(mStates.size()));
+		int		  channel	  = 0;
+
+		for (; channel + 1 < numChannels; channel += 2)
+			processPair(buffer.getWritePointer(channel, startSample), buffer.getWritePointer(channel + 1, startSample), numSamples, channel);
+
+		if (channel < numChannels)
+			process(buffer.getWritePointer(channel, startSample), numSamples, channel);
+	}
+
+	// Time an impulse response takes to decay below the threshold
+	static double getTailLengthSeconds(double cutoff, double threshold) noexcept
+	{
+		return std::log(1.0 / threshold) / (juce::MathConstants<double>::twoPi * cutoff);
+	}
+
+private:
+	void processPair(SampleType *left, SampleType *right, int numSamples, int firstChannel) noexcept
+	{
+		auto			&leftState	= mStates[static_cast<size_t>(firstChannel)];
+		auto			&rightState = mStates[static_cast<size_t>(firstChannel + 1)];
+		const SampleType pole		= mPole;
+		SampleType		 leftX1 = leftState.x1, leftY1 = leftState.y1;
+		SampleType		 rightX1 = rightState.x1, rightY1 = rightState.y1;
+
+		for (int i = 0; i < numSamples; ++i)
+		{
+			const SampleType leftX	= left[i];
+			const SampleType rightX = right[i];
+			leftY1					= leftX - leftX1 + pole * leftY1;
+			rightY1					= rightX - rightX1 + pole * rightY1;
+			leftX1					= leftX;
+			rightX1					= rightX;
+			left[i]					= leftY1;
+			right[i]				= rightY1;
+		}
+
+		leftState  = {leftX1, flushDenormal(leftY1)};
+		rightState = {rightX1, flushDenormal(rightY1)};
+	}
+
+	// The output of a silent input decays into denormals
+	static SampleType flushDenormal(SampleType value) noexcept { return std::abs(value) < std::numeric_limits<SampleType>::min() ? SampleType(0) : value; }
+
+	struct State
+	{
+		SampleType x1{0};
+		SampleType y1{0};
+	};
+
+	std::vector<State> mStates;
+
+	double			   mSampleRate{44100.0};
+
+	SampleType		   mPole{0};
+};
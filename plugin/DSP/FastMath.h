@@ -0,0 +1,321 @@
+/*
+  ==============================================================================
+
+	Module			FastMath
+	Description		Polynomial approximations of the transcendental functions used in the audio hot paths
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+
+//==============================================================================
+// All approximations are branch free (selects only), constexpr and inline, so
+// loops calling them can be auto-vectorised (GCC needs -fno-trapping-math to
+// if-convert the selects, see plugin/CMakeLists.txt). The single precision
+// coefficients are minimax fits, the double precision ones are truncated
+// Taylor series over the reduced argument range. The errors below are upper
+// bounds of the maxima measured against libm over the given input range
+// (checked in FastMathTest.cpp):
+//
+//	Function		Range					float			double
+//	exp2(x)			[-120, 120]				1.0e-7 (rel)	3.0e-16 (rel)
+//	sin(x), cos(x)	|x| <= 1e4				2.0e-7 (abs)	5.0e-16 (abs)
+//	tanh(x)			any						1.5e-7 (abs)	4.0e-16 (abs)
+//	sinh(x)			[-1, 1]					3.5e-7 (abs)	8.0e-16 (abs)
+//					|x| <= 80				4.0e-6 (rel)	1.0e-14 (rel)
+//	atan(x)			any						2.0e-7 (abs)	5.0e-16 (abs)
+//	dbToGain(x)		[-100, 100] dB			8.0e-7 (rel)	3.0e-15 (rel)
+//
+// The relative errors of sinh and dbToGain at large arguments are dominated by
+// the rounding of the scaled argument, not by the polynomials. Outside of the
+// ranges the results stay finite and bounded but lose accuracy.
+//==============================================================================
+
+namespace FastMath
+{
+
+namespace Detail
+{
+
+// Horner scheme, coefficients in ascending order
+template <typename T, size_t N>
+constexpr T polynomial(T x, const std::array<T, N> &coefficients) noexcept
+{
+	T result = coefficients[N - 1];
+
+	for (size_t i = N - 1; i > 0; --i)
+		result = result * x + coefficients[i - 1];
+
+	return result;
+}
+
+
+// Plain selects instead of std::clamp, so the compiler can turn them into min/max
+template <typename T>
+constexpr T clamp(T x, T lower, T upper) noexcept
+{
+	x = x < lower ? lower : x;
+	return x > upper ? upper : x;
+}
+
+
+// Round to the nearest integer, the argument has to fit into an int
+template <typename T>
+constexpr int roundToInt(T x) noexcept
+{
+	return static_cast<int>(x + (x >= T(0) ? T(0.5) : T(-0.5)));
+}
+
+
+// 2^k for an integer k inside the normal exponent range
+template <typename T>
+constexpr T exponentToScale(int k) noexcept
+{
+	if constexpr (std::is_same_v<T, float>)
+		return std::bit_cast<float>(static_cast<uint32_t>(k + 127) << 23);
+	else
+		return std::bit_cast<double>(static_cast<uint64_t>(k + 1023) << 52);
+}
+
+
+template <typename T>
+struct Constants
+{
+	static constexpr T pi		 = T(3.14159265358979323846);
+	static constexpr T halfPi	 = T(1.57079632679489661923);
+	static constexpr T sixthPi	 = T(0.52359877559829887308);
+	static constexpr T invPi	 = T(0.31830988618379067154);
+	static constexpr T log2e	 = T(1.44269504088896340736);
+	static constexpr T sqrt3	 = T(1.73205080756887729353);
+	static constexpr T tan15Deg	 = T(0.26794919243112270647);
+	static constexpr T dBToLog2	 = T(0.16609640474436811739); // log2(10) / 20
+};
+
+
+template <typename T>
+struct Coefficients;
+
+
+template <>
+struct Coefficients<float>
+{
+	// Cody-Waite split of pi, k * piHigh is exact for |k| < 2^16
+	static constexpr float					piHigh	  = 3.140625f;
+	static constexpr float					piLow	  = 9.676535846665502e-4f;
+
+	// Exponent range that keeps 2^x a normal number
+	static constexpr float					exp2Min	  = -126.0f;
+	static constexpr float					exp2Max	  = 127.0f;
+
+	// tanh(x) rounds to +-1 beyond this
+	static constexpr float					tanhLimit = 9.0f;
+	static constexpr float					sinhLimit = 88.0f;
+
+	// 2^f, f in [-0.5, 0.5]
+	static constexpr std::array<float, 7>	exp2	  = {1.0000000005541665f, 0.6931472057372673f, 0.24022646890634405f, 0.055503287769656406f, 0.009618488957102513f, 0.0013399931219124377f, 0.00015345812004000534f};
+
+	// sin(r) / r as a polynomial in r^2, r in [-pi/2, pi/2]
+	static constexpr std::array<float, 5>	sin		  = {0.9999999957328028f, -0.16666657991914294f, 0.008333051063455686f, -0.000198090752919952f, 2.60522491735627e-06f};
+
+	// atan(r) / r as a polynomial in r^2, r in [-tan(15deg), tan(15deg)]
+	static constexpr std::array<float, 4>	atan	  = {0.999999980005052f, -0.3333242926843436f, 0.19935943331294487f, -0.1281534333654193f};
+};
+
+
+template <>
+struct Coefficients<double>
+{
+	// Cody-Waite split of pi, k * piHigh is exact for |k| < 2^27
+	static constexpr double					 piHigh	   = 3.1415926218032837;
+	static constexpr double					 piLow	   = 3.178650954705639e-08;
+
+	static constexpr double					 exp2Min   = -1022.0;
+	static constexpr double					 exp2Max   = 1023.0;
+
+	static constexpr double					 tanhLimit = 19.5;
+	static constexpr double					 sinhLimit = 709.0;
+
+	static constexpr std::array<double, 14> exp2	   = {1.0, 0.6931471805599453, 0.2402265069591007, 0.055504108664821576, 0.009618129107628477, 0.0013333558146428441, 0.00015403530393381606, 1.5252733804059838e-05, 1.3215486790144305e-06, 1.0178086009239696e-07, 7.054911620801121e-09, 4.44553827187081e-10, 2.5678435993488196e-11, 1.3691488853904124e-12};
+
+	static constexpr std::array<double, 11> sin		   = {1.0, -0.16666666666666666, 0.008333333333333333, -0.0001984126984126984, 2.7557319223985893e-06, -2.505210838544172e-08, 1.6059043836821613e-10, -7.647163731819816e-13, 2.8114572543455206e-15, -8.22063524662433e-18, 1.9572941063391263e-20};
+
+	static constexpr std::array<double, 13> atan	   = {1.0, -0.3333333333333333, 0.2, -0.14285714285714285, 0.1111111111111111, -0.09090909090909091, 0.07692307692307693, -0.06666666666666667, 0.058823529411764705, -0.05263157894736842, 0.047619047619047616, -0.043478260869565216, 0.04};
+};
+
+
+// sin(r) for r in [-pi/2, pi/2]
+template <typename T>
+constexpr T sinReduced(T r) noexcept
+{
+	return r * polynomial(r * r, Coefficients<T>::sin);
+}
+
+} // namespace Detail
+
+
+template <typename T>
+constexpr T exp2(T x) noexcept
+{
+	static_assert(std::is_floating_point_v<T>, "FastMath only supports floating point types");
+	using C			   = Detail::Coefficients<T>;
+
+	x				   = Detail::clamp(x, C::exp2Min, C::exp2Max);
+
+	const int k		   = Detail::roundToInt(x);
+	const T	  fraction = x - static_cast<T>(k);
+
+	return Detail::polynomial(fraction, C::exp2) * Detail::exponentToScale<T>(k);
+}
+
+
+template <typename T>
+constexpr T exp(T x) noexcept
+{
+	return exp2(x * Detail::Constants<T>::log2e);
+}
+
+
+template <typename T>
+constexpr T sin(T x) noexcept
+{
+	using C			   = Detail::Coefficients<T>;
+
+	// x = k * pi + r, sin(x) = (-1)^k * sin(r)
+	const int k		   = Detail::roundToInt(x * Detail::Constants<T>::invPi);
+	const T	  kf	   = static_cast<T>(k);
+	const T	  r		   = (x - kf * C::piHigh) - kf * C::piLow;
+	const T	  result   = Detail::sinReduced(r);
+
+	return (k & 1) ? -result : result;
+}
+
+
+template <typename T>
+constexpr T cos(T x) noexcept
+{
+	using C			   = Detail::Coefficients<T>;
+
+	// x = (k + 1/2) * pi + r, cos(x) = (-1)^(k + 1) * sin(r)
+	const int k		   = Detail::roundToInt(x * Detail::Constants<T>::invPi - T(0.5));
+	const T	  kf	   = static_cast<T>(k) + T(0.5);
+	const T	  r		   = (x - kf * C::piHigh) - kf * C::piLow;
+	const T	  result   = Detail::sinReduced(r);
+
+	return (k & 1) ? result : -result;
+}
+
+
+template <typename T>
+constexpr T tanh(T x) noexcept
+{
+	using C	   = Detail::Coefficients<T>;
+
+	x		   = Detail::clamp(x, -C::tanhLimit, C::tanhLimit);
+
+	const T e2 = exp2(T(2) * Detail::Constants<T>::log2e * x);
+
+	return (e2 - T(1)) / (e2 + T(1));
+}
+
+
+template <typename T>
+constexpr T sinh(T x) noexcept
+{
+	using C	  = Detail::Coefficients<T>;
+
+	x		  = Detail::clamp(x, -C::sinhLimit, C::sinhLimit);
+
+	const T e = exp(x);
+
+	return T(0.5) * (e - T(1) / e);
+}
+
+
+template <typename T>
+constexpr T atan(T x) noexcept
+{
+	using K			   = Detail::Constants<T>;
+
+	// atan(x) = pi/2 - atan(1/x) folds |x| into [0, 1]
+	T		   a	   = x < T(0) ? -x : x;
+	const bool invert  = a > T(1);
+	a				   = invert ? T(1) / a : a;
+
+	// atan(a) = pi/6 + atan((a * sqrt(3) - 1) / (a + sqrt(3))) folds [0, 1] into [-tan(15deg), tan(15deg)]
+	const bool shift   = a > K::tan15Deg;
+	a				   = shift ? (a * K::sqrt3 - T(1)) / (a + K::sqrt3) : a;
+
+	T result		   = a * Detail::polynomial(a * a, Detail::Coefficients<T>::atan);
+	result			   = shift ? result + K::sixthPi : result;
+	result			   = invert ? K::halfPi - result : result;
+
+	return x < T(0) ? -result : result;
+}
+
+
+// Same semantics as juce::Decibels::decibelsToGain with the default -100 dB floor
+template <typename T>
+constexpr T dbToGain(T decibels) noexcept
+{
+	return decibels > T(-100) ? exp2(decibels * Detail::Constants<T>::dBToLog2) : T(0);
+}
+
+
+//==============================================================================
+// Policies bundling the exact (libm) and the approximated functions behind the
+// same interface, so processing loops can be instantiated once per precision
+// and the precision switch is resolved once per block instead of per sample.
+//==============================================================================
+
+struct Exact
+{
+	template <typename T>
+	static T sin(T x) noexcept { return std::sin(x); }
+
+	template <typename T>
+	static T cos(T x) noexcept { return std::cos(x); }
+
+	template <typename T>
+	static T tanh(T x) noexcept { return std::tanh(x); }
+
+	template <typename T>
+	static T sinh(T x) noexcept { return std::sinh(x); }
+
+	template <typename T>
+	static T atan(T x) noexcept { return std::atan(x); }
+
+	template <typename T>
+	static T dbToGain(T decibels) noexcept { return decibels > T(-100) ? std::pow(T(10), decibels * T(0.05)) : T(0); }
+};
+
+
+struct Fast
+{
+	template <typename T>
+	static constexpr T sin(T x) noexcept { return FastMath::sin(x); }
+
+	template <typename T>
+	static constexpr T cos(T x) noexcept { return FastMath::cos(x); }
+
+	template <typename T>
+	static constexpr T tanh(T x) noexcept { return FastMath::tanh(x); }
+
+	template <typename T>
+	static constexpr T sinh(T x) noexcept { return FastMath::sinh(x); }
+
+	template <typename T>
+	static constexpr T atan(T x) noexcept { return FastMath::atan(x); }
+
+	template <typename T>
+	static constexpr T dbToGain(T decibels) noexcept { return FastMath::dbToGain(decibels); }
+};
+
+} // namespace FastMath
@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+	Module			FractionalDelay
+	Description		Interpolators for reading a circular buffer between two samples
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+
+
+//==============================================================================
+// A delay of delayInt + fraction samples is read from the taps delayInt,
+// delayInt + 1, ... behind the write position (tap 0 is the newest sample).
+// Each interpolator moves the fraction into the range where it is most
+// accurate (adjust) and states the smallest delay it can read without touching
+// the sample that is currently being written (minimumDelay).
+//
+//	Interpolator	Taps	Cost			Character
+//	Linear			2		1 mul			Lowpass at fractions near 0.5
+//	Lagrange3		4		4 mul			Flat up to a quarter of the sample rate
+//	Thiran			2		1 mul, IIR		Allpass (no lowpass), state per channel
+//
+// The FIR interpolators only depend on the fraction, so with a constant delay
+// their coefficients are computed once and a block is read as a weighted sum
+// of whole tap blocks. The Thiran allpass is recursive and keeps one sample of
+// state per channel, which has to be reset together with the buffer.
+//==============================================================================
+
+namespace FractionalDelay
+{
+
+// Largest number of taps of all interpolators, the buffer needs this headroom behind the longest delay
+constexpr int maxNumTaps = 4;
+
+
+struct Linear
+{
+	static constexpr int  numTaps	   = 2;
+	static constexpr int  minimumDelay = 1;
+	static constexpr bool isRecursive  = false;
+
+	template <typename T>
+	static constexpr void adjust(int &, T &) noexcept
+	{
+	}
+
+	template <typename T>
+	static constexpr std::array<T, numTaps> coefficients(T fraction) noexcept
+	{
+		return {T(1) - fraction, fraction};
+	}
+};
+
+
+// Third order Lagrange polynomial through four taps, evaluated between the two middle ones
+struct Lagrange3
+{
+	static constexpr int  numTaps	   = 4;
+	static constexpr int  minimumDelay = 2;
+	static constexpr bool isRecursive  = false;
+
+	template <typename T>
+	static constexpr void adjust(int &delayInt, T &fraction) noexcept
+	{
+		--delayInt;
+		fraction += T(1);
+	}
+
+	template <typename T>
+	static constexpr std::array<T, numTaps> coefficients(T fraction) noexcept
+	{
+		const T d0 = fraction;
+		const T d1 = fraction - T(1);
+		const T d2 = fraction - T(2);
+		const T d3 = fraction - T(3);
+
+		return {-d1 * d2 * d3 / T(6), d0 * d2 * d3 / T(2), -d0 * d1 * d3 / T(2), d0 * d1 * d2 / T(6)};
+	}
+};
+
+
+// First order Thiran allpass, the fraction is kept in [0.618, 1.618) to keep the pole away from -1
+struct Thiran
+{
+	static constexpr int  numTaps	   = 2;
+	static constexpr int  minimumDelay = 2;
+	static constexpr bool isRecursive  = true;
+
+	template <typename T>
+	static constexpr void adjust(int &delayInt, T &fraction) noexcept
+	{
+		if (fraction < T(0.618))
+		{
+			--delayInt;
+			fraction += T(1);
+		}
+	}
+
+	template <typename T>
+	static constexpr T coefficient(T fraction) noexcept
+	{
+		return (T(1) - fraction) / (T(1) + fraction);
+	}
+
+	// newer and older are the taps delayInt and delayInt + 1
+	template <typename T>
+	static constexpr T filter(T newer, T older, T coefficient, T &state) noexcept
+	{
+		state = older + coefficient * (newer - state);
+		return state;
+	}
+};
+
+
+// Splits a delay in samples into the first tap and the fraction used by the interpolator
+template <typename Interpolator, typename T>
+constexpr void split(T delayInSamples, int &delayInt, T &fraction) noexcept
+{
+	delayInt = static_cast<int>(delayInSamples);
+	fraction = delayInSamples - static_cast<T>(delayInt);
+	Interpolator::adjust(delayInt, fraction);
+}
+
+} // namespace FractionalDelay
@@ -0,0 +1,161 @@
+/*
+  ==============================================================================
+
+	Module			QuadratureOscillator
+	Description		Recursive sine and cosine oscillator for the modulation LFOs
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <cmath>
+
+
+//==============================================================================
+// Coupled form oscillator: the phasor (cos, sin) is rotated by the angle
+// 2 pi f / fs every sample, which costs four multiplies and two adds instead
+// of a sine evaluation. The frequency is given in Hz, the rotation is derived
+// from the sample rate set in prepare(), so the LFO runs at the same speed at
+// every rate.
+//
+// A single recursion is bound by the latency of its multiply-add chain. The
+// block render runs four phasors one sample apart instead, each rotated by
+// four samples per step. The four chains are independent and vectorise.
+//
+// Rounding lets the magnitude of the phasor drift slowly, so it is pulled
+// back onto the unit circle after every rendered block. The state is kept in
+// double precision, the drift per block stays far below the float epsilon.
+//==============================================================================
+
+template <typename SampleType>
+class QuadratureOscillator
+{
+public:
+	void prepare(double sampleRate) noexcept
+	{
+		jassert(sampleRate > 0.0);
+
+		mSampleRate = sampleRate;
+		setFrequency(mFrequency);
+		reset();
+	}
+
+	// Starts at phase 0, the sine rising from 0
+	void reset() noexcept
+	{
+		mCos = 1.0;
+		mSin = 0.0;
+	}
+
+	void setFrequency(double frequency) noexcept
+	{
+		mFrequency = frequency;
+
+		const double angle = juce::MathConstants<double>::twoPi * frequency / mSampleRate;
+		mRotationCos	   = std::cos(angle);
+		mRotationSin	   = std::sin(angle);
+		mLaneRotationCos   = std::cos(numLanes * angle);
+		mLaneRotationSin   = std::sin(numLanes * angle);
+		mStepSize		   = 0;
+	}
+
+	double	   getFrequency() const noexcept { return mFrequency; }
+
+	SampleType getSine() const noexcept { return static_cast<SampleType>(mSin); }
+
+	SampleType getCosine() const noexcept { return static_cast<SampleType>(mCos); }
+
+	// Writes the sine of the next samples
+	void	   process(SampleType *sine, int numSamples) noexcept
+	{
+		// Phasors of the four lanes, lane k starts k samples ahead
+		double c[numLanes], s[numLanes];
+		c[0] = mCos;
+		s[0] = mSin;
+
+		for (int lane = 1; lane < numLanes; ++lane)
+		{
+			c[lane] = c[lane - 1] * mRotationCos - s[lane - 1] * mRotationSin;
+			s[lane] = s[lane - 1] * mRotationCos + c[lane - 1] * mRotationSin;
+		}
+
+		const double rc		 = mLaneRotationCos;
+		const double rs		 = mLaneRotationSin;
+		const int	 numSteps = numSamples / numLanes;
+
+		for (int step = 0; step < numSteps; ++step)
+		{
+			for (int lane = 0; lane < numLanes; ++lane)
+			{
+				sine[step * numLanes + lane] = static_cast<SampleType>(s[lane]);
+
+				const double nextC			 = c[lane] * rc - s[lane] * rs;
+				s[lane]						 = s[lane] * rc + c[lane] * rs;
+				c[lane]						 = nextC;
+			}
+		}
+
+		// The first lane now holds the phase of the first sample not rendered by the steps
+		double		 lastC = c[0], lastS = s[0];
+
+		for (int i = numSteps * numLanes; i < numSamples; ++i)
+		{
+			sine[i]			   = static_cast<SampleType>(lastS);
+
+			const double nextC = lastC * mRotationCos - lastS * mRotationSin;
+			lastS			   = lastS * mRotationCos + lastC * mRotationSin;
+			lastC			   = nextC;
+		}
+
+		mCos = lastC;
+		mSin = lastS;
+		renormalise();
+	}
+
+	// Moves the phase on by a block without rendering it. The rotation of the last
+	// step size is kept, stepping through control points repeats it at no trig cost
+	void advance(int numSamples) noexcept
+	{
+		if (numSamples != mStepSize)
+		{
+			const double angle = juce::MathConstants<double>::twoPi * mFrequency * static_cast<double>(numSamples) / mSampleRate;
+			mStepRotationCos   = std::cos(angle);
+			mStepRotationSin   = std::sin(angle);
+			mStepSize		   = numSamples;
+		}
+
+		const double nextC = mCos * mStepRotationCos - mSin * mStepRotationSin;
+		mSin			   = mSin * mStepRotationCos + mCos * mStepRotationSin;
+		mCos			   = nextC;
+		renormalise();
+	}
+
+private:
+	static constexpr int numLanes = 4;
+
+	// First order correction towards a magnitude of 1, the error is tiny so one step suffices
+	void renormalise() noexcept
+	{
+		const double scale = 0.5 * (3.0 - (mCos * mCos + mSin * mSin));
+		mCos *= scale;
+		mSin *= scale;
+	}
+
+	double mSampleRate{44100.0};
+	double mFrequency{0.0};
+
+	double mCos{1.0};
+	double mSin{0.0};
+
+	double mRotationCos{1.0};
+	double mRotationSin{0.0};
+
+	double mLaneRotationCos{1.0}; // Rotation by numLanes samples
+	double mLaneRotationSin{0.0};
+
+	int	   mStepSize{0}; // Rotation of the last ::advance(), 0 when the frequency changed since
+	double mStepRotationCos{1.0};
+	double mStepRotationSin{0.0};
+};
@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+	Module			SilenceDetector
+	Description		Counts the silent input of an effect to skip blocks once its tail has decayed
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <cstdint>
+#include <limits>
+
+
+//==============================================================================
+// A block is silent if no sample exceeds the threshold of -120 dB. The detector
+// counts the silent samples since the last block with signal. Once the count
+// covers the tail of the effect (the time its state needs to decay below the
+// threshold) the state is drained, and every further silent block leaves the
+// effect silent as well, so it does not have to be processed.
+//
+// An effect without state has no tail and already skips its first silent
+// block. An infinite tail (e.g. a delay with full feedback) never skips.
+// Before the first block and after a reset the state is empty, so the detector
+// starts out idle.
+//==============================================================================
+
+template <typename SampleType>
+class SilenceDetector
+{
+public:
+	static constexpr SampleType threshold = static_cast<SampleType>(1.0e-6);
+
+	static bool					isSilent(const juce::AudioBuffer<SampleType> &buffer) noexcept
+	{
+		return buffer.getNumSamples() == 0 || buffer.getMagnitude(0, buffer.getNumSamples()) <= threshold;
+	}
+
+	// Called with every block the effect receives, true if the block can be skipped
+	bool process(const juce::AudioBuffer<SampleType> &buffer, double tailInSamples) noexcept
+	{
+		if (!isSilent(buffer))
+		{
+			mSilentSamples = 0;
+			return false;
+		}
+
+		const bool wasIdle = isIdle(tailInSamples);
+
+		if (mSilentSamples < idleSamples)
+			mSilentSamples += buffer.getNumSamples();
+
+		return wasIdle;
+	}
+
+	// True if the silent input since the last signal covers the tail
+	bool isIdle(double tailInSamples) const noexcept { return static_cast<double>(mSilentSamples) >= tailInSamples; }
+
+	void reset() noexcept { mSilentSamples = idleSamples; }
+
+private:
+	static constexpr int64_t idleSamples = std::numeric_limits<int64_t>::max() / 2;
+
+	int64_t					 mSilentSamples{idleSamples};
+};
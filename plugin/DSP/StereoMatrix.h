@@ -0,0 +1,119 @@
+/*
+  ==============================================================================
+
+	Module			StereoMatrix
+	Description		2x2 gain matrix applied in place to a pair of channels
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+
+//==============================================================================
+// Mixes a left and a right channel through the matrix
+//
+//	outLeft  = leftToLeft  * inLeft + rightToLeft  * inRight
+//	outRight = leftToRight * inLeft + rightToRight * inRight
+//
+// which covers panning, balance, width and the mid/side conversions. Both
+// outputs are computed in the same pass from the inputs held in registers, so
+// the channels are read and written once and no copy of the left input is
+// needed. The loops have no dependency between samples and are vectorised
+// by the compiler (the two channels must not overlap).
+//
+// The gains either hold for the block, ramp linearly from one matrix to the
+// next, or come as one value per sample from a modulation source.
+//==============================================================================
+
+template <typename SampleType>
+class StereoMatrix
+{
+public:
+	struct Gains
+	{
+		SampleType leftToLeft{1};
+		SampleType rightToLeft{0};
+		SampleType leftToRight{0};
+		SampleType rightToRight{1};
+	};
+
+	// Per sample gains, each array holds numSamples values
+	struct GainArrays
+	{
+		const SampleType *leftToLeft{nullptr};
+		const SampleType *rightToLeft{nullptr};
+		const SampleType *leftToRight{nullptr};
+		const SampleType *rightToRight{nullptr};
+	};
+
+	// Narrows (0) or widens (above 1) the stereo image, 1 leaves it unchanged
+	static Gains width(SampleType amount) noexcept
+	{
+		const SampleType same  = SampleType(0.5) * (SampleType(1) + amount);
+		const SampleType cross = SampleType(0.5) * (SampleType(1) - amount);
+		return {same, cross, cross, same};
+	}
+
+	// Left / right to mid / side, the inverse is the same matrix times 2
+	static Gains midSide() noexcept { return {SampleType(0.5), SampleType(0.5), SampleType(0.5), SampleType(-0.5)}; }
+
+	static void	 process(SampleType *left, SampleType *right, const Gains &gains, int numSamples) noexcept
+	{
+		jassert(left != right);
+
+		const SampleType ll = gains.leftToLeft, rl = gains.rightToLeft, lr = gains.leftToRight, rr = gains.rightToRight;
+
+		for (int i = 0; i < numSamples; ++i)
+		{
+			const SampleType inL = left[i];
+			const SampleType inR = right[i];
+
+			left[i]				 = ll * inL + rl * inR;
+			right[i]			 = lr * inL + rr * inR;
+		}
+	}
+
+	// Linear ramp from start at the first sample towards end, which is reached at the sample after the block
+	static void process(SampleType *left, SampleType *right, const Gains &start, const Gains &end, int numSamples) noexcept
+	{
+		jassert(left != right);
+
+		if (numSamples <= 0)
+			return;
+
+		const SampleType scale = SampleType(1) / static_cast<SampleType>(numSamples);
+		const SampleType ll = start.leftToLeft, rl = start.rightToLeft, lr = start.leftToRight, rr = start.rightToRight;
+		const SampleType dll = (end.leftToLeft - ll) * scale, drl = (end.rightToLeft - rl) * scale;
+		const SampleType dlr = (end.leftToRight - lr) * scale, drr = (end.rightToRight - rr) * scale;
+
+		// The gains are derived from the index instead of summed up, no error builds up over the block
+		for (int i = 0; i < numSamples; ++i)
+		{
+			const SampleType t	 = static_cast<SampleType>(i);
+			const SampleType inL = left[i];
+			const SampleType inR = right[i];
+
+			left[i]				 = (ll + dll * t) * inL + (rl + drl * t) * inR;
+			right[i]			 = (lr + dlr * t) * inL + (rr + drr * t) * inR;
+		}
+	}
+
+	static void process(SampleType *left, SampleType *right, const GainArrays &gains, int numSamples) noexcept
+	{
+		jassert(left != right);
+
+		const SampleType *ll = gains.leftToLeft, *rl = gains.rightToLeft, *lr = gains.leftToRight, *rr = gains.rightToRight;
+
+		for (int i = 0; i < numSamples; ++i)
+		{
+			const SampleType inL = left[i];
+			const SampleType inR = right[i];
+
+			left[i]				 = ll[i] * inL + rl[i] * inR;
+			right[i]			 = lr[i] * inL + rr[i] * inR;
+		}
+	}
+};
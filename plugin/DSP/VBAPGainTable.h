@@ -0,0 +1,295 @@
+/*
+  ==============================================================================
+
+	Module			VBAPGainTable
+	Description		Vector base amplitude panning gains of a loudspeaker layout as a lookup table
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+
+//==============================================================================
+// Vector base amplitude panning (Pulkki 1997) places a source between the two
+// (horizontal layouts) or three (layouts with height speakers) loudspeakers
+// surrounding its direction. With the speaker directions as the rows of L,
+// the gains g solve g L = p for the direction p of the source and are scaled
+// to a power of 1. All other speakers stay silent.
+//
+// The pairs and triplets are the edges and faces of the convex hull of the
+// speaker positions: no other speaker lies beyond the line or plane through
+// them, so they do not overlap and a source between two speakers never leaks
+// into a third one further away. Triplets lying in one plane with the
+// listener (three speakers of the same ring) cannot enclose a direction and
+// are skipped.
+//
+// Solving this per sample is far too expensive, so build() samples the gains
+// on a grid of 1 degree in azimuth and 5 degrees in elevation (0 to 90, the
+// layouts have no speakers below the listener). getGains() interpolates the
+// grid bilinearly, the power of the interpolated gains stays within 0.1 dB
+// of 1. Directions are given in degrees: azimuth 0 in front, positive to the
+// right, elevation positive upwards.
+//==============================================================================
+
+template <typename SampleType>
+class VBAPGainTable
+{
+public:
+	struct Speaker
+	{
+		double azimuth{0.0};
+		double elevation{0.0};
+	};
+
+	static constexpr int azimuthSteps		  = 360; // 1 degree
+	static constexpr int elevationStepDegrees = 5;
+	static constexpr int elevationSteps		  = 90 / elevationStepDegrees;
+
+	// Allocates and fills the table, not realtime safe. Layouts without height speakers are panned in the horizontal plane
+	void				 build(const std::vector<Speaker> &speakers)
+	{
+		mNumSpeakers		 = static_cast<int>(speakers.size());
+		mThreeDimensional	 = std::any_of(speakers.begin(), speakers.end(), [](const Speaker &speaker) { return speaker.elevation != 0.0; });
+		mNumElevationRows	 = mThreeDimensional ? elevationSteps + 1 : 1;
+
+		const auto bases	 = createBases(speakers, mThreeDimensional);
+		const auto rowLength = static_cast<size_t>((azimuthSteps + 1) * mNumSpeakers);
+
+		mGains.assign(rowLength * static_cast<size_t>(mNumElevationRows), SampleType(0));
+		std::vector<double> gains(speakers.size());
+
+		for (int row = 0; row < mNumElevationRows; ++row)
+		{
+			for (int column = 0; column <= azimuthSteps; ++column)
+			{
+				computeGains(speakers, bases, static_cast<double>(column), static_cast<double>(row * elevationStepDegrees), gains.data());
+
+				auto *entry = mGains.data() + static_cast<size_t>(row) * rowLength + static_cast<size_t>(column * mNumSpeakers);
+
+				for (int speaker = 0; speaker < mNumSpeakers; ++speaker)
+					entry[speaker] = static_cast<SampleType>(gains[static_cast<size_t>(speaker)]);
+			}
+		}
+	}
+
+	int	 getNumSpeakers() const noexcept { return mNumSpeakers; }
+
+	bool isThreeDimensional() const noexcept { return mThreeDimensional; }
+
+	// Writes getNumSpeakers() gains, the azimuth wraps around and the elevation is limited to 0 .. 90
+	void getGains(SampleType azimuth, SampleType elevation, SampleType *gains) const noexcept
+	{
+		jassert(!mGains.empty()); // Call ::build first!
+
+		const SampleType azimuthPosition = azimuth - SampleType(360) * std::floor(azimuth / SampleType(360));
+		const int		 column			 = juce::jmin(static_cast<int>(azimuthPosition), azimuthSteps - 1);
+		const SampleType azimuthFraction = azimuthPosition - static_cast<SampleType>(column);
+
+		const size_t	 rowLength		 = static_cast<size_t>((azimuthSteps + 1) * mNumSpeakers);
+		const auto		*lower			 = mGains.data() + static_cast<size_t>(column * mNumSpeakers);
+
+		if (!mThreeDimensional)
+		{
+			for (int speaker = 0; speaker < mNumSpeakers; ++speaker)
+				gains[speaker] = lower[speaker] + azimuthFraction * (lower[speaker + mNumSpeakers] - lower[speaker]);
+			return;
+		}
+
+		const SampleType elevationPosition = juce::jlimit(SampleType(0), SampleType(90), elevation) / SampleType(elevationStepDegrees);
+		const int		 row			   = juce::jmin(static_cast<int>(elevationPosition), elevationSteps - 1);
+		const SampleType elevationFraction = elevationPosition - static_cast<SampleType>(row);
+
+		lower += static_cast<size_t>(row) * rowLength;
+		const auto *upper = lower + rowLength;
+
+		for (int speaker = 0; speaker < mNumSpeakers; ++speaker)
+		{
+			const SampleType lowerGain = lower[speaker] + azimuthFraction * (lower[speaker + mNumSpeakers] - lower[speaker]);
+			const SampleType upperGain = upper[speaker] + azimuthFraction * (upper[speaker + mNumSpeakers] - upper[speaker]);
+			gains[speaker]			   = lowerGain + elevationFraction * (upperGain - lowerGain);
+		}
+	}
+
+	// Exact gains of a direction, the reference the table is built from
+	static void computeGains(const std::vector<Speaker> &speakers, double azimuth, double elevation, double *gains)
+	{
+		const bool threeDimensional = std::any_of(speakers.begin(), speakers.end(), [](const Speaker &speaker) { return speaker.elevation != 0.0; });
+		computeGains(speakers, createBases(speakers, threeDimensional), azimuth, elevation, gains);
+	}
+
+private:
+	using Vector = std::array<double, 3>;
+
+	// A speaker pair or triplet with the inverse of its direction matrix
+	struct Base
+	{
+		std::array<int, 3>	  speakers{-1, -1, -1};
+		std::array<Vector, 3> inverse{};
+	};
+
+	static Vector toVector(double azimuth, double elevation) noexcept
+	{
+		const double a = juce::degreesToRadians(azimuth);
+		const double e = juce::degreesToRadians(elevation);
+		return {std::cos(e) * std::sin(a), std::cos(e) * std::cos(a), std::sin(e)};
+	}
+
+	static double dot(const Vector &a, const Vector &b) noexcept { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; }
+
+	// True if no other speaker lies beyond the line (normal in the horizontal plane) or plane through the base
+	static bool	  isHullBoundary(const std::vector<Vector> &points, const std::array<int, 3> &base, const Vector &normal) noexcept
+	{
+		// Oriented away from the listener
+		const double sign	  = dot(normal, points[static_cast<size_t>(base[0])]) < 0.0 ? -1.0 : 1.0;
+		const double distance = sign * dot(normal, points[static_cast<size_t>(base[0])]);
+
+		for (size_t speaker = 0; speaker < points.size(); ++speaker)
+			if (sign * dot(normal, points[speaker]) > distance + 1.0e-12)
+				return false;
+
+		return true;
+	}
+
+	static Vector cross(const Vector &a, const Vector &b) noexcept { return {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]}; }
+
+	// Every pair (horizontal) or triplet (with height) of speakers on the boundary of the layout, inverted once
+	static std::vector<Base> createBases(const std::vector<Speaker> &speakers, bool threeDimensional)
+	{
+		constexpr double	minDeterminant = 1.0e-3;
+
+		const int			numSpeakers	   = static_cast<int>(speakers.size());
+		std::vector<Vector> directions, points;
+		std::vector<Base>	bases;
+
+		// Symmetric layouts have four speakers in one plane (the rear pairs of 7.1.4), both diagonals of such a quad
+		// would pass the test. Moving each speaker out by a tiny, different distance splits the quad the same way for
+		// every direction, the gains are computed from the exact directions.
+		for (const auto &speaker : speakers)
+		{
+			const double scale = 1.0 + 1.0e-6 * static_cast<double>(directions.size() + 1);
+			directions.push_back(toVector(speaker.azimuth, speaker.elevation));
+			points.push_back({directions.back()[0] * scale, directions.back()[1] * scale, directions.back()[2] * scale});
+		}
+
+		for (int i = 0; i < numSpeakers; ++i)
+		{
+			for (int j = i + 1; j < numSpeakers; ++j)
+			{
+				const Vector &a = directions[static_cast<size_t>(i)];
+				const Vector &b = directions[static_cast<size_t>(j)];
+
+				if (!threeDimensional)
+				{
+					const double determinant = a[0] * b[1] - a[1] * b[0];
+					const Vector &pa		  = points[static_cast<size_t>(i)];
+					const Vector &pb		  = points[static_cast<size_t>(j)];
+
+					if (std::abs(determinant) < minDeterminant || !isHullBoundary(points, {i, j, -1}, {pb[1] - pa[1], pa[0] - pb[0], 0.0}))
+						continue;
+
+					Base base;
+					base.speakers	= {i, j, -1};
+					base.inverse[0] = {b[1] / determinant, -b[0] / determinant, 0.0};
+					base.inverse[1] = {-a[1] / determinant, a[0] / determinant, 0.0};
+					bases.push_back(base);
+					continue;
+				}
+
+				for (int k = j + 1; k < numSpeakers; ++k)
+				{
+					const Vector &c = directions[static_cast<size_t>(k)];
+
+					// Rows of the inverse are the cross products of the other two directions over the determinant
+					const Vector  bc		  = cross(b, c);
+					const Vector  ca		  = cross(c, a);
+					const Vector  ab		  = cross(a, b);
+					const double  determinant = dot(a, bc);
+
+					const Vector &pa		  = points[static_cast<size_t>(i)];
+					const Vector &pb		  = points[static_cast<size_t>(j)];
+					const Vector &pc		  = points[static_cast<size_t>(k)];
+					const Vector  normal	  = cross({pb[0] - pa[0], pb[1] - pa[1], pb[2] - pa[2]}, {pc[0] - pa[0], pc[1] - pa[1], pc[2] - pa[2]});
+
+					if (std::abs(determinant) < minDeterminant || !isHullBoundary(points, {i, j, k}, normal))
+						continue;
+
+					Base base;
+					base.speakers = {i, j, k};
+
+					for (size_t axis = 0; axis < 3; ++axis)
+					{
+						base.inverse[0][axis] = bc[axis] / determinant;
+						base.inverse[1][axis] = ca[axis] / determinant;
+						base.inverse[2][axis] = ab[axis] / determinant;
+					}
+
+					bases.push_back(base);
+				}
+			}
+		}
+
+		return bases;
+	}
+
+	static void computeGains(const std::vector<Speaker> &speakers, const std::vector<Base> &bases, double azimuth, double elevation, double *gains)
+	{
+		constexpr double tolerance	 = 1.0e-9; // A source on the edge of a base gives one gain of 0
+
+		const Vector	 direction	 = toVector(azimuth, elevation);
+		const Base		*best		 = nullptr;
+		Vector			 bestGains{};
+
+		for (const auto &base : bases)
+		{
+			Vector baseGains{};
+			bool   enclosed = true;
+
+			for (size_t n = 0; n < 3 && base.speakers[n] >= 0; ++n)
+			{
+				baseGains[n] = base.inverse[n][0] * direction[0] + base.inverse[n][1] * direction[1] + base.inverse[n][2] * direction[2];
+				enclosed &= baseGains[n] >= -tolerance;
+			}
+
+			// The bases do not overlap, a source on a shared edge takes the first one
+			if (enclosed)
+			{
+				best	  = &base;
+				bestGains = baseGains;
+				break;
+			}
+		}
+
+		std::fill(gains, gains + speakers.size(), 0.0);
+
+		// Only a layout of a single speaker (or speakers in one direction) has no base, it plays everything
+		if (best == nullptr)
+		{
+			if (!speakers.empty())
+				gains[0] = 1.0;
+			return;
+		}
+
+		double power = 0.0;
+		for (size_t n = 0; n < 3 && best->speakers[n] >= 0; ++n)
+			power += bestGains[n] * bestGains[n];
+
+		const double scale = 1.0 / std::sqrt(power);
+		for (size_t n = 0; n < 3 && best->speakers[n] >= 0; ++n)
+			gains[best->speakers[n]] = juce::jmax(0.0, bestGains[n]) * scale;
+	}
+
+	std::vector<SampleType> mGains; // [elevation row][azimuth column 0 .. 360][speaker]
+
+	int						mNumSpeakers{0};
+
+	int						mNumElevationRows{1};
+
+	bool					mThreeDimensional{false};
+};
@@ -13,6 +13,12 @@
 template <typename SampleType>
 Delay<SampleType>::Delay()
 {
+	for (int tap = 0; tap < delayMaxTaps; ++tap)
+	{
+		mTaps[tap].time.setCurrentAndTargetValue(delayTapTimeStepDefault * static_cast<float>(tap + 1));
+		mTaps[tap].gain.setCurrentAndTargetValue(delayTapGainDefault);
+		mTaps[tap].pan.setCurrentAndTargetValue(delayTapPanDefault);
+	}
 }
 
 
@@ -43,132 +49,565 @@ void Delay<SampleType>::prepare(const juce::dsp::ProcessSpec &spec, float maxDel
 	this->setSampleRate(spec.sampleRate);
 	this->setNumChannels(spec.numChannels);
 	this->setMaxBlockSize(spec.maximumBlockSize);
+	mSamplesPerMS = spec.sampleRate / 1000.0;
 
 	// prepare the buffer
 	prepareDelayBuffer();
 
-	mCircularBufferLength = mDelayBuffer.getBuffer().getNumSamples();
+	mBlockBuffer.setSize(4, static_cast<int>(spec.maximumBlockSize));
+	mFeedbackRamp.prepare(static_cast<int>(spec.maximumBlockSize));
+	mMixRamp.prepare(static_cast<int>(spec.maximumBlockSize));
+	mInterpolatorStates.assign(spec.numChannels, SampleType(0));
 
-	mWritePositions.resize(spec.numChannels);
+	// Shared by all channels through the block ramps, so they can be smoothed like the delay times
+	mFeedback.reset(spec.sampleRate, 0.02);
+	mMix.reset(spec.sampleRate, 0.02);
 
+	mChannelDelayTimes.resize(spec.numChannels);
 	for (int channel = 0; channel < spec.numChannels; ++channel)
 	{
-		mWritePositions[channel] = 0;
+		mChannelDelayTimes[channel].reset(spec.sampleRate, 0.02);
 	}
 
-	mChannelDelayTimes.resize(spec.numChannels);
-	for (int channel = 0; channel < spec.numChannels; ++channel)
+	assignChannelRoles(static_cast<int>(spec.numChannels));
+
+	for (auto &tap : mTaps)
 	{
-		mChannelDelayTimes[channel].reset(spec.sampleRate, 0.02);
+		tap.time.reset(spec.sampleRate, 0.02);
+		tap.gain.reset(spec.sampleRate, 0.02);
+		tap.pan.reset(spec.sampleRate, 0.02);
 	}
+
+	updateTailLength();
 }
 
 
 template <typename SampleType>
 void Delay<SampleType>::process(juce::AudioBuffer<SampleType> &buffer)
 {
-	const int					   numSamples		   = buffer.getNumSamples();
-	const int					   numChannels		   = buffer.getNumChannels();
+	RealtimeSafety::ScopedRealtimeSection realtimeSection;
 
-	// For each channel we will
-	// 1. Write the incoming samples into the delay buffer
-	// 2. Read out delayed samples from the delay buffer
-	// 3. Apply feedback
-	// 4. Mix into output
+	jassert(mDelayBuffer.getCapacity() > 0); // Call ::prepare before attempting to call ::process()!
+	if (mDelayBuffer.getCapacity() == 0)
+		return;
 
-	// Get reference to buffer
-	juce::AudioBuffer<SampleType> &delayBufferRef	   = mDelayBuffer.getBuffer();
-	auto						   delayBufferWritePtr = delayBufferRef.getArrayOfWritePointers();
+	// The write position stands still while skipping, the buffer only holds a decayed tail
+	if (this->skipSilentBlock(buffer))
+	{
+		skipParameterRamps(buffer.getNumSamples());
+		return;
+	}
+
+	const int numSamples   = buffer.getNumSamples();
+	const int maxBlockSize = mFeedbackRamp.getMaxBlockSize();
+
+	// Hosts may exceed the announced block size, so process in chunks fitting the parameter ramps
+	for (int startSample = 0; startSample < numSamples; startSample += maxBlockSize)
+	{
+		const int chunkSize = juce::jmin(maxBlockSize, numSamples - startSample);
+
+		// The interpolation is resolved once per block
+		switch (mInterpolation)
+		{
+		case DelayInterpolation::LagrangeInterpolation: processDelay<FractionalDelay::Lagrange3>(buffer, startSample, chunkSize); break;
+		case DelayInterpolation::ThiranInterpolation: processDelay<FractionalDelay::Thiran>(buffer, startSample, chunkSize); break;
+		default: processDelay<FractionalDelay::Linear>(buffer, startSample, chunkSize); break;
+		}
+
+		// All channels share the write position of the delay buffer
+		mDelayBuffer.advance(chunkSize);
+	}
+}
+
+
+template <typename SampleType>
+template <typename Interpolator>
+void Delay<SampleType>::processDelay(juce::AudioBuffer<SampleType> &buffer, int startSample, int numSamples)
+{
+	const int numChannels = juce::jmin(buffer.getNumChannels(), mDelayBuffer.getNumChannels());
+
+	// Feedback and mix move on once per block, all channels follow the same ramp
+	mFeedbackRamp.process(mFeedback, numSamples);
+	mMixRamp.process(mMix, numSamples);
+
+	if (mDelayType == DelayType::MultiTap && numChannels >= 1)
+	{
+		processMultiTap<Interpolator>(buffer.getWritePointer(0, startSample), numChannels >= 2 ? buffer.getWritePointer(1, startSample) : nullptr, numSamples);
+		return;
+	}
+
+	// Ping pong bounces within each pair of speakers (left / right, left / right surround, ...), the centres and
+	// every other mode are delayed channel by channel. The LFE passes dry.
+	const bool isPingPong = mDelayType == DelayType::PingPong;
 
 	for (int channel = 0; channel < numChannels; ++channel)
 	{
-		SampleType *channelData		= buffer.getWritePointer(channel);
-		SampleType *delayBufferData = delayBufferWritePtr[channel];
+		const ChannelRole role	  = mChannelRoles[channel];
+		const int		  partner = mPartnerChannels[channel];
 
-		int		   &writePosition	= mWritePositions[channel];
+		if (role == ChannelRole::Dry)
+			continue;
 
-		for (int i = 0; i < numSamples; ++i)
+		if (isPingPong && role == ChannelRole::Left && partner >= 0 && partner < numChannels)
 		{
-			float			 feedbackValue			 = mFeedback.getNextValue();
-			float			 mixValue				 = mMix.getNextValue();
+			processPingPong<Interpolator>(buffer.getWritePointer(channel, startSample), buffer.getWritePointer(partner, startSample), channel, partner, numSamples);
+			continue;
+		}
 
-			// Get the channel specific delay time
-			float			 thisChannelDelayTimeMS	 = mChannelDelayTimes[channel].getNextValue();
-			int				 thisChannelDelaySamples = (int)(thisChannelDelayTimeMS * (this->getSampleRate() / 1000.0f));
+		// Right channels with a partner were processed with it
+		if (isPingPong && role == ChannelRole::Right && partner >= 0 && partner < numChannels)
+			continue;
 
-			// Current Sample from input
-			const SampleType inputSample			 = channelData[i];
+		processChannel<Interpolator>(buffer.getWritePointer(channel, startSample), channel, numSamples);
+	}
+}
 
-			// Write current input sample to the delay buffer (considering feedback)
-			SampleType		 delayedSample			 = delayBufferData[writePosition];
-			SampleType		 newDelayValues			 = inputSample + (delayedSample * feedbackValue);
-			delayBufferData[writePosition]			 = newDelayValues;
 
-			// Compute read position
-			int readPosition						 = (writePosition - thisChannelDelaySamples) % mCircularBufferLength;
-			while (readPosition < 0)
-			{
-				readPosition += mCircularBufferLength; // Wrap around
-			}
+template <typename SampleType>
+template <typename Interpolator>
+void Delay<SampleType>::processChannel(SampleType *channelData, int channel, int numSamples)
+{
+	int		   delayInt = 0;
+	SampleType fraction = SampleType(0);
+
+	if (getConstantDelay<Interpolator>(channel, numSamples, delayInt, fraction))
+	{
+		SampleType *delayed = mBlockBuffer.getWritePointer(0);
+		SampleType *scratch = mBlockBuffer.getWritePointer(2);
+
+		readDelayedBlock<Interpolator>(channel, mInterpolatorStates[channel], delayed, scratch, numSamples, delayInt, fraction);
+
+		// Input plus feedback into the delay buffer
+		juce::FloatVectorOperations::copy(scratch, channelData, numSamples);
+		mFeedbackRamp.addWithMultiply(scratch, delayed, numSamples);
+		mDelayBuffer.write(channel, scratch, numSamples);
+
+		// Mix delayed output
+		mMixRamp.mix(channelData, delayed, numSamples);
+		return;
+	}
 
-			// Get delayed output
-			SampleType out = delayBufferData[readPosition];
+	// For each sample we will
+	// 1. Read out the interpolated delayed sample behind the write position
+	// 2. Write the incoming sample plus the fed back delayed sample into the delay buffer
+	// 3. Mix into output
+	auto	   &delayTime		= mChannelDelayTimes[channel];
+	SampleType *delayBufferData = mDelayBuffer.getWritePointer(channel);
+	const int	writePosition	= mDelayBuffer.getWritePosition();
+
+	for (int i = 0; i < numSamples; ++i)
+	{
+		const SampleType feedbackValue = mFeedbackRamp.getValue(i);
+		const SampleType mixValue	   = mMixRamp.getValue(i);
+
+		getDelayInSamples<Interpolator>(delayTime.getNextValue(), delayInt, fraction);
+
+		// Current Sample from input
+		const SampleType inputSample   = channelData[i];
+
+		// Positions wrap with the power of two mask of the delay buffer
+		const int		 position	   = mDelayBuffer.wrap(writePosition + i);
+		const SampleType delayedSample = readDelayedSample<Interpolator>(channel, mInterpolatorStates[channel], position, delayInt, fraction);
+
+		// Write current input sample to the delay buffer (considering feedback)
+		delayBufferData[position]	   = inputSample + (delayedSample * feedbackValue);
+
+		// Mix delayed output
+		channelData[i]				   = (SampleType(1) - mixValue) * inputSample + (mixValue * delayedSample);
+	}
+}
+
+
+template <typename SampleType>
+template <typename Interpolator>
+void Delay<SampleType>::processPingPong(SampleType *leftData, SampleType *rightData, int leftChannel, int rightChannel, int numSamples)
+{
+	// The left line is fed with the mono sum of the input and the feedback of the right line,
+	// the right line only with the feedback of the left line, so every repeat alternates sides:
+	// left after the left delay time, right after both delay times, left again, ...
+	int		   leftDelayInt = 0, rightDelayInt = 0;
+	SampleType leftFraction = SampleType(0), rightFraction = SampleType(0);
+
+	if (getConstantDelay<Interpolator>(leftChannel, numSamples, leftDelayInt, leftFraction) && getConstantDelay<Interpolator>(rightChannel, numSamples, rightDelayInt, rightFraction))
+	{
+		SampleType *leftDelayed	 = mBlockBuffer.getWritePointer(0);
+		SampleType *rightDelayed = mBlockBuffer.getWritePointer(1);
+		SampleType *scratch		 = mBlockBuffer.getWritePointer(2);
+
+		// Both lines are read completely before either is written, so the cross feedback sees the previous blocks only
+		readDelayedBlock<Interpolator>(leftChannel, mInterpolatorStates[leftChannel], leftDelayed, scratch, numSamples, leftDelayInt, leftFraction);
+		readDelayedBlock<Interpolator>(rightChannel, mInterpolatorStates[rightChannel], rightDelayed, scratch, numSamples, rightDelayInt, rightFraction);
+
+		juce::FloatVectorOperations::add(scratch, leftData, rightData, numSamples);
+		juce::FloatVectorOperations::multiply(scratch, SampleType(0.5), numSamples);
+		mFeedbackRamp.addWithMultiply(scratch, rightDelayed, numSamples);
+		mDelayBuffer.write(leftChannel, scratch, numSamples);
+
+		juce::FloatVectorOperations::copy(scratch, leftDelayed, numSamples);
+		mFeedbackRamp.multiply(scratch, numSamples);
+		mDelayBuffer.write(rightChannel, scratch, numSamples);
+
+		// Mix delayed output
+		mMixRamp.mix(leftData, leftDelayed, numSamples);
+		mMixRamp.mix(rightData, rightDelayed, numSamples);
+		return;
+	}
+
+	// Both sides in one pass, feedback and mix are shared by the pair
+	auto	   &leftDelayTime  = mChannelDelayTimes[leftChannel];
+	auto	   &rightDelayTime = mChannelDelayTimes[rightChannel];
+	SampleType *leftLine	   = mDelayBuffer.getWritePointer(leftChannel);
+	SampleType *rightLine	   = mDelayBuffer.getWritePointer(rightChannel);
+	const int	writePosition  = mDelayBuffer.getWritePosition();
+
+	for (int i = 0; i < numSamples; ++i)
+	{
+		const SampleType feedbackValue = mFeedbackRamp.getValue(i);
+		const SampleType mixValue	   = mMixRamp.getValue(i);
+
+		getDelayInSamples<Interpolator>(leftDelayTime.getNextValue(), leftDelayInt, leftFraction);
+		getDelayInSamples<Interpolator>(rightDelayTime.getNextValue(), rightDelayInt, rightFraction);
+
+		const SampleType leftInput	   = leftData[i];
+		const SampleType rightInput	   = rightData[i];
+
+		const int		 position	   = mDelayBuffer.wrap(writePosition + i);
+		const SampleType leftDelayed   = readDelayedSample<Interpolator>(leftChannel, mInterpolatorStates[leftChannel], position, leftDelayInt, leftFraction);
+		const SampleType rightDelayed  = readDelayedSample<Interpolator>(rightChannel, mInterpolatorStates[rightChannel], position, rightDelayInt, rightFraction);
+
+		// Cross feedback
+		leftLine[position]			   = SampleType(0.5) * (leftInput + rightInput) + feedbackValue * rightDelayed;
+		rightLine[position]			   = feedbackValue * leftDelayed;
+
+		// Mix delayed output
+		leftData[i]					   = (SampleType(1) - mixValue) * leftInput + mixValue * leftDelayed;
+		rightData[i]				   = (SampleType(1) - mixValue) * rightInput + mixValue * rightDelayed;
+	}
+}
 
-			// Mix delayed output
-			channelData[i] = (SampleType(1.0f) - mixValue) * inputSample + (mixValue * out);
 
-			// Set write position
-			++writePosition;
-			if (writePosition >= mCircularBufferLength)
+template <typename SampleType>
+template <typename Interpolator>
+void Delay<SampleType>::processMultiTap(SampleType *leftData, SampleType *rightData, int numSamples)
+{
+	// The first line is fed with the mono sum of the first two channels and the feedback of the last tap.
+	// Every tap reads from that line and is panned into the first two channels. The taps are a stereo effect of
+	// the front pair, in surround layouts the centre, LFE, surround and height channels pass dry.
+	const bool isStereo		 = rightData != nullptr;
+	const int  writePosition = mDelayBuffer.getWritePosition();
+
+	SampleType	leftGain = SampleType(0), rightGain = SampleType(0);
+	int			delayInt = 0;
+	SampleType	fraction = SampleType(0);
+
+	bool		isBlockWise = numSamples <= mBlockBuffer.getNumSamples();
+	for (int tap = 0; tap < mNumTaps && isBlockWise; ++tap)
+		isBlockWise = isTapBehindBlock(mTaps[tap], numSamples);
+
+	if (isBlockWise)
+	{
+		// Each tap is read as a whole block and accumulated, the line is written once after all taps
+		SampleType *wetLeft	 = mBlockBuffer.getWritePointer(0);
+		SampleType *wetRight = mBlockBuffer.getWritePointer(1);
+		SampleType *scratch	 = mBlockBuffer.getWritePointer(2);
+		SampleType *tapBlock = mBlockBuffer.getWritePointer(3); // Holds the last tap for the feedback afterwards
+
+		juce::FloatVectorOperations::clear(wetLeft, numSamples);
+		juce::FloatVectorOperations::clear(wetRight, numSamples);
+
+		for (int tap = 0; tap < mNumTaps; ++tap)
+		{
+			auto &delayTap = mTaps[tap];
+
+			if (!delayTap.time.isSmoothing())
 			{
-				writePosition = 0;
+				getDelayInSamples<Interpolator>(delayTap.time.getTargetValue(), delayInt, fraction);
+				readDelayedBlock<Interpolator>(0, delayTap.interpolatorState, tapBlock, scratch, numSamples, delayInt, fraction);
 			}
+			else
+			{
+				for (int i = 0; i < numSamples; ++i)
+				{
+					getDelayInSamples<Interpolator>(delayTap.time.getNextValue(), delayInt, fraction);
+					tapBlock[i] = readDelayedSample<Interpolator>(0, delayTap.interpolatorState, mDelayBuffer.wrap(writePosition + i), delayInt, fraction);
+				}
+			}
+
+			if (!delayTap.gain.isSmoothing() && !delayTap.pan.isSmoothing())
+			{
+				getTapGains(delayTap.gain.getTargetValue(), delayTap.pan.getTargetValue(), isStereo, leftGain, rightGain);
+				juce::FloatVectorOperations::addWithMultiply(wetLeft, tapBlock, leftGain, numSamples);
+				juce::FloatVectorOperations::addWithMultiply(wetRight, tapBlock, rightGain, numSamples);
+			}
+			else
+			{
+				for (int i = 0; i < numSamples; ++i)
+				{
+					getTapGains(delayTap.gain.getNextValue(), delayTap.pan.getNextValue(), isStereo, leftGain, rightGain);
+					wetLeft[i] += leftGain * tapBlock[i];
+					wetRight[i] += rightGain * tapBlock[i];
+				}
+			}
+		}
+
+		// Mono input plus feedback into the delay buffer
+		if (isStereo)
+		{
+			juce::FloatVectorOperations::add(scratch, leftData, rightData, numSamples);
+			juce::FloatVectorOperations::multiply(scratch, SampleType(0.5), numSamples);
+		}
+		else
+		{
+			juce::FloatVectorOperations::copy(scratch, leftData, numSamples);
+		}
+
+		mFeedbackRamp.addWithMultiply(scratch, tapBlock, numSamples);
+
+		// Mix delayed output
+		mMixRamp.mix(leftData, wetLeft, numSamples);
+
+		if (isStereo)
+			mMixRamp.mix(rightData, wetRight, numSamples);
+
+		mDelayBuffer.write(0, scratch, numSamples);
+		return;
+	}
+
+	// At least one tap reads into the block, so the line has to be written sample by sample
+	SampleType *line = mDelayBuffer.getWritePointer(0);
+
+	for (int i = 0; i < numSamples; ++i)
+	{
+		const SampleType feedbackValue = mFeedbackRamp.getValue(i);
+		const SampleType mixValue	   = mMixRamp.getValue(i);
+		const int		 position	   = mDelayBuffer.wrap(writePosition + i);
+
+		SampleType		 wetLeft = SampleType(0), wetRight = SampleType(0), tapSample = SampleType(0);
+
+		for (int tap = 0; tap < mNumTaps; ++tap)
+		{
+			auto &delayTap = mTaps[tap];
+
+			getDelayInSamples<Interpolator>(delayTap.time.getNextValue(), delayInt, fraction);
+			tapSample = readDelayedSample<Interpolator>(0, delayTap.interpolatorState, position, delayInt, fraction);
+
+			getTapGains(delayTap.gain.getNextValue(), delayTap.pan.getNextValue(), isStereo, leftGain, rightGain);
+			wetLeft += leftGain * tapSample;
+			wetRight += rightGain * tapSample;
+		}
+
+		const SampleType monoInput = isStereo ? SampleType(0.5) * (leftData[i] + rightData[i]) : leftData[i];
+
+		// tapSample is the last tap now
+		line[position]			   = monoInput + feedbackValue * tapSample;
+
+		leftData[i]				   = (SampleType(1) - mixValue) * leftData[i] + mixValue * wetLeft;
+		if (isStereo)
+			rightData[i] = (SampleType(1) - mixValue) * rightData[i] + mixValue * wetRight;
+	}
+}
+
+
+template <typename SampleType>
+bool Delay<SampleType>::isTapBehindBlock(const DelayTap &tap, int numSamples) const
+{
+	const double shortestDelay = juce::jmin(tap.time.getCurrentValue(), tap.time.getTargetValue()) * mSamplesPerMS;
+
+	// One sample of headroom, the interpolators may move the first tap one sample closer
+	return static_cast<int>(shortestDelay) - 1 >= numSamples;
+}
+
+
+template <typename SampleType>
+void Delay<SampleType>::getTapGains(float gain, float pan, bool isStereo, SampleType &leftGain, SampleType &rightGain) const
+{
+	if (!isStereo)
+	{
+		leftGain  = static_cast<SampleType>(gain);
+		rightGain = SampleType(0);
+		return;
+	}
+
+	const float angle = (pan + 1.0f) * juce::MathConstants<float>::pi * 0.25f;
+	leftGain		  = static_cast<SampleType>(gain * std::cos(angle));
+	rightGain		  = static_cast<SampleType>(gain * std::sin(angle));
+}
+
+
+template <typename SampleType>
+template <typename Interpolator>
+bool Delay<SampleType>::getConstantDelay(int channel, int numSamples, int &delayInt, SampleType &fraction) const
+{
+	const auto &delayTime = mChannelDelayTimes[channel];
+
+	if (delayTime.isSmoothing() || numSamples > mBlockBuffer.getNumSamples())
+		return false;
+
+	getDelayInSamples<Interpolator>(delayTime.getTargetValue(), delayInt, fraction);
+
+	// Every tap of the block has been written before, so it can be read as a whole
+	return delayInt >= numSamples;
+}
+
+
+template <typename SampleType>
+template <typename Interpolator>
+SampleType Delay<SampleType>::readDelayedSample(int channel, SampleType &state, int position, int delayInt, SampleType fraction)
+{
+	const SampleType *delayBufferData = mDelayBuffer.getReadPointer(channel);
+	const int		  firstTap		  = position - delayInt;
+
+	if constexpr (Interpolator::isRecursive)
+	{
+		return Interpolator::filter(delayBufferData[mDelayBuffer.wrap(firstTap)], delayBufferData[mDelayBuffer.wrap(firstTap - 1)], Interpolator::coefficient(fraction), state);
+	}
+	else
+	{
+		const auto coefficients	 = Interpolator::coefficients(fraction);
+		SampleType delayedSample = SampleType(0);
+
+		for (int tap = 0; tap < Interpolator::numTaps; ++tap)
+			delayedSample += coefficients[tap] * delayBufferData[mDelayBuffer.wrap(firstTap - tap)];
+
+		return delayedSample;
+	}
+}
+
+
+template <typename SampleType>
+template <typename Interpolator>
+void Delay<SampleType>::readDelayedBlock(int channel, SampleType &state, SampleType *destination, SampleType *scratch, int numSamples, int delayInt, SampleType fraction)
+{
+	if constexpr (Interpolator::isRecursive)
+	{
+		const SampleType coefficient = Interpolator::coefficient(fraction);
+
+		mDelayBuffer.read(channel, destination, delayInt, numSamples);
+		mDelayBuffer.read(channel, scratch, delayInt + 1, numSamples);
+
+		for (int i = 0; i < numSamples; ++i)
+			destination[i] = Interpolator::filter(destination[i], scratch[i], coefficient, state);
+	}
+	else
+	{
+		// Weighted sum of whole tap blocks
+		const auto coefficients = Interpolator::coefficients(fraction);
+
+		mDelayBuffer.read(channel, scratch, delayInt, numSamples);
+		juce::FloatVectorOperations::copyWithMultiply(destination, scratch, coefficients[0], numSamples);
+
+		for (int tap = 1; tap < Interpolator::numTaps; ++tap)
+		{
+			mDelayBuffer.read(channel, scratch, delayInt + tap, numSamples);
+			juce::FloatVectorOperations::addWithMultiply(destination, scratch, coefficients[tap], numSamples);
 		}
 	}
 }
 
 
+template <typename SampleType>
+template <typename Interpolator>
+void Delay<SampleType>::getDelayInSamples(float delayInMS, int &delayInt, SampleType &fraction) const
+{
+	const SampleType delayInSamples = juce::jlimit(static_cast<SampleType>(Interpolator::minimumDelay), static_cast<SampleType>(mMaxDelayInSamples),
+												   static_cast<SampleType>(delayInMS * mSamplesPerMS));
+
+	FractionalDelay::split<Interpolator>(delayInSamples, delayInt, fraction);
+}
+
+
 template <typename SampleType>
 void Delay<SampleType>::reset()
 {
-	// Clear delay buffer and reset write positions
-	if (mDelayBuffer.getBuffer().getNumSamples() > 0)
+	// Clear delay buffer and reset the write position
+	mDelayBuffer.reset();
+
+	std::fill(mInterpolatorStates.begin(), mInterpolatorStates.end(), SampleType(0));
+
+	for (auto &tap : mTaps)
+		tap.interpolatorState = SampleType(0);
+
+	this->resetSilenceDetector();
+}
+
+
+template <typename SampleType>
+constexpr ParameterSetters<Delay<SampleType>> Delay<SampleType>::createParameterSetters()
+{
+	ParameterSetters<Delay> setters{};
+
+	setters[toIndex(ParamId::DelayMix)]		 = [](Delay &delay, ParamId, float value) { delay.setMix(value); };
+	setters[toIndex(ParamId::DelayFeedback)] = [](Delay &delay, ParamId, float value) { delay.setFeedback(value); };
+	setters[toIndex(ParamId::DelayTimeLeft)] = [](Delay &delay, ParamId, float value) { delay.setSideDelayTime(0, value); };
+	setters[toIndex(ParamId::DelayTimeRight)] = [](Delay &delay, ParamId, float value) { delay.setSideDelayTime(1, value); };
+	setters[toIndex(ParamId::DelayNumTaps)]	 = [](Delay &delay, ParamId, float value) { delay.setNumTaps(static_cast<int>(value)); };
+
+	// Choice index 0 is DelayType::SingleTap
+	setters[toIndex(ParamId::DelayModel)]	 = [](Delay &delay, ParamId, float value) { delay.setDelayType(static_cast<DelayType>(static_cast<int>(value) + DelayType::SingleTap)); };
+	setters[toIndex(ParamId::DelayInterpolation)] = [](Delay &delay, ParamId, float value)
+	{ delay.setInterpolation(static_cast<DelayInterpolation>(static_cast<int>(value))); };
+
+	// The tap is recovered from the offset of the ID within its contiguous range
+	for (int tap = 0; tap < delayMaxTaps; ++tap)
 	{
-		mDelayBuffer.getBuffer().clear();
+		setters[toIndex(delayTapTimeId(tap))] = [](Delay &delay, ParamId id, float value)
+		{ delay.setTapTime(static_cast<int>(toIndex(id) - toIndex(ParamId::DelayTapTime1)), value); };
+		setters[toIndex(delayTapGainId(tap))] = [](Delay &delay, ParamId id, float value)
+		{ delay.setTapGain(static_cast<int>(toIndex(id) - toIndex(ParamId::DelayTapGain1)), value); };
+		setters[toIndex(delayTapPanId(tap))] = [](Delay &delay, ParamId id, float value)
+		{ delay.setTapPan(static_cast<int>(toIndex(id) - toIndex(ParamId::DelayTapPan1)), value); };
 	}
 
-	for (auto &pos : mWritePositions)
+	return setters;
+}
+
+
+template <typename SampleType>
+constexpr ParameterGetters<Delay<SampleType>> Delay<SampleType>::createParameterGetters()
+{
+	ParameterGetters<Delay> getters{};
+
+	getters[toIndex(ParamId::DelayMix)]		 = [](const Delay &delay, ParamId) { return delay.mMix.getTargetValue(); };
+	getters[toIndex(ParamId::DelayFeedback)] = [](const Delay &delay, ParamId) { return delay.mFeedback.getTargetValue(); };
+	getters[toIndex(ParamId::DelayTimeLeft)] = [](const Delay &delay, ParamId)
+	{ return delay.mChannelDelayTimes.size() > 0 ? delay.mChannelDelayTimes[0].getTargetValue() : 0.0f; };
+	getters[toIndex(ParamId::DelayTimeRight)] = [](const Delay &delay, ParamId)
+	{ return delay.mChannelDelayTimes.size() > 1 ? delay.mChannelDelayTimes[1].getTargetValue() : 0.0f; };
+	getters[toIndex(ParamId::DelayNumTaps)]		  = [](const Delay &delay, ParamId) { return static_cast<float>(delay.getNumTaps()); };
+	getters[toIndex(ParamId::DelayModel)]		  = [](const Delay &delay, ParamId) { return static_cast<float>(delay.getDelayType() - DelayType::SingleTap); };
+	getters[toIndex(ParamId::DelayInterpolation)] = [](const Delay &delay, ParamId) { return static_cast<float>(delay.getInterpolation()); };
+
+	for (int tap = 0; tap < delayMaxTaps; ++tap)
 	{
-		pos = 0;
+		getters[toIndex(delayTapTimeId(tap))] = [](const Delay &delay, ParamId id)
+		{ return delay.mTaps[toIndex(id) - toIndex(ParamId::DelayTapTime1)].time.getTargetValue(); };
+		getters[toIndex(delayTapGainId(tap))] = [](const Delay &delay, ParamId id)
+		{ return delay.mTaps[toIndex(id) - toIndex(ParamId::DelayTapGain1)].gain.getTargetValue(); };
+		getters[toIndex(delayTapPanId(tap))] = [](const Delay &delay, ParamId id)
+		{ return delay.mTaps[toIndex(id) - toIndex(ParamId::DelayTapPan1)].pan.getTargetValue(); };
 	}
+
+	return getters;
 }
 
 
 template <typename SampleType>
-void Delay<SampleType>::setParameter(const std::string &name, float value)
+void Delay<SampleType>::setParameter(ParamId id, float value)
 {
-	if (name == paramMixDelay)
-		setMix(value);
-	else if (name == paramDelayFeedback)
-		setFeedback(value);
-	else if (name == paramDelayTimeLeft && mChannelDelayTimes.size() > 0)
-		setChannelDelayTime(0, value);
-	else if (name == paramDelayTimeRight && mChannelDelayTimes.size() > 1)
-		setChannelDelayTime(1, value);
+	static constexpr auto setters = createParameterSetters();
+
+	if (const auto setter = setters[toIndex(id)])
+		setter(*this, id, value);
 }
 
 
 template <typename SampleType>
-float Delay<SampleType>::getParameter(const std::string &name) const
+float Delay<SampleType>::getParameter(ParamId id) const
 {
-	if (name == paramMixDelay)
-		return mMix.getCurrentValue();
-	else if (name == paramDelayFeedback)
-		return mFeedback.getCurrentValue();
-	else if (name == paramDelayTimeLeft && mChannelDelayTimes.size() > 0)
-		return mChannelDelayTimes[0].getCurrentValue();
-	else if (name == paramDelayTimeRight && mChannelDelayTimes.size() > 1)
-		return mChannelDelayTimes[1].getCurrentValue();
+	static constexpr auto getters = createParameterGetters();
+
+	if (const auto getter = getters[toIndex(id)])
+		return getter(*this, id);
 
 	return 0.0f;
 }
@@ -177,7 +616,13 @@ float Delay<SampleType>::getParameter(const std::string &name) const
 template <typename SampleType>
 void Delay<SampleType>::prepareDelayBuffer()
 {
-	mDelayBuffer.prepare(this->getSampleRate(), this->getMaxBlockSize(), this->getNumChannels(), static_cast<int>(mMaxDelayInMS * 0.001f * this->getSampleRate()));
+	mMaxDelayInSamples = juce::jmax(1, static_cast<int>(std::ceil(mMaxDelayInMS * 0.001 * this->getSampleRate())));
+
+	// Room for the longest delay, the interpolation taps behind it and one block, so a whole block can be read behind the write position
+	mDelayBuffer.prepare(this->getNumChannels(), mMaxDelayInSamples + FractionalDelay::maxNumTaps + this->getMaxBlockSize());
+
+	// The capacity may have been clamped by the memory budget
+	mMaxDelayInSamples = juce::jmin(mMaxDelayInSamples, mDelayBuffer.getCapacity() - FractionalDelay::maxNumTaps);
 }
 
 
@@ -192,6 +637,7 @@ template <typename SampleType>
 void Delay<SampleType>::setFeedback(float newValue)
 {
 	mFeedback.setTargetValue(newValue);
+	updateTailLength();
 }
 
 
@@ -208,6 +654,7 @@ void Delay<SampleType>::setDelayType(DelayType type)
 	if (mDelayType != type)
 	{
 		mDelayType = type;
+		updateTailLength();
 	}
 }
 
@@ -219,6 +666,208 @@ void Delay<SampleType>::setChannelDelayTime(int channel, float timeInMS)
 		return;
 
 	mChannelDelayTimes[channel].setTargetValue(timeInMS);
+	updateTailLength();
+}
+
+
+template <typename SampleType>
+void Delay<SampleType>::setSideDelayTime(int side, float timeInMS)
+{
+	if (side < 0 || side > 1)
+		return;
+
+	const ChannelRole sideRole = side == 0 ? ChannelRole::Left : ChannelRole::Right;
+
+	for (int channel = 0; channel < static_cast<int>(mChannelRoles.size()); ++channel)
+	{
+		const ChannelRole role = mChannelRoles[channel];
+
+		if (role == sideRole || (side == 0 && role == ChannelRole::Centre))
+			mChannelDelayTimes[channel].setTargetValue(timeInMS);
+	}
+
+	updateTailLength();
+}
+
+
+template <typename SampleType>
+void Delay<SampleType>::assignChannelRoles(int numChannels)
+{
+	using ChannelType = juce::AudioChannelSet::ChannelType;
+
+	mChannelRoles.assign(numChannels, ChannelRole::Centre);
+	mPartnerChannels.assign(numChannels, -1);
+
+	bool isNamedLayout = mLayout.size() == numChannels;
+
+	for (int channel = 0; isNamedLayout && channel < numChannels; ++channel)
+		isNamedLayout = mLayout.getTypeOfChannel(channel) < juce::AudioChannelSet::discreteChannel0;
+
+	if (!isNamedLayout)
+	{
+		// Consecutive channels pair up, a mono channel is a centre
+		for (int channel = 0; channel + 1 < numChannels; channel += 2)
+		{
+			mChannelRoles[channel]		   = ChannelRole::Left;
+			mChannelRoles[channel + 1]	   = ChannelRole::Right;
+			mPartnerChannels[channel]	   = channel + 1;
+			mPartnerChannels[channel + 1] = channel;
+		}
+		return;
+	}
+
+	// Left and right speakers mirroring each other, the left one first
+	static constexpr std::array<std::pair<ChannelType, ChannelType>, 9> speakerPairs{{
+		{juce::AudioChannelSet::left, juce::AudioChannelSet::right},
+		{juce::AudioChannelSet::leftCentre, juce::AudioChannelSet::rightCentre},
+		{juce::AudioChannelSet::leftSurround, juce::AudioChannelSet::rightSurround},
+		{juce::AudioChannelSet::leftSurroundSide, juce::AudioChannelSet::rightSurroundSide},
+		{juce::AudioChannelSet::leftSurroundRear, juce::AudioChannelSet::rightSurroundRear},
+		{juce::AudioChannelSet::wideLeft, juce::AudioChannelSet::wideRight},
+		{juce::AudioChannelSet::topFrontLeft, juce::AudioChannelSet::topFrontRight},
+		{juce::AudioChannelSet::topSideLeft, juce::AudioChannelSet::topSideRight},
+		{juce::AudioChannelSet::topRearLeft, juce::AudioChannelSet::topRearRight},
+	}};
+
+	for (const auto &[leftType, rightType] : speakerPairs)
+	{
+		const int left	= mLayout.getChannelIndexForType(leftType);
+		const int right = mLayout.getChannelIndexForType(rightType);
+
+		// A left speaker without its right one stays a centre, a lone right speaker keeps the right time
+		if (right >= 0)
+			mChannelRoles[right] = ChannelRole::Right;
+
+		if (left < 0 || right < 0)
+			continue;
+
+		mChannelRoles[left]	   = ChannelRole::Left;
+		mPartnerChannels[left]  = right;
+		mPartnerChannels[right] = left;
+	}
+
+	for (int channel = 0; channel < numChannels; ++channel)
+	{
+		const ChannelType type = mLayout.getTypeOfChannel(channel);
+
+		if (type == juce::AudioChannelSet::LFE || type == juce::AudioChannelSet::LFE2)
+			mChannelRoles[channel] = ChannelRole::Dry;
+	}
+}
+
+
+template <typename SampleType>
+DelayInterpolation Delay<SampleType>::getInterpolation() const
+{
+	return mInterpolation;
+}
+
+
+template <typename SampleType>
+void Delay<SampleType>::setInterpolation(DelayInterpolation interpolation)
+{
+	mInterpolation = interpolation;
+}
+
+
+template <typename SampleType>
+int Delay<SampleType>::getNumTaps() const
+{
+	return mNumTaps;
+}
+
+
+template <typename SampleType>
+void Delay<SampleType>::setNumTaps(int numTaps)
+{
+	mNumTaps = juce::jlimit(1, delayMaxTaps, numTaps);
+	updateTailLength();
+}
+
+
+template <typename SampleType>
+void Delay<SampleType>::setTapTime(int tap, float timeInMS)
+{
+	if (tap < 0 || tap >= delayMaxTaps)
+		return;
+
+	mTaps[tap].time.setTargetValue(timeInMS);
+	updateTailLength();
+}
+
+
+template <typename SampleType>
+void Delay<SampleType>::setTapGain(int tap, float gain)
+{
+	if (tap < 0 || tap >= delayMaxTaps)
+		return;
+
+	mTaps[tap].gain.setTargetValue(gain);
+}
+
+
+template <typename SampleType>
+void Delay<SampleType>::setTapPan(int tap, float pan)
+{
+	if (tap < 0 || tap >= delayMaxTaps)
+		return;
+
+	mTaps[tap].pan.setTargetValue(pan);
+}
+
+
+template <typename SampleType>
+void Delay<SampleType>::skipParameterRamps(int numSamples)
+{
+	mFeedback.skip(numSamples);
+	mMix.skip(numSamples);
+
+	for (auto &delayTime : mChannelDelayTimes)
+		delayTime.skip(numSamples);
+
+	for (auto &tap : mTaps)
+	{
+		tap.time.skip(numSamples);
+		tap.gain.skip(numSamples);
+		tap.pan.skip(numSamples);
+	}
+}
+
+
+template <typename SampleType>
+void Delay<SampleType>::updateTailLength()
+{
+	// Longest time between a sample entering a line and leaving it again, ping pong alternates between both lines
+	float longestDelayInMS = 0.0f;
+
+	if (mDelayType == DelayType::MultiTap)
+	{
+		for (int tap = 0; tap < mNumTaps; ++tap)
+			longestDelayInMS = juce::jmax(longestDelayInMS, mTaps[tap].time.getTargetValue());
+	}
+	else
+	{
+		for (const auto &delayTime : mChannelDelayTimes)
+			longestDelayInMS = juce::jmax(longestDelayInMS, delayTime.getTargetValue());
+	}
+
+	longestDelayInMS = juce::jmin(longestDelayInMS, mMaxDelayInMS);
+
+	// Every pass through the line scales the signal by the feedback, a full scale input needs this many passes to
+	// fall below the silence threshold. The first pass is the dry input itself.
+	const double feedback  = std::abs(static_cast<double>(mFeedback.getTargetValue()));
+	double		 numPasses = 1.0;
+
+	if (feedback >= 1.0)
+		numPasses = std::numeric_limits<double>::infinity();
+	else if (feedback > 0.0)
+		numPasses += std::ceil(std::log(static_cast<double>(SilenceDetector<SampleType>::threshold)) / std::log(feedback));
+
+	// The shortest delay is one sample, plus a block of headroom for the smoothing of the delay times
+	const double sampleSeconds = this->getSampleRate() > 0.0 ? 1.0 / this->getSampleRate() : 0.0;
+	const double delaySeconds  = juce::jmax(static_cast<double>(longestDelayInMS) * 0.001, sampleSeconds);
+
+	mTailLengthSeconds.store(numPasses * delaySeconds + this->getMaxBlockSize() * sampleSeconds, std::memory_order_relaxed);
 }
 
 
@@ -11,6 +11,8 @@
 
 #include "EffectBase.h"
 #include "CircularBuffer.h"
+#include "FractionalDelay.h"
+#include "BlockSmoother.h"
 #include "Parameters.h"
 
 
@@ -27,10 +29,15 @@ public:
 	void	   reset() override;
 	EffectType getEffectType() const override { return EffectType::Delay; }
 
-	void	   setParameter(const std::string &name, float value) override;
-	float	   getParameter(const std::string &name) const override;
+	// Until the repeats of the longest delay decayed below the silence threshold with the current feedback
+	double	   getTailLengthSeconds() const override { return mTailLengthSeconds.load(std::memory_order_relaxed); }
+
+	// Takes the plain value of the parameter, choice parameters as their index
+	void	   setParameter(ParamId id, float value) override;
+	float	   getParameter(ParamId id) const override;
 
 	void	   prepareDelayBuffer();
+	int		   getDelayBufferCapacity() const { return mDelayBuffer.getCapacity(); }
 
 	void	   setMix(float newValue);
 	void	   setFeedback(float newValue);
@@ -40,19 +47,118 @@ public:
 
 	void	   setChannelDelayTime(int channel, float timeInMS);
 
+	// Surround layouts have more channels than delay times: the left speakers and the centres follow the left time,
+	// the right speakers the right time, the LFE stays dry. Side 0 is left, 1 is right.
+	void	   setSideDelayTime(int side, float timeInMS);
+
+	// Channel order of the host bus, takes effect in the next prepare(). Without a named layout the even channels
+	// are left and the odd ones right.
+	void	   setChannelLayout(const juce::AudioChannelSet &layout) { mLayout = layout; }
+
+	DelayInterpolation getInterpolation() const;
+	void			   setInterpolation(DelayInterpolation interpolation);
+
+	// Multi Tap mode
+	int		   getNumTaps() const;
+	void	   setNumTaps(int numTaps);
+	void	   setTapTime(int tap, float timeInMS);
+	void	   setTapGain(int tap, float gain);
+	void	   setTapPan(int tap, float pan);
+
 private:
+	// Part a channel plays in the delay, given by its speaker type
+	enum class ChannelRole
+	{
+		Left,
+		Right,
+		Centre, // Delayed on its own with the left time, also in ping pong
+		Dry		// LFE
+	};
+
+	struct DelayTap
+	{
+		juce::SmoothedValue<float> time; // in MS
+		juce::SmoothedValue<float> gain;
+		juce::SmoothedValue<float> pan;	 // -1 (left) to 1 (right)
+		SampleType				   interpolatorState{0};
+	};
+
+	static constexpr ParameterSetters<Delay> createParameterSetters();
+	static constexpr ParameterGetters<Delay> createParameterGetters();
+
+	template <typename Interpolator>
+	void	   processDelay(juce::AudioBuffer<SampleType> &buffer, int startSample, int numSamples);
+
+	template <typename Interpolator>
+	void	   processChannel(SampleType *channelData, int channel, int numSamples);
+
+	// Cross feedback between a left channel and its right partner, both processed in one pass
+	template <typename Interpolator>
+	void	   processPingPong(SampleType *leftData, SampleType *rightData, int leftChannel, int rightChannel, int numSamples);
+
+	// Roles and ping pong partners of the prepared channels, from the layout or by index
+	void	   assignChannelRoles(int numChannels);
+
+	// Taps share the first line of the delay buffer, the last tap is fed back
+	template <typename Interpolator>
+	void	   processMultiTap(SampleType *leftData, SampleType *rightData, int numSamples);
+
+	// True if no tap reads into the block while its delay time moves from the current to the target value
+	bool	   isTapBehindBlock(const DelayTap &tap, int numSamples) const;
+
+	// Constant power pan law, without panning for mono output
+	void	   getTapGains(float gain, float pan, bool isStereo, SampleType &leftGain, SampleType &rightGain) const;
+
+	template <typename Interpolator>
+	bool	   getConstantDelay(int channel, int numSamples, int &delayInt, SampleType &fraction) const;
+
+	template <typename Interpolator>
+	SampleType readDelayedSample(int channel, SampleType &state, int position, int delayInt, SampleType fraction);
+
+	template <typename Interpolator>
+	void	   readDelayedBlock(int channel, SampleType &state, SampleType *destination, SampleType *scratch, int numSamples, int delayInt, SampleType fraction);
+
+	template <typename Interpolator>
+	void	   getDelayInSamples(float delayInMS, int &delayInt, SampleType &fraction) const;
+
+	// Called by every setter the tail depends on
+	void	   updateTailLength();
+
+	// Moves the parameter ramps on by a skipped block, so they keep their timing through silence
+	void	   skipParameterRamps(int numSamples);
+
 	juce::SmoothedValue<float>				mFeedback;
 	juce::SmoothedValue<float>				mMix;
 
+	BlockSmoother<SampleType>				mFeedbackRamp; // Rendered once per block, shared by all channels
+	BlockSmoother<SampleType>				mMixRamp;
+
 	std::vector<juce::SmoothedValue<float>> mChannelDelayTimes; // Using different delay times for each channel
 
-	int										mCircularBufferLength{0};
+	juce::AudioChannelSet					mLayout;
 
-	std::vector<int>						mWritePositions;
+	std::vector<ChannelRole>				mChannelRoles;
+	std::vector<int>						mPartnerChannels;	 // Other channel of a ping pong pair, -1 without a partner
 
 	float									mMaxDelayInMS{0.0f};
 
+	int										mMaxDelayInSamples{1};
+
+	double									mSamplesPerMS{0.0};
+
 	DelayType								mDelayType{DelayType::SingleTap};
 
+	DelayInterpolation						mInterpolation{DelayInterpolation::LinearInterpolation};
+
 	CircularBuffer<SampleType>				mDelayBuffer;
+
+	juce::AudioBuffer<SampleType>			mBlockBuffer;		 // Delayed blocks (left, right), scratch and tap block of the block path
+
+	std::vector<SampleType>					mInterpolatorStates; // Thiran allpass state per channel
+
+	std::array<DelayTap, delayMaxTaps>		mTaps;
+
+	int										mNumTaps{delayNumTapsDefault};
+
+	std::atomic<double>						mTailLengthSeconds{0.0};
 };
@@ -9,6 +9,207 @@
 
 #include "Distortion.h"
 
+
+namespace
+{
+//==============================================================================
+// Antiderivatives of the waveshaper curves used by the ADAA modes.
+// Everything is evaluated in double precision, the differences of the
+// antiderivatives cancel badly in single precision.
+//==============================================================================
+
+constexpr double antiderivativeTolerance = 1.0e-5;
+constexpr double hardClipThreshold		 = 0.99;
+constexpr double softClipCoefficient	 = 2.0 / juce::MathConstants<double>::pi;
+
+
+struct HardClipCurve
+{
+	static double f(double x) { return juce::jlimit(-hardClipThreshold, hardClipThreshold, x); }
+
+	static double F1(double x)
+	{
+		const double c = hardClipThreshold;
+		return std::abs(x) <= c ? 0.5 * x * x : c * std::abs(x) - 0.5 * c * c;
+	}
+
+	static double F2(double x)
+	{
+		const double c = hardClipThreshold;
+
+		if (std::abs(x) <= c)
+			return x * x * x / 6.0;
+
+		const double absX = std::abs(x);
+		return std::copysign(0.5 * c * absX * absX - 0.5 * c * c * absX + c * c * c / 6.0, x);
+	}
+};
+
+
+struct SoftClipCurve
+{
+	static double f(double x) { return softClipCoefficient * std::atan(x); }
+
+	static double F1(double x) { return softClipCoefficient * (x * std::atan(x) - 0.5 * std::log1p(x * x)); }
+
+	static double F2(double x) { return 0.5 * softClipCoefficient * ((x * x - 1.0) * std::atan(x) + x - x * std::log1p(x * x)); }
+};
+
+
+// tanh(sinh(x)) and the second antiderivative of tanh(x) have no elementary closed form,
+// so the antiderivatives of the saturation curve are tabulated once and read with cubic
+// Hermite interpolation (using the exact derivatives). Beyond the table the curve is
+// 1 for positive and -1 - 0.2 * x * sin(pi * x) for negative inputs, integrated in closed form.
+class SaturationAntiderivatives
+{
+public:
+	SaturationAntiderivatives()
+	{
+		mF0.resize(numPoints);
+		mF1.resize(numPoints);
+		mF2.resize(numPoints);
+
+		for (int i = 0; i < numPoints; ++i)
+			mF0[i] = f(position(i));
+
+		// Integrate outwards from zero, F1(0) = F2(0) = 0
+		const int centre = numPoints / 2;
+		mF1[centre]		 = 0.0;
+		mF2[centre]		 = 0.0;
+
+		for (int i = centre + 1; i < numPoints; ++i)
+		{
+			mF1[i] = mF1[i - 1] + integrateCurve(position(i - 1), position(i));
+			mF2[i] = mF2[i - 1] + integrateHermite(mF1[i - 1], mF1[i], mF0[i - 1], mF0[i]);
+		}
+
+		for (int i = centre - 1; i >= 0; --i)
+		{
+			mF1[i] = mF1[i + 1] - integrateCurve(position(i), position(i + 1));
+			mF2[i] = mF2[i + 1] - integrateHermite(mF1[i], mF1[i + 1], mF0[i], mF0[i + 1]);
+		}
+	}
+
+	static double f(double x)
+	{
+		if (x >= 0.0)
+			return std::tanh(x);
+
+		return std::tanh(std::sinh(x)) - 0.2 * x * std::sin(juce::MathConstants<double>::pi * x);
+	}
+
+	double F1(double x) const
+	{
+		if (x > tableRange)
+			return mF1.back() + (x - tableRange);
+
+		if (x < -tableRange)
+			return mF1.front() + tailF1(x) - tailF1(-tableRange);
+
+		return interpolate(x, mF1, mF0);
+	}
+
+	double F2(double x) const
+	{
+		if (x > tableRange)
+		{
+			const double dx = x - tableRange;
+			return mF2.back() + mF1.back() * dx + 0.5 * dx * dx;
+		}
+
+		if (x < -tableRange)
+		{
+			const double dx = x + tableRange;
+			return mF2.front() + mF1.front() * dx + tailF2(x) - tailF2(-tableRange) - tailF1(-tableRange) * dx;
+		}
+
+		return interpolate(x, mF2, mF1);
+	}
+
+private:
+	static constexpr double tableRange		 = 8.0;
+	static constexpr int	pointsPerUnit	 = 256;
+	static constexpr int	numPoints		 = static_cast<int>(2.0 * tableRange) * pointsPerUnit + 1;
+	static constexpr double stepSize		 = 1.0 / pointsPerUnit;
+
+	static double			position(int index) { return -tableRange + index * stepSize; }
+
+	// Antiderivatives of the negative tail -1 - 0.2 * x * sin(pi * x)
+	static double			tailF1(double x)
+	{
+		constexpr double pi = juce::MathConstants<double>::pi;
+		return -x - 0.2 * (std::sin(pi * x) / (pi * pi) - x * std::cos(pi * x) / pi);
+	}
+
+	static double tailF2(double x)
+	{
+		constexpr double pi = juce::MathConstants<double>::pi;
+		return -0.5 * x * x + 0.2 * (2.0 * std::cos(pi * x) / (pi * pi * pi) + x * std::sin(pi * x) / (pi * pi));
+	}
+
+	// 5-point Gauss-Legendre quadrature of the curve over [a, b]
+	static double integrateCurve(double a, double b)
+	{
+		static constexpr std::array<double, 5> nodes   = {0.0, -0.5384693101056831, 0.5384693101056831, -0.9061798459386640, 0.9061798459386640};
+		static constexpr std::array<double, 5> weights = {0.5688888888888889, 0.4786286704993665, 0.4786286704993665, 0.2369268850561891, 0.2369268850561891};
+
+		const double						   halfWidth = 0.5 * (b - a);
+		const double						   centre	 = 0.5 * (a + b);
+
+		double								   sum		 = 0.0;
+		for (size_t i = 0; i < nodes.size(); ++i)
+			sum += weights[i] * f(centre + halfWidth * nodes[i]);
+
+		return sum * halfWidth;
+	}
+
+	// Exact integral of the cubic Hermite interpolant between two table points
+	static double integrateHermite(double valueA, double valueB, double slopeA, double slopeB)
+	{
+		return 0.5 * stepSize * (valueA + valueB) + stepSize * stepSize * (slopeA - slopeB) / 12.0;
+	}
+
+	static double interpolate(double x, const std::vector<double> &values, const std::vector<double> &slopes)
+	{
+		const double scaled = (x + tableRange) * pointsPerUnit;
+		const int	 index	= juce::jlimit(0, numPoints - 2, static_cast<int>(scaled));
+		const double t		= scaled - index;
+
+		const double t2		= t * t;
+		const double t3		= t2 * t;
+
+		const double h00	= 2.0 * t3 - 3.0 * t2 + 1.0;
+		const double h10	= t3 - 2.0 * t2 + t;
+		const double h01	= -2.0 * t3 + 3.0 * t2;
+		const double h11	= t3 - t2;
+
+		return h00 * values[index] + h10 * stepSize * slopes[index] + h01 * values[index + 1] + h11 * stepSize * slopes[index + 1];
+	}
+
+	std::vector<double> mF0;
+	std::vector<double> mF1;
+	std::vector<double> mF2;
+};
+
+
+const SaturationAntiderivatives &getSaturationAntiderivatives()
+{
+	static const SaturationAntiderivatives antiderivatives;
+	return antiderivatives;
+}
+
+
+struct SaturationCurve
+{
+	static double f(double x) { return SaturationAntiderivatives::f(x); }
+
+	static double F1(double x) { return getSaturationAntiderivatives().F1(x); }
+
+	static double F2(double x) { return getSaturationAntiderivatives().F2(x); }
+};
+} // namespace
+
+
 template <typename SampleType>
 Distortion<SampleType>::Distortion()
 {
@@ -25,7 +226,46 @@ void Distortion<SampleType>::prepare(const juce::dsp::ProcessSpec &spec)
 
 	mDCFilter.prepare(spec);
 	mDCFilter.setCutoffFrequency(10.0);
-	mDCFilter.setType(juce::dsp::LinkwitzRileyFilter<float>::Type::highpass);
+	mDCFilter.setType(juce::dsp::LinkwitzRileyFilter<SampleType>::Type::highpass);
+
+	mDCBlocker.prepare(spec.sampleRate, static_cast<int>(spec.numChannels));
+
+	// Allocate the scratch memory for the block processing
+	const auto maxBlockSize = static_cast<size_t>(spec.maximumBlockSize);
+	mDriveRamp.prepare(static_cast<int>(spec.maximumBlockSize));
+	mMixRamp.prepare(static_cast<int>(spec.maximumBlockSize));
+	mOutputRamp.prepare(static_cast<int>(spec.maximumBlockSize));
+	mDryBuffer.setSize(static_cast<int>(spec.numChannels), static_cast<int>(spec.maximumBlockSize));
+
+	// Prepare every oversampling setting up front, so switching at runtime never allocates
+	float maxLatency = 0.0f;
+
+	for (int stage = 0; stage < numOversamplingStages; ++stage)
+	{
+		const auto factorLog2 = static_cast<size_t>(stage + 1);
+
+		mIIROversamplers[stage] =
+			std::make_unique<juce::dsp::Oversampling<SampleType>>(spec.numChannels, factorLog2, juce::dsp::Oversampling<SampleType>::filterHalfBandPolyphaseIIR, true, true);
+		mFIROversamplers[stage] =
+			std::make_unique<juce::dsp::Oversampling<SampleType>>(spec.numChannels, factorLog2, juce::dsp::Oversampling<SampleType>::filterHalfBandFIREquiripple, true, true);
+
+		for (auto *oversampler : {mIIROversamplers[stage].get(), mFIROversamplers[stage].get()})
+		{
+			oversampler->initProcessing(maxBlockSize);
+			maxLatency = juce::jmax(maxLatency, static_cast<float>(oversampler->getLatencyInSamples()));
+		}
+	}
+
+	// The second order ADAA adds up to one more sample of delay
+	mMaxLatencyInSamples = maxLatency + 1.0f;
+	mDryDelay.setMaximumDelayInSamples(static_cast<int>(std::ceil(maxLatency)) + 2);
+	mDryDelay.prepare(spec);
+
+	mActiveOversampler = nullptr;
+
+	// Build the saturation tables here instead of on the first audio callback
+	mAntiderivativeStates.assign(spec.numChannels, AntiderivativeState{});
+	getSaturationAntiderivatives();
 
 	reset();
 }
@@ -34,27 +274,330 @@ void Distortion<SampleType>::prepare(const juce::dsp::ProcessSpec &spec)
 template <typename SampleType>
 void Distortion<SampleType>::process(juce::AudioBuffer<SampleType> &buffer)
 {
+	RealtimeSafety::ScopedRealtimeSection realtimeSection;
+
 	if (this->isBypassed())
 	{
 		this->processBypassed(buffer);
 		return;
 	}
 
-	const auto numChannels = buffer.getNumChannels();
-	const auto numSamples  = buffer.getNumSamples();
+	const int maxBlockSize = mDryBuffer.getNumSamples();
+
+	jassert(maxBlockSize > 0); // Call ::prepare before attempting to call ::process()!
+	if (maxBlockSize == 0)
+		return;
+
+	if (this->skipSilentBlock(buffer))
+	{
+		skipParameterRamps(buffer.getNumSamples());
+		return;
+	}
+
+	// Resolve the distortion type once per block
+	const auto type		  = getCurrentDistortionType();
+	const int  numSamples = buffer.getNumSamples();
+
+	if (type != DistortionType::hardClipping && type != DistortionType::softClipping && type != DistortionType::saturation)
+		return;
+
+	updateProcessingSettings();
+
+	// Hosts may exceed the announced block size, so process in chunks fitting the scratch memory
+	for (int startSample = 0; startSample < numSamples; startSample += maxBlockSize)
+	{
+		processChunk(buffer, startSample, juce::jmin(maxBlockSize, numSamples - startSample), type);
+	}
+}
+
+
+template <typename SampleType>
+void Distortion<SampleType>::processChunk(juce::AudioBuffer<SampleType> &buffer, int startSample, int numSamples, DistortionType type)
+{
+	// The smoothed parameters are advanced once per sample and shared by all channels
+	renderParameterRamps(type, numSamples);
+
+	const int numChannels = juce::jmin(buffer.getNumChannels(), mDryBuffer.getNumChannels());
+
+	// Apply DC filter to the input, the one pole filters channel pairs at once
+	if (mActiveDCFilter == DCFilterMode::DCFilterOnePole)
+		mDCBlocker.process(buffer, startSample, numSamples);
+
+	for (int channel = 0; channel < numChannels; ++channel)
+	{
+		auto *channelData = buffer.getWritePointer(channel, startSample);
+
+		if (mActiveDCFilter == DCFilterMode::DCFilterLinkwitzRiley)
+		{
+			for (int i = 0; i < numSamples; ++i)
+				channelData[i] = mDCFilter.processSample(channel, channelData[i]);
+		}
+
+		juce::FloatVectorOperations::copy(mDryBuffer.getWritePointer(channel), channelData, numSamples);
+
+		// Apply drive gain
+		mDriveRamp.multiply(channelData, numSamples);
+	}
+
+	// Apply distortion
+	if (mActiveOversampler != nullptr)
+	{
+		auto block			  = juce::dsp::AudioBlock<SampleType>(buffer).getSubsetChannelBlock(0, static_cast<size_t>(numChannels)).getSubBlock(static_cast<size_t>(startSample), static_cast<size_t>(numSamples));
+		auto oversampledBlock = mActiveOversampler->processSamplesUp(block);
+
+		for (int channel = 0; channel < numChannels; ++channel)
+			processShaper(oversampledBlock.getChannelPointer(static_cast<size_t>(channel)), static_cast<int>(oversampledBlock.getNumSamples()), type, channel);
+
+		mActiveOversampler->processSamplesDown(block);
+	}
+	else
+	{
+		for (int channel = 0; channel < numChannels; ++channel)
+			processShaper(buffer.getWritePointer(channel, startSample), numSamples, type, channel);
+	}
+
+	// Hard and soft clipping are symmetric and leave a DC free input free of DC
+	if (mActiveDCFilter == DCFilterMode::DCFilterAfterSaturation && type == DistortionType::saturation)
+		mDCBlocker.process(buffer, startSample, numSamples);
+
+	// Delay the dry signal by the latency of the oversampling filters and the ADAA
+	if (mDryDelayActive)
+	{
+		for (int channel = 0; channel < numChannels; ++channel)
+		{
+			auto *dryData = mDryBuffer.getWritePointer(channel);
+
+			for (int i = 0; i < numSamples; ++i)
+			{
+				mDryDelay.pushSample(channel, dryData[i]);
+				dryData[i] = mDryDelay.popSample(channel);
+			}
+		}
+	}
 
 	for (int channel = 0; channel < numChannels; ++channel)
 	{
-		auto *channelData = buffer.getWritePointer(channel);
+		auto	   *channelData = buffer.getWritePointer(channel, startSample);
+		const auto *dryData		= mDryBuffer.getReadPointer(channel);
+
+		// Mix dry and wet signals : dry + mix * (wet - dry)
+		juce::FloatVectorOperations::subtract(channelData, dryData, numSamples);
+		mMixRamp.multiply(channelData, numSamples);
+		juce::FloatVectorOperations::add(channelData, dryData, numSamples);
+
+		// Apply output gain
+		mOutputRamp.multiply(channelData, numSamples);
+	}
+}
+
+
+template <typename SampleType>
+void Distortion<SampleType>::processShaper(SampleType *data, int numSamples, DistortionType type, int channel)
+{
+	if (mActiveAntialiasing != AntialiasingMode::AntialiasingOff)
+	{
+		auto &state = mAntiderivativeStates[static_cast<size_t>(channel)];
+
+		switch (type)
+		{
+		case DistortionType::hardClipping: processAntiderivativeShaper<HardClipCurve>(data, numSamples, state); break;
+		case DistortionType::softClipping: processAntiderivativeShaper<SoftClipCurve>(data, numSamples, state); break;
+		case DistortionType::saturation: processAntiderivativeShaper<SaturationCurve>(data, numSamples, state); break;
+		default: break;
+		}
+
+		return;
+	}
 
+	const bool fastMath = this->getMathPrecision() == MathPrecision::PrecisionFast;
+
+	switch (type)
+	{
+	case DistortionType::hardClipping: processHardClippingBlock(data, numSamples); break;
+	case DistortionType::softClipping:
+	{
+		if (fastMath)
+			processSoftClippingBlock<FastMath::Fast>(data, numSamples);
+		else
+			processSoftClippingBlock<FastMath::Exact>(data, numSamples);
+		break;
+	}
+	case DistortionType::saturation:
+	{
+		if (fastMath)
+			processSaturationBlock<FastMath::Fast>(data, numSamples);
+		else
+			processSaturationBlock<FastMath::Exact>(data, numSamples);
+		break;
+	}
+	default: break;
+	}
+}
+
+
+template <typename SampleType>
+template <typename Curve>
+void Distortion<SampleType>::processAntiderivativeShaper(SampleType *data, int numSamples, AntiderivativeState &state)
+{
+	if (mActiveAntialiasing == AntialiasingMode::FirstOrderADAA)
+	{
+		// y[n] = (F1(x[n]) - F1(x[n-1])) / (x[n] - x[n-1])
 		for (int i = 0; i < numSamples; ++i)
 		{
-			// Apply DC filter
-			channelData[i] = mDCFilter.processSample(channel, channelData[i]);
+			const double x	= static_cast<double>(data[i]);
+			const double ad1 = Curve::F1(x);
+			const double dx	= x - state.x1;
+
+			const double y	= std::abs(dx) < antiderivativeTolerance ? Curve::f(0.5 * (x + state.x1)) : (ad1 - state.ad1) / dx;
 
-			// Apply distortion
-			channelData[i] = processSample(channelData[i]);
+			state.x1		= x;
+			state.ad1		= ad1;
+			data[i]			= static_cast<SampleType>(y);
 		}
+
+		return;
+	}
+
+	// y[n] = 2 / (x[n] - x[n-2]) * (D1(x[n], x[n-1]) - D1(x[n-1], x[n-2])), D1 being the divided difference of F2
+	for (int i = 0; i < numSamples; ++i)
+	{
+		const double x	 = static_cast<double>(data[i]);
+		const double ad2 = Curve::F2(x);
+		const double dx1 = x - state.x1;
+		const double d1	 = std::abs(dx1) < antiderivativeTolerance ? Curve::F1(0.5 * (x + state.x1)) : (ad2 - state.ad2) / dx1;
+		const double dx2 = x - state.x2;
+
+		double		 y	 = 0.0;
+
+		if (std::abs(dx2) >= antiderivativeTolerance)
+		{
+			y = 2.0 * (d1 - state.d1) / dx2;
+		}
+		else
+		{
+			// Ill-conditioned, x[n] and x[n-2] (almost) coincide
+			const double xBar  = 0.5 * (x + state.x2);
+			const double delta = xBar - state.x1;
+
+			if (std::abs(delta) < antiderivativeTolerance)
+				y = Curve::f(0.5 * (xBar + state.x1));
+			else
+				y = 2.0 / delta * (Curve::F1(xBar) + (state.ad2 - Curve::F2(xBar)) / delta);
+		}
+
+		state.x2  = state.x1;
+		state.x1  = x;
+		state.ad2 = ad2;
+		state.d1  = d1;
+		data[i]	  = static_cast<SampleType>(y);
+	}
+}
+
+
+template <typename SampleType>
+void Distortion<SampleType>::updateProcessingSettings()
+{
+	auto	  *oversampler  = getOversampler(mOversamplingFactor.load(), mOversamplingFilter.load());
+	const auto antialiasing = mAntialiasingMode.load();
+	const auto dcFilter		= mDCFilterMode.load();
+
+	// The filters start from silence when they are switched in
+	if (dcFilter != mActiveDCFilter)
+	{
+		mDCFilter.reset();
+		mDCBlocker.reset();
+		mActiveDCFilter = dcFilter;
+	}
+
+	if (oversampler == mActiveOversampler && antialiasing == mActiveAntialiasing)
+		return;
+
+	// Switching only selects one of the prepared oversamplers, nothing is allocated here
+	if (oversampler != mActiveOversampler && oversampler != nullptr)
+		oversampler->reset();
+
+	mActiveOversampler	= oversampler;
+	mActiveAntialiasing = antialiasing;
+
+	std::fill(mAntiderivativeStates.begin(), mAntiderivativeStates.end(), AntiderivativeState{});
+
+	const float latency = getLatencyForSettings(mOversamplingFactor.load(), mOversamplingFilter.load(), antialiasing);
+
+	mDryDelayActive		= latency > 0.0f;
+	mDryDelay.reset();
+	mDryDelay.setDelay(static_cast<SampleType>(latency));
+}
+
+
+template <typename SampleType>
+juce::dsp::Oversampling<SampleType> *Distortion<SampleType>::getOversampler(OversamplingFactor factor, OversamplingFilter filter) const
+{
+	if (factor == OversamplingFactor::NoOversampling)
+		return nullptr;
+
+	const auto &oversamplers = (filter == OversamplingFilter::LinearPhaseFIR) ? mFIROversamplers : mIIROversamplers;
+
+	return oversamplers[static_cast<size_t>(factor) - 1].get();
+}
+
+
+template <typename SampleType>
+void Distortion<SampleType>::renderParameterRamps(DistortionType type, int numSamples)
+{
+	// Saturation maps the drive range (0..24 dB) to 0..6 dB
+	const float driveScale = (type == DistortionType::saturation) ? 0.25f : 1.0f;
+
+	// Constant gains are converted once, ramps per sample with the selected precision
+	const bool	fastMath   = this->getMathPrecision() == MathPrecision::PrecisionFast;
+
+	auto		toGain	   = [fastMath](float decibels) { return fastMath ? FastMath::dbToGain(decibels) : juce::Decibels::decibelsToGain(decibels); };
+
+	mDriveRamp.process(mDrive, numSamples, [&toGain, driveScale](float decibels) { return toGain(decibels * driveScale); });
+	mMixRamp.process(mMix, numSamples);
+	mOutputRamp.process(mOutput, numSamples, toGain);
+}
+
+
+template <typename SampleType>
+void Distortion<SampleType>::skipParameterRamps(int numSamples)
+{
+	mDrive.skip(numSamples);
+	mMix.skip(numSamples);
+	mOutput.skip(numSamples);
+}
+
+
+template <typename SampleType>
+void Distortion<SampleType>::processHardClippingBlock(SampleType *data, int numSamples)
+{
+	juce::FloatVectorOperations::clip(data, data, SampleType(-0.99), SampleType(0.99), numSamples);
+}
+
+
+template <typename SampleType>
+template <typename Math>
+void Distortion<SampleType>::processSoftClippingBlock(SampleType *data, int numSamples)
+{
+	for (int i = 0; i < numSamples; ++i)
+		data[i] = softClip<Math>(data[i]);
+}
+
+
+template <typename SampleType>
+template <typename Math>
+void Distortion<SampleType>::processSaturationBlock(SampleType *data, int numSamples)
+{
+	constexpr auto pi = juce::MathConstants<SampleType>::pi;
+
+	// saturate() without its branch: every function is evaluated once and the halves of the curve are picked by
+	// selects, which the compiler turns into blends so the loop vectorises. The sine term is 0 for positive inputs.
+	for (int i = 0; i < numSamples; ++i)
+	{
+		const SampleType x		  = data[i];
+		const SampleType negative = x < SampleType(0) ? x : SampleType(0);
+		const SampleType sinhX	  = Math::sinh(negative);
+
+		data[i]					  = Math::tanh(x < SampleType(0) ? sinhX : x) - SampleType(0.2) * negative * Math::sin(pi * negative);
 	}
 }
 
@@ -75,6 +618,16 @@ void Distortion<SampleType>::reset()
 	mOutput.setTargetValue(0.0f);
 
 	mDCFilter.reset();
+	mDCBlocker.reset();
+
+	if (mActiveOversampler != nullptr)
+		mActiveOversampler->reset();
+
+	std::fill(mAntiderivativeStates.begin(), mAntiderivativeStates.end(), AntiderivativeState{});
+
+	mDryDelay.reset();
+
+	this->resetSilenceDetector();
 }
 
 
@@ -128,30 +681,72 @@ SampleType Distortion<SampleType>::processSample(SampleType input) noexcept
 
 
 template <typename SampleType>
-void Distortion<SampleType>::setParameter(const std::string &name, float value)
+constexpr ParameterSetters<Distortion<SampleType>> Distortion<SampleType>::createParameterSetters()
 {
-	if (name == paramDistortionDrive)
-		setDrive(value);
-	else if (name == paramMixDistortion)
-		setMix(value);
-	else if (name == paramOutput)
-		setOutput(value);
-	else if (name == paramDistortionType)
-		setCurrentDistortionType(static_cast<DistortionType>(static_cast<int>(value)));
+	ParameterSetters<Distortion> setters{};
+
+	setters[toIndex(ParamId::DistortionDrive)]	= [](Distortion &effect, ParamId, float value) { effect.setDrive(value); };
+	setters[toIndex(ParamId::DistortionMix)]	= [](Distortion &effect, ParamId, float value) { effect.setMix(value); };
+	setters[toIndex(ParamId::DistortionOutput)] = [](Distortion &effect, ParamId, float value) { effect.setOutput(value); };
+
+	// Choice indices start at 0, these enums at 1
+	setters[toIndex(ParamId::DistortionType)]	= [](Distortion &effect, ParamId, float value)
+	{ effect.setCurrentDistortionType(static_cast<DistortionType>(static_cast<int>(value) + DistortionType::hardClipping)); };
+	setters[toIndex(ParamId::DistortionOversamplingFilter)] = [](Distortion &effect, ParamId, float value)
+	{ effect.setOversamplingFilter(static_cast<OversamplingFilter>(static_cast<int>(value) + OversamplingFilter::PolyphaseIIR)); };
+
+	setters[toIndex(ParamId::DistortionOversampling)] = [](Distortion &effect, ParamId, float value)
+	{ effect.setOversamplingFactor(static_cast<OversamplingFactor>(static_cast<int>(value))); };
+	setters[toIndex(ParamId::DistortionAntialiasing)] = [](Distortion &effect, ParamId, float value)
+	{ effect.setAntialiasingMode(static_cast<AntialiasingMode>(static_cast<int>(value))); };
+	setters[toIndex(ParamId::DistortionDCFilter)] = [](Distortion &effect, ParamId, float value)
+	{ effect.setDCFilterMode(static_cast<DCFilterMode>(static_cast<int>(value))); };
+	setters[toIndex(ParamId::MathPrecision)] = [](Distortion &effect, ParamId, float value) { effect.setMathPrecision(static_cast<MathPrecision>(static_cast<int>(value))); };
+
+	return setters;
 }
 
 
 template <typename SampleType>
-float Distortion<SampleType>::getParameter(const std::string &name) const
+constexpr ParameterGetters<Distortion<SampleType>> Distortion<SampleType>::createParameterGetters()
 {
-	if (name == paramDistortionDrive)
-		return mDrive.getCurrentValue();
-	else if (name == paramMixDistortion)
-		return mMix.getCurrentValue();
-	else if (name == paramOutput)
-		return mOutput.getCurrentValue();
-	else if (name == paramDistortionType)
-		return static_cast<float>(static_cast<int>(getCurrentDistortionType()));
+	ParameterGetters<Distortion> getters{};
+
+	getters[toIndex(ParamId::DistortionDrive)]	= [](const Distortion &effect, ParamId) { return effect.mDrive.getTargetValue(); };
+	getters[toIndex(ParamId::DistortionMix)]	= [](const Distortion &effect, ParamId) { return effect.mMix.getTargetValue(); };
+	getters[toIndex(ParamId::DistortionOutput)] = [](const Distortion &effect, ParamId) { return effect.mOutput.getTargetValue(); };
+
+	getters[toIndex(ParamId::DistortionType)]	= [](const Distortion &effect, ParamId)
+	{ return static_cast<float>(effect.getCurrentDistortionType() - DistortionType::hardClipping); };
+	getters[toIndex(ParamId::DistortionOversamplingFilter)] = [](const Distortion &effect, ParamId)
+	{ return static_cast<float>(effect.getOversamplingFilter() - OversamplingFilter::PolyphaseIIR); };
+
+	getters[toIndex(ParamId::DistortionOversampling)] = [](const Distortion &effect, ParamId) { return static_cast<float>(effect.getOversamplingFactor()); };
+	getters[toIndex(ParamId::DistortionAntialiasing)] = [](const Distortion &effect, ParamId) { return static_cast<float>(effect.getAntialiasingMode()); };
+	getters[toIndex(ParamId::DistortionDCFilter)]	  = [](const Distortion &effect, ParamId) { return static_cast<float>(effect.getDCFilterMode()); };
+	getters[toIndex(ParamId::MathPrecision)]		  = [](const Distortion &effect, ParamId) { return static_cast<float>(effect.getMathPrecision()); };
+
+	return getters;
+}
+
+
+template <typename SampleType>
+void Distortion<SampleType>::setParameter(ParamId id, float value)
+{
+	static constexpr auto setters = createParameterSetters();
+
+	if (const auto setter = setters[toIndex(id)])
+		setter(*this, id, value);
+}
+
+
+template <typename SampleType>
+float Distortion<SampleType>::getParameter(ParamId id) const
+{
+	static constexpr auto getters = createParameterGetters();
+
+	if (const auto getter = getters[toIndex(id)])
+		return getter(*this, id);
 
 	return 0.0f;
 }
@@ -174,20 +769,86 @@ void Distortion<SampleType>::setCurrentDistortionType(const DistortionType newTy
 }
 
 
+template <typename SampleType>
+void Distortion<SampleType>::setOversamplingFactor(OversamplingFactor newFactor)
+{
+	mOversamplingFactor.store(newFactor);
+}
+
+
+template <typename SampleType>
+void Distortion<SampleType>::setOversamplingFilter(OversamplingFilter newFilter)
+{
+	mOversamplingFilter.store(newFilter);
+}
+
+
+template <typename SampleType>
+void Distortion<SampleType>::setAntialiasingMode(AntialiasingMode newMode)
+{
+	mAntialiasingMode.store(newMode);
+}
+
+
+template <typename SampleType>
+void Distortion<SampleType>::setDCFilterMode(DCFilterMode newMode)
+{
+	mDCFilterMode.store(newMode);
+}
+
+
+template <typename SampleType>
+float Distortion<SampleType>::getLatencyInSamples() const
+{
+	return getLatencyForSettings(getOversamplingFactor(), getOversamplingFilter(), getAntialiasingMode());
+}
+
+
+template <typename SampleType>
+double Distortion<SampleType>::getTailLengthSeconds() const
+{
+	const double latencySeconds = static_cast<double>(getLatencyInSamples()) / this->getSampleRate();
+
+	if (getDCFilterMode() == DCFilterMode::DCFilterLinkwitzRiley)
+		return latencySeconds + dcFilterTailSeconds;
+
+	return latencySeconds + DCBlocker<SampleType>::getTailLengthSeconds(DCBlocker<SampleType>::defaultCutoff, SilenceDetector<SampleType>::threshold);
+}
+
+
+template <typename SampleType>
+float Distortion<SampleType>::getLatencyForSettings(OversamplingFactor factor, OversamplingFilter filter, AntialiasingMode mode) const
+{
+	float latency			= 0.0f;
+	float oversamplingRatio = 1.0f;
+
+	if (auto *oversampler = getOversampler(factor, filter))
+	{
+		latency			  = static_cast<float>(oversampler->getLatencyInSamples());
+		oversamplingRatio = static_cast<float>(oversampler->getOversamplingFactor());
+	}
+
+	// First order ADAA delays by half a sample, second order by one sample at the waveshaper rate
+	latency += 0.5f * static_cast<float>(mode) / oversamplingRatio;
+
+	return latency;
+}
+
+
 template <typename SampleType>
 SampleType Distortion<SampleType>::processSoftClipping(SampleType inputSample)
 {
 	// Get the next values once per sample
-	auto  driveValue  = mDrive.getNextValue();
-	auto  mixValue	  = mMix.getNextValue();
-	auto  outputValue = mOutput.getNextValue();
+	auto	   driveValue  = mDrive.getNextValue();
+	auto	   mixValue	   = mMix.getNextValue();
+	auto	   outputValue = mOutput.getNextValue();
 
-	float wetSignal	  = inputSample * juce::Decibels::decibelsToGain(mDrive.getNextValue());
+	SampleType wetSignal   = inputSample * juce::Decibels::decibelsToGain(driveValue);
 
 	// Apply distortion (arctangent function)
-	wetSignal		  = mSoftClipperCoefficient * std::atan(wetSignal);
+	wetSignal			   = softClip<FastMath::Exact>(wetSignal);
 
-	auto mix		  = (1.0 - mixValue) * inputSample + wetSignal * mixValue;
+	auto mix			   = (1.0 - mixValue) * inputSample + wetSignal * mixValue;
 
 	return mix * juce::Decibels::decibelsToGain(outputValue);
 }
@@ -206,13 +867,10 @@ SampleType Distortion<SampleType>::processHardClipping(SampleType inputSample)
 	SampleType wetSignal   = inputSample * gain;
 
 	// Hard clipping
-	if (std::abs(wetSignal) > 0.99)
-	{
-		wetSignal *= 0.99 / std::abs(wetSignal);
-	}
+	wetSignal			   = hardClip(wetSignal);
 
 	// Mix dry and wet signals
-	auto mix = (1.0 - mixValue) * inputSample + wetSignal * mixValue;
+	auto mix			   = (1.0 - mixValue) * inputSample + wetSignal * mixValue;
 
 	// Apply output gain
 	return mix * juce::Decibels::decibelsToGain(outputValue);
@@ -223,29 +881,50 @@ template <typename SampleType>
 SampleType Distortion<SampleType>::processSaturation(SampleType inputSample)
 {
 	// Get the next values once per sample
-	auto  driveValue  = mDrive.getNextValue();
-	auto  mixValue	  = mMix.getNextValue();
-	auto  outputValue = mOutput.getNextValue();
+	auto	   driveValue  = mDrive.getNextValue();
+	auto	   mixValue	   = mMix.getNextValue();
+	auto	   outputValue = mOutput.getNextValue();
 
-	auto  drive		  = juce::jmap(driveValue, 0.0f, 24.0f, 0.0f, 6.0f);
+	auto	   drive	   = juce::jmap(driveValue, 0.0f, 24.0f, 0.0f, 6.0f);
 
-	float wetSignal	  = inputSample * juce::Decibels::decibelsToGain(drive);
+	SampleType wetSignal   = inputSample * juce::Decibels::decibelsToGain(drive);
 
-	if (wetSignal >= 0.0)
-	{
-		wetSignal = std::tanh(wetSignal);
-	}
-	else
-	{
-		wetSignal = std::tanh(std::sinh(wetSignal)) - 0.2 * wetSignal * std::sin(juce::MathConstants<float>::pi * wetSignal);
-	}
+	wetSignal			   = saturate<FastMath::Exact>(wetSignal);
 
-	auto mix = (1.0 - mixValue) * inputSample + wetSignal * mixValue;
+	auto mix			   = (1.0 - mixValue) * inputSample + wetSignal * mixValue;
 
 	return mix * juce::Decibels::decibelsToGain(outputValue);
 }
 
 
+template <typename SampleType>
+SampleType Distortion<SampleType>::hardClip(SampleType x) noexcept
+{
+	return juce::jlimit(SampleType(-0.99), SampleType(0.99), x);
+}
+
+
+template <typename SampleType>
+template <typename Math>
+SampleType Distortion<SampleType>::softClip(SampleType x) noexcept
+{
+	constexpr auto softClipperCoefficient = SampleType(2) / juce::MathConstants<SampleType>::pi;
+
+	return softClipperCoefficient * Math::atan(x);
+}
+
+
+template <typename SampleType>
+template <typename Math>
+SampleType Distortion<SampleType>::saturate(SampleType x) noexcept
+{
+	if (x >= SampleType(0))
+		return Math::tanh(x);
+
+	return Math::tanh(Math::sinh(x)) - SampleType(0.2) * x * Math::sin(juce::MathConstants<SampleType>::pi * x);
+}
+
+
 // Declare Distortion Template Classes that may be used
 template class Distortion<float>;
 template class Distortion<double>;
@@ -11,6 +11,9 @@
 
 #include "EffectBase.h"
 #include "Parameters.h"
+#include "FastMath.h"
+#include "BlockSmoother.h"
+#include "DCBlocker.h"
 
 template <typename SampleType>
 class Distortion : public EffectBase<SampleType>
@@ -24,10 +27,12 @@ public:
 	void		   reset() override;
 	EffectType	   getEffectType() const override { return EffectType::Distortion; }
 
+	// Per sample reference path, always uses the exact math functions
 	SampleType	   processSample(SampleType input) noexcept;
 
-	void		   setParameter(const std::string &name, float value) override;
-	float		   getParameter(const std::string &name) const override;
+	// Takes the plain value of the parameter, choice parameters as their index
+	void		   setParameter(ParamId id, float value) override;
+	float		   getParameter(ParamId id) const override;
 
 	void		   setDrive(float newDrive);
 	void		   setMix(float newMix);
@@ -36,16 +41,98 @@ public:
 	DistortionType getCurrentDistortionType() const;
 	void		   setCurrentDistortionType(const DistortionType newType);
 
+	// Oversampling of the waveshaper stage, all factors are allocated in prepare()
+	void		   setOversamplingFactor(OversamplingFactor newFactor);
+	void		   setOversamplingFilter(OversamplingFilter newFilter);
+
+	OversamplingFactor getOversamplingFactor() const { return mOversamplingFactor.load(); }
+	OversamplingFilter getOversamplingFilter() const { return mOversamplingFilter.load(); }
+
+	// Antiderivative anti-aliasing of the waveshaper, a cheaper alternative to oversampling
+	void			   setAntialiasingMode(AntialiasingMode newMode);
+	AntialiasingMode   getAntialiasingMode() const { return mAntialiasingMode.load(); }
+
+	// Highpass removing the DC offset, the one pole filters cost a fraction of the Linkwitz-Riley
+	void			   setDCFilterMode(DCFilterMode newMode);
+	DCFilterMode	   getDCFilterMode() const { return mDCFilterMode.load(); }
+
+	// Latency of the selected oversampling and anti-aliasing settings in samples at the host rate
+	float			   getLatencyInSamples() const override;
+
+	// Of the slowest oversampling filter plus the second order ADAA
+	float			   getMaxLatencyInSamples() const override { return mMaxLatencyInSamples; }
+
+	// The latency plus the decay of the selected DC filter
+	double			   getTailLengthSeconds() const override;
+
 
 private:
+	static constexpr ParameterSetters<Distortion> createParameterSetters();
+	static constexpr ParameterGetters<Distortion> createParameterGetters();
+
 	SampleType							  processSoftClipping(SampleType inputSample);
 
 	SampleType							  processHardClipping(SampleType inputSample);
 
 	SampleType							  processSaturation(SampleType inputSample);
 
+	// Static transfer curves shared by the per-sample and the block path, Math is FastMath::Exact or FastMath::Fast
+	static SampleType					  hardClip(SampleType x) noexcept;
+
+	template <typename Math>
+	static SampleType					  softClip(SampleType x) noexcept;
+
+	template <typename Math>
+	static SampleType					  saturate(SampleType x) noexcept;
+
+	// Block processing
+	void								  processChunk(juce::AudioBuffer<SampleType> &buffer, int startSample, int numSamples, DistortionType type);
+
+	// State of the antiderivative anti-aliasing for one channel
+	struct AntiderivativeState
+	{
+		double x1{0.0};	 // Previous input
+		double x2{0.0};	 // Input before the previous one
+		double ad1{0.0}; // First antiderivative at x1
+		double ad2{0.0}; // Second antiderivative at x1
+		double d1{0.0};	 // Divided difference of the second antiderivative between x1 and x2
+	};
+
+	void								  processShaper(SampleType *data, int numSamples, DistortionType type, int channel);
+
+	template <typename Curve>
+	void								  processAntiderivativeShaper(SampleType *data, int numSamples, AntiderivativeState &state);
+
+	void								  updateProcessingSettings();
+
+	juce::dsp::Oversampling<SampleType>	 *getOversampler(OversamplingFactor factor, OversamplingFilter filter) const;
+
+	float								  getLatencyForSettings(OversamplingFactor factor, OversamplingFilter filter, AntialiasingMode mode) const;
+
+	void								  renderParameterRamps(DistortionType type, int numSamples);
+
+	// Moves the parameter ramps on by a skipped block, so they keep their timing through silence
+	void								  skipParameterRamps(int numSamples);
 
-	juce::dsp::LinkwitzRileyFilter<float> mDCFilter;
+	void								  processHardClippingBlock(SampleType *data, int numSamples);
+
+	template <typename Math>
+	void								  processSoftClippingBlock(SampleType *data, int numSamples);
+
+	template <typename Math>
+	void								  processSaturationBlock(SampleType *data, int numSamples);
+
+
+	// The 10 Hz Linkwitz-Riley highpass rings for about 0.4 s until a full scale step decayed below the silence threshold
+	static constexpr double				  dcFilterTailSeconds = 0.4;
+
+	juce::dsp::LinkwitzRileyFilter<SampleType> mDCFilter;
+
+	DCBlocker<SampleType>				  mDCBlocker;
+
+	std::atomic<DCFilterMode>			  mDCFilterMode{DCFilterMode::DCFilterLinkwitzRiley};
+
+	DCFilterMode						  mActiveDCFilter{DCFilterMode::DCFilterLinkwitzRiley};
 
 	juce::SmoothedValue<float>			  mDrive;
 	juce::SmoothedValue<float>			  mMix;
@@ -53,5 +140,36 @@ private:
 
 	std::atomic<DistortionType>			  mDistortionType;
 
-	const float							  mSoftClipperCoefficient = (2.0f / juce::MathConstants<float>::pi);
+	// Per block scratch memory, allocated in prepare()
+	BlockSmoother<SampleType>			  mDriveRamp; // As gain
+	BlockSmoother<SampleType>			  mMixRamp;
+	BlockSmoother<SampleType>			  mOutputRamp; // As gain
+	juce::AudioBuffer<SampleType>		  mDryBuffer;
+
+	// Oversampling
+	static constexpr int				  numOversamplingStages = 3; // 2x, 4x and 8x
+
+	using OversamplerArray				  = std::array<std::unique_ptr<juce::dsp::Oversampling<SampleType>>, numOversamplingStages>;
+
+	OversamplerArray					  mIIROversamplers;
+	OversamplerArray					  mFIROversamplers;
+
+	juce::dsp::Oversampling<SampleType>	 *mActiveOversampler{nullptr};
+
+	std::atomic<OversamplingFactor>		  mOversamplingFactor{OversamplingFactor::NoOversampling};
+	std::atomic<OversamplingFilter>		  mOversamplingFilter{OversamplingFilter::PolyphaseIIR};
+
+	// Antiderivative anti-aliasing
+	std::vector<AntiderivativeState>	  mAntiderivativeStates;
+
+	std::atomic<AntialiasingMode>		  mAntialiasingMode{AntialiasingMode::AntialiasingOff};
+
+	AntialiasingMode					  mActiveAntialiasing{AntialiasingMode::AntialiasingOff};
+
+	// Keeps the dry signal aligned with the delayed wet signal
+	juce::dsp::DelayLine<SampleType, juce::dsp::DelayLineInterpolationTypes::Linear> mDryDelay;
+
+	bool								  mDryDelayActive{false};
+
+	float								  mMaxLatencyInSamples{0.0f};
 };
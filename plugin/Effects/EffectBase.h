@@ -11,7 +11,11 @@
 
 #include <juce_audio_basics/juce_audio_basics.h>
 #include <juce_dsp/juce_dsp.h>
-#include <string>
+#include <array>
+
+#include "Parameters.h"
+#include "RealtimeSafety.h"
+#include "SilenceDetector.h"
 
 
 enum class EffectType
@@ -23,6 +27,14 @@ enum class EffectType
 };
 
 
+// Dispatch tables from ParamId to the members of an effect, IDs the effect does not use stay nullptr
+template <typename Effect>
+using ParameterSetters = std::array<void (*)(Effect &, ParamId, float), numParameters>;
+
+template <typename Effect>
+using ParameterGetters = std::array<float (*)(const Effect &, ParamId), numParameters>;
+
+
 template <typename SampleType>
 class EffectBase
 {
@@ -38,18 +50,47 @@ public:
 	// Effect identification
 	virtual EffectType getEffectType() const						  = 0;
 
-	// Parameter interface for generic parameter handling
-	virtual void	   setParameter(const std::string &name, float value) {}
-	virtual float	   getParameter(const std::string &name) const { return 0.0f; }
+	// Parameter interface for generic parameter handling, IDs of other effects are ignored
+	virtual void	   setParameter(ParamId id, float value) { juce::ignoreUnused(id, value); }
+	virtual float	   getParameter(ParamId id) const
+	{
+		juce::ignoreUnused(id);
+		return 0.0f;
+	}
 
 	// Bypass functionality
 	virtual void	   setBypassed(bool shouldBeBypassed) { mBypassed = shouldBeBypassed; }
 	virtual bool	   isBypassed() const { return mBypassed; }
 
+	// Selects between the standard library and the FastMath approximations in the processing loops
+	virtual void	   setMathPrecision(MathPrecision newPrecision) { mMathPrecision.store(newPrecision); }
+	MathPrecision	   getMathPrecision() const { return mMathPrecision.load(); }
+
+	// Time the output keeps sounding after the input fell silent, infinite if it never decays. Any thread
+	virtual double	   getTailLengthSeconds() const { return 0.0; }
+
+	// Delay of the output against the input in samples at the host rate, the parallel chain aligns its branches with it
+	virtual float	   getLatencyInSamples() const { return 0.0f; }
+
+	// Largest latency any setting of the effect reaches, valid after prepare()
+	virtual float	   getMaxLatencyInSamples() const { return getLatencyInSamples(); }
+
+	// True once the input was silent for longer than the tail, process() then skips silent blocks (audio thread)
+	bool			   isIdle() const noexcept { return mSilenceDetector.isIdle(getTailLengthSeconds() * mSampleRate); }
+
 protected:
 	// Helper bypass processing
 	void   processBypassed(juce::AudioBuffer<SampleType> &buffer) { juce::ignoreUnused(buffer); }
 
+	// At the top of process(): true if the block is silent and the tail has decayed, the buffer is left untouched then
+	bool   skipSilentBlock(const juce::AudioBuffer<SampleType> &buffer) noexcept
+	{
+		return mSilenceDetector.process(buffer, getTailLengthSeconds() * mSampleRate);
+	}
+
+	// From reset(), the cleared state has no tail
+	void   resetSilenceDetector() noexcept { mSilenceDetector.reset(); }
+
 	double getSampleRate() const { return mSampleRate; }
 	void   setSampleRate(double sampleRate) { mSampleRate = sampleRate; }
 
@@ -60,10 +101,12 @@ protected:
 	void   setMaxBlockSize(const int maxBlockSize) { mMaxBlockSize = maxBlockSize; }
 
 private:
-	bool   mBypassed{false};
-	double mSampleRate{48000.0};
-	int	   mNumChannels{0};
-	int	   mMaxBlockSize{0};
+	bool					   mBypassed{false};
+	std::atomic<MathPrecision> mMathPrecision{MathPrecision::PrecisionExact};
+	double					   mSampleRate{48000.0};
+	int						   mNumChannels{0};
+	int						   mMaxBlockSize{0};
+	SilenceDetector<SampleType> mSilenceDetector;
 };
 
 // Explicit template instantiations
@@ -0,0 +1,510 @@
+/*
+  ==============================================================================
+
+	Module			EffectChain
+	Description		Processes the effects in a user defined order with per effect bypass
+
+  ==============================================================================
+*/
+
+#include "EffectChain.h"
+
+#include <chrono>
+#include <cmath>
+
+
+template <typename SampleType>
+EffectChain<SampleType>::EffectChain() : mPlan(encodeOrder({}))
+{
+}
+
+
+template <typename SampleType>
+void EffectChain<SampleType>::addEffect(EffectBase<SampleType> &effect)
+{
+	jassert(mNumEffects < maxNumEffects); // Increase maxNumEffects!
+
+	if (mNumEffects >= maxNumEffects)
+		return;
+
+	const int effectIndex = mNumEffects++;
+	mEffects[effectIndex] = &effect;
+
+	updatePlan(
+		[effectIndex](uint64_t plan)
+		{
+			for (int position = 0; position < maxNumEffects; ++position)
+			{
+				if (decodePosition(plan, position) < 0)
+				{
+					const int shift = position * bitsPerPosition;
+					return (plan & ~(positionMask << shift)) | (static_cast<uint64_t>(effectIndex) << shift);
+				}
+			}
+
+			return plan;
+		});
+}
+
+
+template <typename SampleType>
+void EffectChain<SampleType>::setOrder(std::span<const int> order)
+{
+	jassert(order.size() <= static_cast<size_t>(maxNumEffects));
+
+	uint16_t usedEffects = 0;
+
+	for (const int effectIndex : order)
+	{
+		// Every registered effect may appear once
+		const bool isValid = effectIndex >= 0 && effectIndex < mNumEffects && (usedEffects & (1u << effectIndex)) == 0;
+
+		jassert(isValid);
+
+		if (!isValid)
+			return;
+
+		usedEffects |= static_cast<uint16_t>(1u << effectIndex);
+	}
+
+	const uint64_t newOrder = encodeOrder(order);
+
+	updatePlan([newOrder](uint64_t plan) { return (plan & ~((uint64_t(1) << bypassShift) - 1)) | newOrder; });
+}
+
+
+template <typename SampleType>
+int EffectChain<SampleType>::getEffectAt(int position) const
+{
+	if (position < 0 || position >= maxNumEffects)
+		return -1;
+
+	return decodePosition(mPlan.load(std::memory_order_acquire), position);
+}
+
+
+template <typename SampleType>
+void EffectChain<SampleType>::setBypassed(int effectIndex, bool shouldBeBypassed)
+{
+	jassert(effectIndex >= 0 && effectIndex < maxNumEffects);
+
+	if (effectIndex < 0 || effectIndex >= maxNumEffects)
+		return;
+
+	const uint64_t bypassBit = uint64_t(1) << (bypassShift + effectIndex);
+
+	updatePlan([bypassBit, shouldBeBypassed](uint64_t plan) { return shouldBeBypassed ? (plan | bypassBit) : (plan & ~bypassBit); });
+}
+
+
+template <typename SampleType>
+bool EffectChain<SampleType>::isBypassed(int effectIndex) const
+{
+	if (effectIndex < 0 || effectIndex >= maxNumEffects)
+		return false;
+
+	return (mPlan.load(std::memory_order_acquire) >> (bypassShift + effectIndex)) & 1;
+}
+
+
+template <typename SampleType>
+void EffectChain<SampleType>::setRouting(ChainRouting routing)
+{
+	const uint64_t routingBit = uint64_t(1) << routingShift;
+
+	updatePlan([routingBit, routing](uint64_t plan) { return routing == ChainRouting::ParallelRouting ? (plan | routingBit) : (plan & ~routingBit); });
+}
+
+
+template <typename SampleType>
+ChainRouting EffectChain<SampleType>::getRouting() const
+{
+	return ((mPlan.load(std::memory_order_acquire) >> routingShift) & 1) ? ChainRouting::ParallelRouting : ChainRouting::SerialRouting;
+}
+
+
+template <typename SampleType>
+void EffectChain<SampleType>::prepare(int numChannels, int maxBlockSize)
+{
+	// The delay line does not use the rate, only the channels and the block size
+	const juce::dsp::ProcessSpec spec{0.0, static_cast<juce::uint32>(maxBlockSize), static_cast<juce::uint32>(numChannels)};
+
+	// A branch waits at most for the slowest setting of any effect
+	float						 maxLatency = 0.0f;
+
+	for (int effectIndex = 0; effectIndex < mNumEffects; ++effectIndex)
+		maxLatency = juce::jmax(maxLatency, mEffects[effectIndex]->getMaxLatencyInSamples());
+
+	for (int effectIndex = 0; effectIndex < mNumEffects; ++effectIndex)
+	{
+		mBranchBuffers[effectIndex].setSize(numChannels, maxBlockSize);
+		mBranchDelays[effectIndex].setMaximumDelayInSamples(static_cast<int>(std::ceil(maxLatency)) + 2);
+		mBranchDelays[effectIndex].prepare(spec);
+	}
+
+	mBranchAlignments.fill(0.0f);
+	mBranchNumChannels	= numChannels;
+	mBranchMaxBlockSize = maxBlockSize;
+
+	mBranchCosts.fill(0.0);
+	mThreadPoolOverhead = initialThreadPoolOverhead;
+}
+
+
+template <typename SampleType>
+void EffectChain<SampleType>::process(juce::AudioBuffer<SampleType> &buffer)
+{
+	// One load per block, changes during the block take effect in the next one
+	const uint64_t plan = mPlan.load(std::memory_order_acquire);
+
+	mLastBlockThreaded	= false;
+
+	if ((plan >> routingShift) & 1)
+		processParallel(buffer, plan);
+	else
+		processSerial(buffer, plan);
+}
+
+
+template <typename SampleType>
+void EffectChain<SampleType>::processSerial(juce::AudioBuffer<SampleType> &buffer, uint64_t plan)
+{
+	for (int position = 0; position < maxNumEffects; ++position)
+	{
+		const int effectIndex = decodePosition(plan, position);
+
+		if (effectIndex < 0)
+			break;
+
+		if ((plan >> (bypassShift + effectIndex)) & 1)
+			continue;
+
+		ScopedProfilingProbe probe(mTelemetry, effectIndex, buffer.getNumSamples());
+		mEffects[effectIndex]->process(buffer);
+	}
+}
+
+
+template <typename SampleType>
+void EffectChain<SampleType>::processParallel(juce::AudioBuffer<SampleType> &buffer, uint64_t plan)
+{
+	std::array<int, maxNumEffects> branches{};
+	int							   numBranches = 0;
+
+	for (int position = 0; position < maxNumEffects; ++position)
+	{
+		const int effectIndex = decodePosition(plan, position);
+
+		if (effectIndex < 0)
+			break;
+
+		if (((plan >> (bypassShift + effectIndex)) & 1) == 0)
+			branches[numBranches++] = effectIndex;
+	}
+
+	// A single branch needs no copy and no alignment
+	if (numBranches <= 1)
+	{
+		processSerial(buffer, plan);
+		return;
+	}
+
+	jassert(mBranchMaxBlockSize > 0); // Call prepare() before processing the parallel routing!
+	if (mBranchMaxBlockSize == 0)
+		return;
+
+	const auto activeBranches = std::span<const int>(branches.data(), static_cast<size_t>(numBranches));
+
+	// Every branch is delayed to the slowest one, a changed alignment starts from a cleared delay line
+	float	   maxLatency	  = 0.0f;
+
+	for (const int effectIndex : activeBranches)
+		maxLatency = juce::jmax(maxLatency, mEffects[effectIndex]->getLatencyInSamples());
+
+	for (const int effectIndex : activeBranches)
+	{
+		const float alignment = maxLatency - mEffects[effectIndex]->getLatencyInSamples();
+
+		if (alignment != mBranchAlignments[effectIndex])
+		{
+			mBranchAlignments[effectIndex] = alignment;
+			mBranchDelays[effectIndex].reset();
+			mBranchDelays[effectIndex].setDelay(static_cast<SampleType>(alignment));
+		}
+	}
+
+	// Larger blocks than prepared keep the parallel sum, in parts of the prepared size
+	const int numSamples = buffer.getNumSamples();
+
+	for (int startSample = 0; startSample < numSamples; startSample += mBranchMaxBlockSize)
+		processBranches(buffer, activeBranches, startSample, juce::jmin(mBranchMaxBlockSize, numSamples - startSample));
+}
+
+
+template <typename SampleType>
+void EffectChain<SampleType>::processBranches(juce::AudioBuffer<SampleType> &buffer, std::span<const int> branches, int startSample, int numSamples)
+{
+	const int numBranches = static_cast<int>(branches.size());
+
+	auto	  runBranch	  = [this, &buffer, branches, startSample, numSamples](int task) { processBranch(branches[task], buffer, startSample, numSamples); };
+
+	if (shouldUseThreadPool(branches, numSamples))
+	{
+		const auto start = std::chrono::steady_clock::now();
+		mThreadPool->run(numBranches, runBranch);
+		const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		// Whatever exceeds the time of the longest branch (or the even share of all branches) is the cost of the pool
+		double		 longest = 0.0;
+		double		 total	 = 0.0;
+
+		for (const int effectIndex : branches)
+		{
+			longest	 = juce::jmax(longest, mBranchSeconds[effectIndex]);
+			total	+= mBranchSeconds[effectIndex];
+		}
+
+		const int	 numThreads		 = juce::jmin(numBranches, mThreadPool->getNumWorkers() + 1);
+		const double expected		 = juce::jmax(longest, total / numThreads);
+
+		mThreadPoolOverhead			+= costSmoothing * (juce::jmax(0.0, elapsed - expected) - mThreadPoolOverhead);
+		mLastBlockThreaded			 = true;
+	}
+	else
+	{
+		for (int task = 0; task < numBranches; ++task)
+			runBranch(task);
+	}
+
+#if MULTIEFFECT_PROFILING
+	// The workers never touch the telemetry, it has a single producer
+	if (mTelemetry != nullptr && mTelemetry->isBlockSampled())
+	{
+		for (const int effectIndex : branches)
+			mTelemetry->record(effectIndex, mBranchTicks[effectIndex], numSamples);
+	}
+#endif
+
+	// Equal weight, so identical branches keep the level of the input. Channels beyond the prepared ones stay dry
+	const auto gain		   = static_cast<SampleType>(1.0 / numBranches);
+	const int  numChannels = juce::jmin(buffer.getNumChannels(), mBranchNumChannels);
+
+	for (int channel = 0; channel < numChannels; ++channel)
+	{
+		auto *output = buffer.getWritePointer(channel, startSample);
+
+		juce::FloatVectorOperations::multiply(output, mBranchBuffers[branches[0]].getReadPointer(channel), gain, numSamples);
+
+		for (int branch = 1; branch < numBranches; ++branch)
+			juce::FloatVectorOperations::addWithMultiply(output, mBranchBuffers[branches[branch]].getReadPointer(channel), gain, numSamples);
+	}
+}
+
+
+template <typename SampleType>
+void EffectChain<SampleType>::processBranch(int effectIndex, const juce::AudioBuffer<SampleType> &input, int startSample, int numSamples)
+{
+	// The workers of the pool run the branches outside of processBlock(), so every branch opens its own section
+	RealtimeSafety::ScopedRealtimeSection realtimeSection;
+
+	const auto							  start		  = std::chrono::steady_clock::now();
+
+	auto								 &branch	  = mBranchBuffers[effectIndex];
+	const int							  numChannels = juce::jmin(input.getNumChannels(), mBranchNumChannels);
+
+	// Within the prepared size, so no allocation
+	branch.setSize(numChannels, numSamples, false, false, true);
+
+	for (int channel = 0; channel < numChannels; ++channel)
+		branch.copyFrom(channel, 0, input, channel, startSample, numSamples);
+
+#if MULTIEFFECT_PROFILING
+	const bool	   isSampled  = mTelemetry != nullptr && mTelemetry->isBlockSampled();
+	const uint64_t startTicks = isSampled ? ProfilingTelemetry::now() : 0;
+	mEffects[effectIndex]->process(branch);
+
+	if (isSampled)
+		mBranchTicks[effectIndex] = ProfilingTelemetry::now() - startTicks;
+#else
+	mEffects[effectIndex]->process(branch);
+#endif
+
+	alignBranch(effectIndex, branch);
+
+	// Each branch writes its own slots, they are read after all branches are done
+	const double seconds		  = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	mBranchSeconds[effectIndex]	  = seconds;
+	mBranchCosts[effectIndex]	 += costSmoothing * (seconds / numSamples - mBranchCosts[effectIndex]);
+}
+
+
+template <typename SampleType>
+void EffectChain<SampleType>::alignBranch(int effectIndex, juce::AudioBuffer<SampleType> &branch)
+{
+	if (mBranchAlignments[effectIndex] <= 0.0f)
+		return;
+
+	auto &delay = mBranchDelays[effectIndex];
+
+	for (int channel = 0; channel < branch.getNumChannels(); ++channel)
+	{
+		auto *data = branch.getWritePointer(channel);
+
+		for (int i = 0; i < branch.getNumSamples(); ++i)
+		{
+			delay.pushSample(channel, data[i]);
+			data[i] = delay.popSample(channel);
+		}
+	}
+}
+
+
+template <typename SampleType>
+bool EffectChain<SampleType>::shouldUseThreadPool(std::span<const int> branches, int numSamples) const
+{
+	if (mThreadPool == nullptr || mThreadPool->getNumWorkers() == 0)
+		return false;
+
+	if (!mCostModelEnabled.load(std::memory_order_relaxed))
+		return true;
+
+	double longest = 0.0;
+	double serial  = 0.0;
+
+	for (const int effectIndex : branches)
+	{
+		const double seconds  = mBranchCosts[effectIndex] * numSamples;
+		longest				  = juce::jmax(longest, seconds);
+		serial				 += seconds;
+	}
+
+	const int	 numThreads = juce::jmin(static_cast<int>(branches.size()), mThreadPool->getNumWorkers() + 1);
+	const double parallel	= juce::jmax(longest, serial / numThreads) + mThreadPoolOverhead;
+
+	return parallel < serial * requiredParallelSpeedup;
+}
+
+
+template <typename SampleType>
+bool EffectChain<SampleType>::isIdle() const
+{
+	const uint64_t plan = mPlan.load(std::memory_order_acquire);
+
+	for (int position = 0; position < maxNumEffects; ++position)
+	{
+		const int effectIndex = decodePosition(plan, position);
+
+		if (effectIndex < 0)
+			break;
+
+		if (((plan >> (bypassShift + effectIndex)) & 1) == 0 && !mEffects[effectIndex]->isIdle())
+			return false;
+	}
+
+	return true;
+}
+
+
+template <typename SampleType>
+double EffectChain<SampleType>::getTailLengthSeconds() const
+{
+	const uint64_t plan		  = mPlan.load(std::memory_order_acquire);
+	const bool	   isParallel = (plan >> routingShift) & 1;
+
+	double		   tail		  = 0.0;
+
+	for (int position = 0; position < maxNumEffects; ++position)
+	{
+		const int effectIndex = decodePosition(plan, position);
+
+		if (effectIndex < 0)
+			break;
+
+		if ((plan >> (bypassShift + effectIndex)) & 1)
+			continue;
+
+		const double effectTail = mEffects[effectIndex]->getTailLengthSeconds();
+		tail					= isParallel ? juce::jmax(tail, effectTail) : tail + effectTail;
+	}
+
+	return tail;
+}
+
+
+template <typename SampleType>
+float EffectChain<SampleType>::getLatencyInSamples() const
+{
+	const uint64_t plan		  = mPlan.load(std::memory_order_acquire);
+	const bool	   isParallel = (plan >> routingShift) & 1;
+
+	float		   latency	  = 0.0f;
+
+	for (int position = 0; position < maxNumEffects; ++position)
+	{
+		const int effectIndex = decodePosition(plan, position);
+
+		if (effectIndex < 0)
+			break;
+
+		if ((plan >> (bypassShift + effectIndex)) & 1)
+			continue;
+
+		const float effectLatency = mEffects[effectIndex]->getLatencyInSamples();
+		latency					  = isParallel ? juce::jmax(latency, effectLatency) : latency + effectLatency;
+	}
+
+	return latency;
+}
+
+
+template <typename SampleType>
+void EffectChain<SampleType>::reset()
+{
+	for (int effectIndex = 0; effectIndex < mNumEffects; ++effectIndex)
+	{
+		mEffects[effectIndex]->reset();
+		mBranchDelays[effectIndex].reset();
+	}
+}
+
+
+template <typename SampleType>
+constexpr uint64_t EffectChain<SampleType>::encodeOrder(std::span<const int> order) noexcept
+{
+	uint64_t plan = 0;
+
+	for (int position = 0; position < maxNumEffects; ++position)
+	{
+		const uint64_t effectIndex = position < static_cast<int>(order.size()) ? static_cast<uint64_t>(order[position]) : emptyPosition;
+		plan |= effectIndex << (position * bitsPerPosition);
+	}
+
+	return plan;
+}
+
+
+template <typename SampleType>
+constexpr int EffectChain<SampleType>::decodePosition(uint64_t plan, int position) noexcept
+{
+	const uint64_t effectIndex = (plan >> (position * bitsPerPosition)) & positionMask;
+
+	return effectIndex == emptyPosition ? -1 : static_cast<int>(effectIndex);
+}
+
+
+template <typename SampleType>
+template <typename Function>
+void EffectChain<SampleType>::updatePlan(Function &&update)
+{
+	uint64_t plan = mPlan.load(std::memory_order_relaxed);
+
+	// Retries if another thread swapped in a plan in between
+	while (!mPlan.compare_exchange_weak(plan, update(plan), std::memory_order_acq_rel, std::memory_order_relaxed))
+	{
+	}
+}
+
+
+// Explicit template instantiations
+template class EffectChain<float>;
+template class EffectChain<double>;
@@ -0,0 +1,196 @@
+/*
+  ==============================================================================
+
+	Module			EffectChain
+	Description		Processes the effects in a user defined order with per effect bypass
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <tuple>
+
+#include "EffectBase.h"
+#include "RealtimeThreadPool.h"
+#include "ProfilingTelemetry.h"
+
+
+//==============================================================================
+// The effects are registered once with addEffect() and keep their index.
+// Order, bypass and routing are compiled into a single 64 bit plan word:
+//
+//	bits  0 - 31	effect index per position, 4 bits each, emptyPosition ends the chain
+//	bits 32 - 39	bypass flag per effect index
+//	bit  40			parallel routing
+//
+// setOrder(), setBypassed() and setRouting() build a new plan and swap it in
+// with one atomic compare exchange, so they may be called from any thread.
+// process() loads the plan once per block and never locks or allocates, a block
+// is always processed with one consistent order, bypass and routing state.
+//
+// With the parallel routing every effect of the order processes its own copy of
+// the input (a branch) and the branches are summed with equal weight. Every
+// branch is delayed to the latency of the slowest one first, so an oversampled
+// distortion does not comb filter against the other branches. Blocks larger
+// than prepared are summed in parts of the prepared size. The
+// branches are independent and run on the thread pool when the cost model
+// expects a gain: the cost per sample of every branch is measured in each block,
+// the overhead of handing the branches to the pool whenever it is used. Small
+// blocks stay on the audio thread, where the overhead outweighs the work.
+//==============================================================================
+
+template <typename SampleType>
+class EffectChain
+{
+public:
+	EffectChain();
+	~EffectChain() = default;
+
+	static constexpr int maxNumEffects = 8;
+
+	// Message thread, before processing. New effects are appended to the current order
+	void				 addEffect(EffectBase<SampleType> &effect);
+
+	int					 getNumEffects() const noexcept { return mNumEffects; }
+
+	// Effect indices in processing order, effects that are left out are not processed
+	void				 setOrder(std::span<const int> order);
+
+	// Effect index at the position in the current order, -1 past the end of the chain
+	int					 getEffectAt(int position) const;
+
+	void				 setBypassed(int effectIndex, bool shouldBeBypassed);
+	bool				 isBypassed(int effectIndex) const;
+
+	// Serial feeds every effect the output of the previous one, parallel sums the branches
+	void				 setRouting(ChainRouting routing);
+	ChainRouting		 getRouting() const;
+
+	// Message thread, after the effects were prepared. Allocates the branch buffers and alignment delays of the parallel routing
+	void				 prepare(int numChannels, int maxBlockSize);
+
+	// Pool for the parallel branches, without one they run one after the other
+	void				 setThreadPool(RealtimeThreadPool *threadPool) { mThreadPool = threadPool; }
+
+	// Without the cost model the parallel branches are always handed to the thread pool
+	void				 setCostModelEnabled(bool shouldUseCostModel) { mCostModelEnabled.store(shouldUseCostModel); }
+
+	// Receives the time of every effect under its effect index, only used with MULTIEFFECT_PROFILING
+	void				 setTelemetry(ProfilingTelemetry *telemetry) { mTelemetry = telemetry; }
+
+	// True if the branches of the last block ran on the thread pool (audio thread)
+	bool				 wasLastBlockThreaded() const noexcept { return mLastBlockThreaded; }
+
+	// True if every effect of the chain decayed after silent input, a silent block would stay silent (audio thread)
+	bool				 isIdle() const;
+
+	// Serial tails add up, since each effect extends the tail of the ones before it. Parallel takes the longest branch
+	double				 getTailLengthSeconds() const;
+
+	// Serial latencies add up, the parallel branches are aligned to the slowest one
+	float				 getLatencyInSamples() const;
+
+	void				 process(juce::AudioBuffer<SampleType> &buffer);
+
+	void				 reset();
+
+private:
+	void					  processSerial(juce::AudioBuffer<SampleType> &buffer, uint64_t plan);
+
+	void					  processParallel(juce::AudioBuffer<SampleType> &buffer, uint64_t plan);
+
+	// Runs the branches on a part of the block of at most the prepared size and sums them into it
+	void					  processBranches(juce::AudioBuffer<SampleType> &buffer, std::span<const int> branches, int startSample, int numSamples);
+
+	// Copies a part of the input into the buffer of the branch, processes and aligns it and measures the time it took
+	void					  processBranch(int effectIndex, const juce::AudioBuffer<SampleType> &input, int startSample, int numSamples);
+
+	// Delays the branch by the difference of its latency to the slowest branch
+	void					  alignBranch(int effectIndex, juce::AudioBuffer<SampleType> &branch);
+
+	bool					  shouldUseThreadPool(std::span<const int> branches, int numSamples) const;
+
+	static constexpr int	  bitsPerPosition = 4;
+	static constexpr uint64_t positionMask	  = (uint64_t(1) << bitsPerPosition) - 1;
+	static constexpr uint64_t emptyPosition	  = positionMask;
+	static constexpr int	  bypassShift	  = maxNumEffects * bitsPerPosition;
+	static constexpr int	  routingShift	  = bypassShift + maxNumEffects;
+
+	// Smoothing of the measured costs, and the share of the serial time the pool has to save at least
+	static constexpr double	  costSmoothing			   = 0.1;
+	static constexpr double	  requiredParallelSpeedup  = 0.8;
+	static constexpr double	  initialThreadPoolOverhead = 20.0e-6; // Seconds, replaced by the measurement once the pool was used
+
+	static constexpr uint64_t encodeOrder(std::span<const int> order) noexcept;
+
+	static constexpr int	  decodePosition(uint64_t plan, int position) noexcept;
+
+	template <typename Function>
+	void					  updatePlan(Function &&update);
+
+
+	std::array<EffectBase<SampleType> *, maxNumEffects> mEffects{};
+
+	int													mNumEffects{0};
+
+	std::atomic<uint64_t>								mPlan;
+
+	std::array<juce::AudioBuffer<SampleType>, maxNumEffects> mBranchBuffers;
+
+	int													mBranchNumChannels{0};
+
+	int													mBranchMaxBlockSize{0};
+
+	using AlignmentDelay = juce::dsp::DelayLine<SampleType, juce::dsp::DelayLineInterpolationTypes::Linear>;
+
+	std::array<AlignmentDelay, maxNumEffects>			mBranchDelays;
+	std::array<float, maxNumEffects>					mBranchAlignments{}; // Samples, set by the audio thread before the branches run
+
+	std::array<double, maxNumEffects>					mBranchCosts{};	  // Seconds per sample
+	std::array<double, maxNumEffects>					mBranchSeconds{}; // Of the last block
+	std::array<uint64_t, maxNumEffects>					mBranchTicks{};	  // Of the last block, recorded by the audio thread after the join
+
+	double												mThreadPoolOverhead{initialThreadPoolOverhead};
+
+	RealtimeThreadPool								   *mThreadPool{nullptr};
+
+	ProfilingTelemetry								   *mTelemetry{nullptr};
+
+	std::atomic<bool>									mCostModelEnabled{true};
+
+	bool												mLastBlockThreaded{false};
+};
+
+
+//==============================================================================
+// Fixed order chain without virtual dispatch, the effects are called through
+// their concrete type. Benchmark reference only: it measures the cost of the
+// virtual dispatch of the dynamic chain, the plugin always runs EffectChain.
+//==============================================================================
+
+template <typename SampleType, typename... Effects>
+class StaticEffectChain
+{
+public:
+	explicit StaticEffectChain(Effects &...effects) : mEffects(effects...) {}
+
+	void process(juce::AudioBuffer<SampleType> &buffer)
+	{
+		std::apply([&buffer](auto &...effect) { (processEffect(effect, buffer), ...); }, mEffects);
+	}
+
+private:
+	template <typename Effect>
+	static void processEffect(Effect &effect, juce::AudioBuffer<SampleType> &buffer)
+	{
+		// The qualified call is bound at compile time
+		effect.Effect::process(buffer);
+	}
+
+	std::tuple<Effects &...> mEffects;
+};
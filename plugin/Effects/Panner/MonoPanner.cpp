@@ -10,19 +10,17 @@
 #include "MonoPanner.h"
 
 
-template <typename SampleType>
-MonoPanner<SampleType>::MonoPanner()
-{
-	// Initialize the LFO with a sine wave
-	mLFO.initialise([](SampleType x) { return std::sin(x); });
-}
-
-
 template <typename SampleType>
 void MonoPanner<SampleType>::prepare(const juce::dsp::ProcessSpec &spec)
 {
 	PannerBase<SampleType>::setSampleRate(spec.sampleRate);
-	mLFO.prepare(spec);
+	mLFO.prepare(spec.sampleRate);
+	mScratch.setSize(3, static_cast<int>(spec.maximumBlockSize));
+
+	mPan.reset(spec.sampleRate, PannerBase<SampleType>::smoothingSeconds);
+	mLfoFrequency.reset(spec.sampleRate, PannerBase<SampleType>::smoothingSeconds);
+	mLfoDepth.reset(spec.sampleRate, PannerBase<SampleType>::smoothingSeconds);
+
 	reset();
 }
 
@@ -31,57 +29,77 @@ template <typename SampleType>
 void MonoPanner<SampleType>::reset()
 {
 	mLFO.reset();
+	mHasLastGains = false;
 }
 
 
 template <typename SampleType>
 void MonoPanner<SampleType>::process(juce::AudioBuffer<SampleType> &buffer)
 {
-	const int numChannels = buffer.getNumChannels();
-	const int numSamples  = buffer.getNumSamples();
-	const int samplerate  = PannerBase<SampleType>::getSampleRate();
+	const int numChannels  = buffer.getNumChannels();
+	const int numSamples   = buffer.getNumSamples();
+	const int maxBlockSize = mScratch.getNumSamples();
 
-	jassert(samplerate != 0); // Call ::prepare before attempting to call ::process()!
+	jassert(maxBlockSize > 0);	// Call ::prepare before attempting to call ::process()!
 	jassert(numChannels >= 2); // No panning possible with only one channel!
-	if (numChannels < 2)
+	if (numChannels < 2 || maxBlockSize == 0)
 		return;
 
-	// Read parameter values
-	auto basePan	= mPan.getNextValue();
-	auto lfoFreq	= mLfoFrequency.getNextValue();
-	auto lfoDepth	= mLfoDepth.getNextValue();
-	bool lfoEnabled = PannerBase<SampleType>::getLfoEnabled();
+	// Read parameter values, block rate: the ramps move on by the whole block
+	const auto basePan	  = static_cast<SampleType>(mPan.skip(numSamples));
+	const auto lfoFreq	  = mLfoFrequency.skip(numSamples);
+	const auto lfoDepth	  = static_cast<SampleType>(mLfoDepth.skip(numSamples));
+	const bool lfoEnabled = PannerBase<SampleType>::getLfoEnabled();
+
+	auto	  *leftData	  = buffer.getWritePointer(0);
+	auto	  *rightData  = buffer.getWritePointer(1);
 
-	// Update LFO Frequency
-	mLFO.setFrequency(lfoFreq, samplerate);
+	if (lfoFreq != mLFO.getFrequency())
+		mLFO.setFrequency(lfoFreq);
 
-	// For each sample compute LFO value and final pan (if enabled)
-	for (int sample = 0; sample < numSamples; ++sample)
+	// Without modulation the pan ramp moves in steps of a block, the gains glide from those of the previous block
+	if (!lfoEnabled)
 	{
-		// Process the LFO, generating a sine wave between -1.0f and +1.0f
-		auto lfoValue		  = mLFO.processSample(0.0f);
+		SampleType leftGain = 0, rightGain = 0;
+		PannerBase<SampleType>::getPanGains(basePan, leftGain, rightGain);
 
-		// Final pan including LFO Modulation
-		// (e.g. basePan = 0.3, lfoDepth = 0.5f => lfoValue = +/-1 => finalPan goes from (0.3-0.5) to (0.3+0.5)
-		auto finalPan		  = basePan + (lfoDepth * lfoValue);
+		if (!mHasLastGains)
+		{
+			mLastLeftGain  = leftGain;
+			mLastRightGain = rightGain;
+		}
 
-		// Limit finalPan between -1.0 and +1.0
-		finalPan			  = juce::jlimit<SampleType>((SampleType)-1.0, (SampleType)1.0, (SampleType)finalPan);
+		buffer.applyGainRamp(0, 0, numSamples, mLastLeftGain, leftGain);
+		buffer.applyGainRamp(1, 0, numSamples, mLastRightGain, rightGain);
 
-		// Convert pan (-1..+1) to left & right gains:
-		//   leftGain  = cos( (pan + 1)*π/4 )
-		//   rightGain = sin( (pan + 1)*π/4 )
-		auto radiantValue	  = juce::MathConstants<SampleType>::pi * ((lfoEnabled ? finalPan : basePan) + 1.0f) * 0.25f;
-		auto leftGain		  = std::cos(radiantValue);
-		auto rightGain		  = std::sin(radiantValue);
+		mLastLeftGain  = leftGain;
+		mLastRightGain = rightGain;
+		mHasLastGains  = true;
 
-		// Apply gain to the channels
-		auto leftChanelData	  = buffer.getWritePointer(0);
-		auto rightChannelData = buffer.getWritePointer(1);
+		// The LFO keeps its phase running
+		mLFO.advance(numSamples);
+		return;
+	}
+
+	// Final pan including LFO Modulation
+	// (e.g. basePan = 0.3, lfoDepth = 0.5f => lfoValue = +/-1 => finalPan goes from (0.3-0.5) to (0.3+0.5)
+	// Hosts may exceed the announced block size, so render the gains in chunks fitting the scratch memory
+	for (int startSample = 0; startSample < numSamples; startSample += maxBlockSize)
+	{
+		const int chunkSize	 = juce::jmin(maxBlockSize, numSamples - startSample);
 
-		leftChanelData[sample] *= leftGain;
-		rightChannelData[sample] *= rightGain;
+		auto	 *pan		 = mScratch.getWritePointer(0);
+		auto	 *leftGains	 = mScratch.getWritePointer(1);
+		auto	 *rightGains = mScratch.getWritePointer(2);
+
+		PannerBase<SampleType>::renderLfoGains(mLFO, pan, leftGains, rightGains, basePan, lfoDepth, chunkSize);
+
+		juce::FloatVectorOperations::multiply(leftData + startSample, leftGains, chunkSize);
+		juce::FloatVectorOperations::multiply(rightData + startSample, rightGains, chunkSize);
 	}
+
+	// Switching the LFO off starts the static path from its own gains
+	mHasLastGains = false;
 }
 
 
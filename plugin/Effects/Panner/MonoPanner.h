@@ -13,10 +13,10 @@
 
 
 template <typename SampleType>
-class MonoPanner : public PannerBase<SampleType>
+class MonoPanner final : public PannerBase<SampleType>
 {
 public:
-	MonoPanner();
+	MonoPanner()  = default;
 	~MonoPanner() = default;
 
 	void prepare(const juce::dsp::ProcessSpec &spec) override;
@@ -28,9 +28,9 @@ public:
 	void setLfoDepth(float newDepth);
 
 	// Getters for PannerManager parameter interface
-	float getPan() const { return mPan.getCurrentValue(); }
-	float getLfoRate() const { return mLfoFrequency.getCurrentValue(); }
-	float getLfoDepth() const { return mLfoDepth.getCurrentValue(); }
+	float getPan() const { return mPan.getTargetValue(); }
+	float getLfoRate() const { return mLfoFrequency.getTargetValue(); }
+	float getLfoDepth() const { return mLfoDepth.getTargetValue(); }
 
 private:
 	juce::SmoothedValue<float>		  mPan;
@@ -39,5 +39,11 @@ private:
 
 	juce::SmoothedValue<float>		  mLfoDepth;
 
-	juce::dsp::Oscillator<SampleType> mLFO;
+	QuadratureOscillator<SampleType>  mLFO;
+
+	juce::AudioBuffer<SampleType>	  mScratch; // Pan positions, left and right gains of the LFO path
+
+	SampleType						  mLastLeftGain{0}; // Gains of the previous static block
+	SampleType						  mLastRightGain{0};
+	bool							  mHasLastGains{false};
 };
@@ -0,0 +1,260 @@
+/*
+  ==============================================================================
+
+	Module			MultichannelPanner
+	Description		Panner effect module placing a source in a surround layout (5.1, 7.1, 7.1.4)
+
+  ==============================================================================
+*/
+
+#include "MultichannelPanner.h"
+
+
+namespace
+{
+// Shortest representation of an angle, -180 .. 180 degrees
+float wrapDegrees(float degrees)
+{
+	return degrees - 360.0f * std::round(degrees / 360.0f);
+}
+} // namespace
+
+
+template <typename SampleType>
+bool MultichannelPanner<SampleType>::isLayoutSupported(const juce::AudioChannelSet &layout)
+{
+	return layout == juce::AudioChannelSet::create5point1() || layout == juce::AudioChannelSet::create7point1() || layout == juce::AudioChannelSet::create7point1point4();
+}
+
+
+template <typename SampleType>
+juce::AudioChannelSet MultichannelPanner<SampleType>::getDefaultLayout(int numChannels)
+{
+	switch (numChannels)
+	{
+	case 6: return juce::AudioChannelSet::create5point1();
+	case 8: return juce::AudioChannelSet::create7point1();
+	case 12: return juce::AudioChannelSet::create7point1point4();
+	default: return juce::AudioChannelSet::discreteChannels(numChannels);
+	}
+}
+
+
+template <typename SampleType>
+bool MultichannelPanner<SampleType>::getSpeakerDirection(juce::AudioChannelSet::ChannelType type, typename VBAPGainTable<SampleType>::Speaker &speaker)
+{
+	// ITU-R BS.775 for the ear level, the height speakers at 45 degrees above the front and rear diagonals
+	switch (type)
+	{
+	case juce::AudioChannelSet::left: speaker = {-30.0, 0.0}; return true;
+	case juce::AudioChannelSet::right: speaker = {30.0, 0.0}; return true;
+	case juce::AudioChannelSet::centre: speaker = {0.0, 0.0}; return true;
+	case juce::AudioChannelSet::leftSurround: speaker = {-110.0, 0.0}; return true;
+	case juce::AudioChannelSet::rightSurround: speaker = {110.0, 0.0}; return true;
+	case juce::AudioChannelSet::leftSurroundSide: speaker = {-90.0, 0.0}; return true;
+	case juce::AudioChannelSet::rightSurroundSide: speaker = {90.0, 0.0}; return true;
+	case juce::AudioChannelSet::leftSurroundRear: speaker = {-150.0, 0.0}; return true;
+	case juce::AudioChannelSet::rightSurroundRear: speaker = {150.0, 0.0}; return true;
+	case juce::AudioChannelSet::topFrontLeft: speaker = {-45.0, 45.0}; return true;
+	case juce::AudioChannelSet::topFrontRight: speaker = {45.0, 45.0}; return true;
+	case juce::AudioChannelSet::topRearLeft: speaker = {-135.0, 45.0}; return true;
+	case juce::AudioChannelSet::topRearRight: speaker = {135.0, 45.0}; return true;
+	default: return false; // The LFE is not panned
+	}
+}
+
+
+template <typename SampleType>
+void MultichannelPanner<SampleType>::prepare(const juce::dsp::ProcessSpec &spec)
+{
+	PannerBase<SampleType>::setSampleRate(spec.sampleRate);
+	mLFO.prepare(spec.sampleRate);
+
+	// A host layout of another size belongs to an earlier configuration
+	const int  numChannels = static_cast<int>(spec.numChannels);
+	const auto layout	   = mLayout.size() == numChannels ? mLayout : getDefaultLayout(numChannels);
+
+	std::vector<typename VBAPGainTable<SampleType>::Speaker> speakers;
+	mSpeakerChannels.clear();
+
+	for (int channel = 0; channel < layout.size(); ++channel)
+	{
+		typename VBAPGainTable<SampleType>::Speaker speaker;
+
+		if (getSpeakerDirection(layout.getTypeOfChannel(channel), speaker))
+		{
+			speakers.push_back(speaker);
+			mSpeakerChannels.push_back(channel);
+		}
+	}
+
+	mGainTable.build(speakers);
+	mStartGains.assign(speakers.size(), SampleType(0));
+	mEndGains.assign(speakers.size(), SampleType(0));
+	mSource.setSize(1, static_cast<int>(spec.maximumBlockSize));
+
+	for (auto *smoother : {&mAzimuth, &mElevation, &mLfoFrequency, &mLfoDepth})
+		smoother->reset(spec.sampleRate, PannerBase<SampleType>::smoothingSeconds);
+
+	reset();
+}
+
+
+template <typename SampleType>
+void MultichannelPanner<SampleType>::reset()
+{
+	mLFO.reset();
+	mHasStartGains = false;
+}
+
+
+template <typename SampleType>
+void MultichannelPanner<SampleType>::process(juce::AudioBuffer<SampleType> &buffer)
+{
+	const int numSamples   = buffer.getNumSamples();
+	const int numSpeakers  = static_cast<int>(mSpeakerChannels.size());
+	const int maxBlockSize = mSource.getNumSamples();
+
+	jassert(maxBlockSize > 0); // Call ::prepare before attempting to call ::process()!
+	if (numSpeakers == 0 || maxBlockSize == 0)
+		return;
+
+	jassert(buffer.getNumChannels() > mSpeakerChannels.back()); // The buffer does not match the prepared layout!
+	if (buffer.getNumChannels() <= mSpeakerChannels.back())
+		return;
+
+	// Read parameter values, block rate: the ramps move on by the whole block
+	const auto baseAzimuth = static_cast<SampleType>(mAzimuth.skip(numSamples));
+	const auto elevation   = static_cast<SampleType>(mElevation.skip(numSamples));
+	const auto lfoFreq	   = mLfoFrequency.skip(numSamples);
+	const auto lfoDepth	   = static_cast<SampleType>(mLfoDepth.skip(numSamples)) * SampleType(180); // A depth of 1 circles the listener
+	const bool lfoEnabled  = PannerBase<SampleType>::getLfoEnabled();
+
+	if (lfoFreq != mLFO.getFrequency())
+		mLFO.setFrequency(lfoFreq);
+
+	if (!mHasStartGains)
+	{
+		mGainTable.getGains(baseAzimuth + (lfoEnabled ? lfoDepth * mLFO.getSine() : SampleType(0)), elevation, mStartGains.data());
+		mHasStartGains = true;
+	}
+
+	// Without modulation the gains glide from the last block to the new position and hold for the rest
+	if (!lfoEnabled)
+		mGainTable.getGains(baseAzimuth, elevation, mEndGains.data());
+
+	const int interval = PannerBase<SampleType>::getControlInterval();
+
+	// A bed with the same signal on every speaker keeps its level, the plain sum would be numSpeakers times louder
+	// (+14 dB for 5.1, +21 dB for 7.1.4). A signal on a single speaker drops by the same factor instead
+	const auto downmixGain = static_cast<SampleType>(1.0 / numSpeakers);
+
+	// Hosts may exceed the announced block size, so downmix in chunks fitting the scratch memory
+	for (int startSample = 0; startSample < numSamples; startSample += maxBlockSize)
+	{
+		const int chunkSize = juce::jmin(maxBlockSize, numSamples - startSample);
+		auto	 *source	= mSource.getWritePointer(0);
+
+		// The source is the average of the speaker channels, the LFE passes unchanged
+		juce::FloatVectorOperations::copyWithMultiply(source, buffer.getReadPointer(mSpeakerChannels[0], startSample), downmixGain, chunkSize);
+
+		for (int speaker = 1; speaker < numSpeakers; ++speaker)
+			juce::FloatVectorOperations::addWithMultiply(source, buffer.getReadPointer(mSpeakerChannels[static_cast<size_t>(speaker)], startSample), downmixGain, chunkSize);
+
+		if (!lfoEnabled)
+		{
+			applyGains(buffer, source, startSample, chunkSize);
+			std::copy(mEndGains.begin(), mEndGains.end(), mStartGains.begin());
+			continue;
+		}
+
+		// The LFO and the gains are evaluated at control rate, the gains ramp linearly in between
+		for (int segment = 0; segment < chunkSize; segment += interval)
+		{
+			const int length = juce::jmin(interval, chunkSize - segment);
+			mLFO.advance(length);
+
+			mGainTable.getGains(baseAzimuth + lfoDepth * mLFO.getSine(), elevation, mEndGains.data());
+			applyGains(buffer, source + segment, startSample + segment, length);
+			std::swap(mStartGains, mEndGains);
+		}
+	}
+
+	// The LFO keeps its phase running
+	if (!lfoEnabled)
+		mLFO.advance(numSamples);
+}
+
+
+template <typename SampleType>
+void MultichannelPanner<SampleType>::applyGains(juce::AudioBuffer<SampleType> &buffer, const SampleType *source, int startSample, int numSamples)
+{
+	for (size_t speaker = 0; speaker < mSpeakerChannels.size(); ++speaker)
+	{
+		auto			*output = buffer.getWritePointer(mSpeakerChannels[speaker], startSample);
+		const SampleType start	= mStartGains[speaker];
+		const SampleType end	= mEndGains[speaker];
+
+		// VBAP drives two or three speakers, the cost of the others is a clear
+		if (start == SampleType(0) && end == SampleType(0))
+		{
+			juce::FloatVectorOperations::clear(output, numSamples);
+		}
+		else if (start == end)
+		{
+			juce::FloatVectorOperations::copyWithMultiply(output, source, start, numSamples);
+		}
+		else
+		{
+			const SampleType step = (end - start) / static_cast<SampleType>(numSamples);
+
+			for (int i = 0; i < numSamples; ++i)
+				output[i] = source[i] * (start + step * static_cast<SampleType>(i));
+		}
+	}
+}
+
+
+template <typename SampleType>
+void MultichannelPanner<SampleType>::setAzimuth(float newAzimuth)
+{
+	// Start from the shortest representation once a ramp ended, so the value stays small
+	if (!mAzimuth.isSmoothing())
+		mAzimuth.setCurrentAndTargetValue(wrapDegrees(mAzimuth.getCurrentValue()));
+
+	// Take the shorter way around, from 170 to -170 degrees crosses the back instead of the front
+	const float current = mAzimuth.getCurrentValue();
+	mAzimuth.setTargetValue(current + wrapDegrees(newAzimuth - current));
+}
+
+
+template <typename SampleType>
+float MultichannelPanner<SampleType>::getAzimuth() const
+{
+	return wrapDegrees(mAzimuth.getTargetValue());
+}
+
+
+template <typename SampleType>
+void MultichannelPanner<SampleType>::setElevation(float newElevation)
+{
+	mElevation.setTargetValue(newElevation);
+}
+
+
+template <typename SampleType>
+void MultichannelPanner<SampleType>::setLfoRate(float newFrequency)
+{
+	mLfoFrequency.setTargetValue(newFrequency);
+}
+
+
+template <typename SampleType>
+void MultichannelPanner<SampleType>::setLfoDepth(float newDepth)
+{
+	mLfoDepth.setTargetValue(newDepth);
+}
+
+
+template class MultichannelPanner<float>;
+template class MultichannelPanner<double>;
@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+	Module			MultichannelPanner
+	Description		Panner effect module placing a source in a surround layout (5.1, 7.1, 7.1.4)
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "PannerBase.h"
+#include "VBAPGainTable.h"
+
+#include <vector>
+
+
+template <typename SampleType>
+class MultichannelPanner final : public PannerBase<SampleType>
+{
+public:
+	MultichannelPanner()  = default;
+	~MultichannelPanner() = default;
+
+	void						 prepare(const juce::dsp::ProcessSpec &spec) override;
+	void						 reset() override;
+	void						 process(juce::AudioBuffer<SampleType> &buffer) override;
+
+	// The surround layouts with a known direction for every speaker
+	static bool					 isLayoutSupported(const juce::AudioChannelSet &layout);
+
+	// Layout assumed for a channel count when the host did not name one
+	static juce::AudioChannelSet getDefaultLayout(int numChannels);
+
+	// Channel order of the host bus, takes effect in the next prepare()
+	void						 setChannelLayout(const juce::AudioChannelSet &layout) { mLayout = layout; }
+
+	// Degrees, azimuth 0 in front and positive to the right, elevation 0 .. 90 above the listener
+	void						 setAzimuth(float newAzimuth);
+	void						 setElevation(float newElevation);
+	void						 setLfoRate(float newFrequency);
+	void						 setLfoDepth(float newDepth);
+
+	// Getters for PannerManager parameter interface
+	float						 getAzimuth() const;
+	float						 getElevation() const { return mElevation.getTargetValue(); }
+	float						 getLfoRate() const { return mLfoFrequency.getTargetValue(); }
+	float						 getLfoDepth() const { return mLfoDepth.getTargetValue(); }
+
+	int							 getNumSpeakers() const { return mGainTable.getNumSpeakers(); }
+
+private:
+	// Direction of a speaker channel, false for the LFE and channels without a position
+	static bool					 getSpeakerDirection(juce::AudioChannelSet::ChannelType type, typename VBAPGainTable<SampleType>::Speaker &speaker);
+
+	// Writes the source to every speaker, the gains ramp from mStartGains to mEndGains over the samples
+	void						 applyGains(juce::AudioBuffer<SampleType> &buffer, const SampleType *source, int startSample, int numSamples);
+
+	juce::SmoothedValue<float>	 mAzimuth; // Unwrapped, follows the shorter way around the circle
+	juce::SmoothedValue<float>	 mElevation;
+	juce::SmoothedValue<float>	 mLfoFrequency;
+	juce::SmoothedValue<float>	 mLfoDepth;
+
+	QuadratureOscillator<SampleType> mLFO;
+
+	juce::AudioChannelSet		 mLayout;
+
+	VBAPGainTable<SampleType>	 mGainTable;
+
+	std::vector<int>			 mSpeakerChannels; // Buffer channel of each speaker in the table
+
+	std::vector<SampleType>		 mStartGains; // Per speaker, at the start and the end of the current segment
+	std::vector<SampleType>		 mEndGains;
+
+	bool						 mHasStartGains{false};
+
+	// Average of the speaker channels. The panner places a single source, a surround image built upstream collapses into it
+	juce::AudioBuffer<SampleType> mSource;
+};
@@ -12,13 +12,18 @@
 #include <juce_audio_basics/juce_audio_basics.h>
 #include <juce_dsp/juce_dsp.h>
 
+#include "Parameters.h"
+#include "FastMath.h"
+#include "PanGainTable.h"
+#include "QuadratureOscillator.h"
+
 
 template <typename SampleType>
 class PannerBase
 {
 public:
 	PannerBase()												= default;
-	~PannerBase()												= default;
+	virtual ~PannerBase()										= default;
 
 	virtual void prepare(const juce::dsp::ProcessSpec &spec)	= 0;
 	virtual void process(juce::AudioBuffer<SampleType> &buffer) = 0;
@@ -26,17 +31,94 @@ public:
 
 	void		 enableLFO(bool enabled) { mLfoEnabled.store(enabled); }
 
+	void		 setMathPrecision(MathPrecision newPrecision) { mMathPrecision.store(newPrecision); }
+
+	// Samples between two evaluations of the LFO and the pan law, the gains are interpolated
+	// linearly in between. An interval of 1 evaluates every sample.
+	static constexpr int defaultControlInterval = 16;
+	static constexpr int maxControlInterval		= 256;
+
+	void				 setControlInterval(int numSamples) { mControlInterval.store(juce::jlimit(1, maxControlInterval, numSamples)); }
+	int					 getControlInterval() const { return mControlInterval.load(); }
+
 protected:
+	// The parameters are read once per (sub) block and ramp from block to block over this time
+	static constexpr double smoothingSeconds = 0.01;
+
+	// Shared by all panners, built when the plugin is loaded
+	static inline const PanGainTable<SampleType> panGainTable{};
+
 	double getSampleRate() const { return mSampleRate; }
 
 	void   setSampleRate(double rate) { mSampleRate = rate; }
 
+	// Constant power gains of a pan position that holds for the whole block, with the selected math precision
+	void   getPanGains(SampleType pan, SampleType &leftGain, SampleType &rightGain) const
+	{
+		const SampleType angle = juce::MathConstants<SampleType>::pi * (juce::jlimit(SampleType(-1), SampleType(1), pan) + SampleType(1)) * SampleType(0.25);
+
+		leftGain			   = useFastMath() ? FastMath::cos(angle) : std::cos(angle);
+		rightGain			   = useFastMath() ? FastMath::sin(angle) : std::sin(angle);
+	}
+
+	// Gains of a block with the pan at base + depth * LFO, limited to -1 .. 1. The pan scratch
+	// holds numSamples values and is only used by the per sample path.
+	void   renderLfoGains(QuadratureOscillator<SampleType> &lfo, SampleType *pan, SampleType *leftGains, SampleType *rightGains, SampleType basePan, SampleType depth, int numSamples) const
+	{
+		const int interval = getControlInterval();
+
+		if (interval <= 1)
+		{
+			lfo.process(pan, numSamples);
+			juce::FloatVectorOperations::multiply(pan, depth, numSamples);
+			juce::FloatVectorOperations::add(pan, basePan, numSamples);
+			juce::FloatVectorOperations::clip(pan, pan, SampleType(-1), SampleType(1), numSamples);
+			panGainTable.getGains(pan, leftGains, rightGains, numSamples);
+			return;
+		}
+
+		// Control rate: the gains at the start and the end of each segment, a straight line in between.
+		// The end of one segment is the start of the next, the curve stays continuous across blocks.
+		SampleType leftStart = 0, rightStart = 0;
+		panGainTable.getGains(basePan + depth * lfo.getSine(), leftStart, rightStart);
+
+		for (int start = 0; start < numSamples; start += interval)
+		{
+			const int length = juce::jmin(interval, numSamples - start);
+			lfo.advance(length);
+
+			SampleType leftEnd = 0, rightEnd = 0;
+			panGainTable.getGains(basePan + depth * lfo.getSine(), leftEnd, rightEnd);
+
+			renderLinearRamp(leftGains + start, leftStart, leftEnd, length);
+			renderLinearRamp(rightGains + start, rightStart, rightEnd, length);
+
+			leftStart  = leftEnd;
+			rightStart = rightEnd;
+		}
+	}
+
 	bool   getLfoEnabled() { return mLfoEnabled.load(); }
 
+	bool   useFastMath() const { return mMathPrecision.load() == MathPrecision::PrecisionFast; }
+
 private:
-	double			  mSampleRate{0};
+	// start + (end - start) * i / length for i = 0 .. length - 1, the loop has no dependency and vectorises
+	static void renderLinearRamp(SampleType *data, SampleType start, SampleType end, int length) noexcept
+	{
+		const SampleType step = (end - start) / static_cast<SampleType>(length);
+
+		for (int i = 0; i < length; ++i)
+			data[i] = start + step * static_cast<SampleType>(i);
+	}
+
+	double					   mSampleRate{0};
+
+	std::atomic<bool>		   mLfoEnabled;
+
+	std::atomic<MathPrecision> mMathPrecision{MathPrecision::PrecisionExact};
 
-	std::atomic<bool> mLfoEnabled;
+	std::atomic<int>		   mControlInterval{defaultControlInterval};
 };
 
 template class PannerBase<float>;
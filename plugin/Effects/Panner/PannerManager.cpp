@@ -14,7 +14,29 @@ template <typename SampleType>
 void PannerManager<SampleType>::setPannerMode(int numInputChannels)
 {
 	mNumInputChannels = numInputChannels;
-	mPannerMode		  = (numInputChannels == 1) ? PannerType::Mono : PannerType::Stereo;
+	mPannerMode		  = (numInputChannels == 1) ? PannerType::Mono : (numInputChannels == 2) ? PannerType::Stereo : PannerType::Multichannel;
+}
+
+
+template <typename SampleType>
+void PannerManager<SampleType>::setChannelLayout(const juce::AudioChannelSet &layout)
+{
+	mMultichannelPanner.setChannelLayout(layout);
+}
+
+
+template <typename SampleType>
+template <typename Function>
+void PannerManager<SampleType>::withActivePanner(Function &&function)
+{
+	// Tested one alternative after the other instead of std::visit, which goes through a table of function pointers
+	// the compiler cannot see through. Each branch calls the concrete type, so the lambda is inlined.
+	if (auto *mono = std::get_if<MonoPanner<SampleType> *>(&mActivePanner))
+		function(**mono);
+	else if (auto *stereo = std::get_if<StereoPanner<SampleType> *>(&mActivePanner))
+		function(**stereo);
+	else if (auto *multichannel = std::get_if<MultichannelPanner<SampleType> *>(&mActivePanner))
+		function(**multichannel);
 }
 
 
@@ -23,94 +45,123 @@ void PannerManager<SampleType>::prepare(const juce::dsp::ProcessSpec &spec)
 {
 	setPannerMode(spec.numChannels);
 
+	// The mode is resolved once here, process() and reset() go straight to the selected panner
 	if (mPannerMode == PannerType::Mono)
-		mMonoPanner.prepare(spec);
+		mActivePanner = &mMonoPanner;
 	else if (mPannerMode == PannerType::Stereo)
-		mStereoPanner.prepare(spec);
+		mActivePanner = &mStereoPanner;
+	else
+		mActivePanner = &mMultichannelPanner;
+
+	withActivePanner([&spec](auto &panner) { panner.prepare(spec); });
 }
 
 
 template <typename SampleType>
 void PannerManager<SampleType>::process(juce::AudioBuffer<SampleType> &buffer)
 {
-	if (mPannerMode == PannerType::Mono)
-		mMonoPanner.process(buffer);
-	else if (mPannerMode == PannerType::Stereo)
-		mStereoPanner.process(buffer);
+	RealtimeSafety::ScopedRealtimeSection realtimeSection;
+
+	// The panners only scale the input, silence stays silence
+	if (this->skipSilentBlock(buffer))
+		return;
+
+	withActivePanner([&buffer](auto &panner) { panner.process(buffer); });
 }
 
 
 template <typename SampleType>
 void PannerManager<SampleType>::reset()
 {
-	if (mPannerMode == PannerType::Mono)
-		mMonoPanner.reset();
-	else if (mPannerMode == PannerType::Stereo)
-		mStereoPanner.reset();
+	withActivePanner([](auto &panner) { panner.reset(); });
+
+	this->resetSilenceDetector();
 }
 
 
 template <typename SampleType>
-void PannerManager<SampleType>::setParameter(const std::string &name, float value)
+constexpr ParameterSetters<PannerManager<SampleType>> PannerManager<SampleType>::createParameterSetters()
 {
-	if (mPannerMode == PannerType::Mono)
+	ParameterSetters<PannerManager> setters{};
+
+	setters[toIndex(ParamId::MonoPanValue)]		   = [](PannerManager &panner, ParamId, float value) { panner.mMonoPanner.setPan(value); };
+
+	// The surround panner moves one source like the mono panner and shares its LFO
+	setters[toIndex(ParamId::MonoLfoFreq)] = [](PannerManager &panner, ParamId, float value)
 	{
-		if (name == paramMonoPanValue)
-			mMonoPanner.setPan(value);
-		else if (name == paramMonoLfoFreq)
-			mMonoPanner.setLfoRate(value);
-		else if (name == paramMonoLfoDepth)
-			mMonoPanner.setLfoDepth(value);
-		else if (name == paramPannerLfoEnabled)
-			enableLFO(value > 0.5f);
-	}
-	else if (mPannerMode == PannerType::Stereo)
+		panner.mMonoPanner.setLfoRate(value);
+		panner.mMultichannelPanner.setLfoRate(value);
+	};
+	setters[toIndex(ParamId::MonoLfoDepth)] = [](PannerManager &panner, ParamId, float value)
 	{
-		if (name == paramStereoLeftPanValue)
-			mStereoPanner.setLeftChannelPan(value);
-		else if (name == paramStereoRightPanValue)
-			mStereoPanner.setRightChannelPan(value);
-		else if (name == paramStereoLeftLfoFreq)
-			mStereoPanner.setLeftChannelLfoRate(value);
-		else if (name == paramStereoRightLfoFreq)
-			mStereoPanner.setRightChannelLfoRate(value);
-		else if (name == paramStereoLeftLfoDepth)
-			mStereoPanner.setLeftChannelLfoDepth(value);
-		else if (name == paramStereoRightLfoDepth)
-			mStereoPanner.setRightChannelLfoDepth(value);
-		else if (name == paramPannerLfoEnabled)
-			enableLFO(value > 0.5f);
-	}
+		panner.mMonoPanner.setLfoDepth(value);
+		panner.mMultichannelPanner.setLfoDepth(value);
+	};
+
+	setters[toIndex(ParamId::StereoLeftPanValue)]  = [](PannerManager &panner, ParamId, float value) { panner.mStereoPanner.setLeftChannelPan(value); };
+	setters[toIndex(ParamId::StereoRightPanValue)] = [](PannerManager &panner, ParamId, float value) { panner.mStereoPanner.setRightChannelPan(value); };
+	setters[toIndex(ParamId::StereoLeftLfoFreq)]   = [](PannerManager &panner, ParamId, float value) { panner.mStereoPanner.setLeftChannelLfoRate(value); };
+	setters[toIndex(ParamId::StereoRightLfoFreq)]  = [](PannerManager &panner, ParamId, float value) { panner.mStereoPanner.setRightChannelLfoRate(value); };
+	setters[toIndex(ParamId::StereoLeftLfoDepth)]  = [](PannerManager &panner, ParamId, float value) { panner.mStereoPanner.setLeftChannelLfoDepth(value); };
+	setters[toIndex(ParamId::StereoRightLfoDepth)] = [](PannerManager &panner, ParamId, float value) { panner.mStereoPanner.setRightChannelLfoDepth(value); };
+
+	setters[toIndex(ParamId::SurroundAzimuth)]	   = [](PannerManager &panner, ParamId, float value) { panner.mMultichannelPanner.setAzimuth(value); };
+	setters[toIndex(ParamId::SurroundElevation)]   = [](PannerManager &panner, ParamId, float value) { panner.mMultichannelPanner.setElevation(value); };
+
+	setters[toIndex(ParamId::PannerLfoEnabled)]	   = [](PannerManager &panner, ParamId, float value)
+	{
+		panner.mMonoPanner.enableLFO(value > 0.5f);
+		panner.mStereoPanner.enableLFO(value > 0.5f);
+		panner.mMultichannelPanner.enableLFO(value > 0.5f);
+	};
+	setters[toIndex(ParamId::MathPrecision)] = [](PannerManager &panner, ParamId, float value) { panner.setMathPrecision(static_cast<MathPrecision>(static_cast<int>(value))); };
+
+	return setters;
 }
 
 
 template <typename SampleType>
-float PannerManager<SampleType>::getParameter(const std::string &name) const
+constexpr ParameterGetters<PannerManager<SampleType>> PannerManager<SampleType>::createParameterGetters()
 {
-	if (mPannerMode == PannerType::Mono)
-	{
-		if (name == "pan")
-			return mMonoPanner.getPan();
-		else if (name == "lfoFreq")
-			return mMonoPanner.getLfoRate();
-		else if (name == "lfoDepth")
-			return mMonoPanner.getLfoDepth();
-	}
-	else if (mPannerMode == PannerType::Stereo)
-	{
-		if (name == "leftPan")
-			return mStereoPanner.getLeftChannelPan();
-		else if (name == "rightPan")
-			return mStereoPanner.getRightChannelPan();
-		else if (name == "leftLfoFreq")
-			return mStereoPanner.getLeftChannelLfoRate();
-		else if (name == "rightLfoFreq")
-			return mStereoPanner.getRightChannelLfoRate();
-		else if (name == "leftLfoDepth")
-			return mStereoPanner.getLeftChannelLfoDepth();
-		else if (name == "rightLfoDepth")
-			return mStereoPanner.getRightChannelLfoDepth();
-	}
+	ParameterGetters<PannerManager> getters{};
+
+	getters[toIndex(ParamId::MonoPanValue)]		   = [](const PannerManager &panner, ParamId) { return panner.mMonoPanner.getPan(); };
+	getters[toIndex(ParamId::MonoLfoFreq)]		   = [](const PannerManager &panner, ParamId) { return panner.mMonoPanner.getLfoRate(); };
+	getters[toIndex(ParamId::MonoLfoDepth)]		   = [](const PannerManager &panner, ParamId) { return panner.mMonoPanner.getLfoDepth(); };
+
+	getters[toIndex(ParamId::StereoLeftPanValue)]  = [](const PannerManager &panner, ParamId) { return panner.mStereoPanner.getLeftChannelPan(); };
+	getters[toIndex(ParamId::StereoRightPanValue)] = [](const PannerManager &panner, ParamId) { return panner.mStereoPanner.getRightChannelPan(); };
+	getters[toIndex(ParamId::StereoLeftLfoFreq)]   = [](const PannerManager &panner, ParamId) { return panner.mStereoPanner.getLeftChannelLfoRate(); };
+	getters[toIndex(ParamId::StereoRightLfoFreq)]  = [](const PannerManager &panner, ParamId) { return panner.mStereoPanner.getRightChannelLfoRate(); };
+	getters[toIndex(ParamId::StereoLeftLfoDepth)]  = [](const PannerManager &panner, ParamId) { return panner.mStereoPanner.getLeftChannelLfoDepth(); };
+	getters[toIndex(ParamId::StereoRightLfoDepth)] = [](const PannerManager &panner, ParamId) { return panner.mStereoPanner.getRightChannelLfoDepth(); };
+
+	getters[toIndex(ParamId::SurroundAzimuth)]	   = [](const PannerManager &panner, ParamId) { return panner.mMultichannelPanner.getAzimuth(); };
+	getters[toIndex(ParamId::SurroundElevation)]   = [](const PannerManager &panner, ParamId) { return panner.mMultichannelPanner.getElevation(); };
+
+	getters[toIndex(ParamId::MathPrecision)]	   = [](const PannerManager &panner, ParamId) { return static_cast<float>(panner.getMathPrecision()); };
+
+	return getters;
+}
+
+
+template <typename SampleType>
+void PannerManager<SampleType>::setParameter(ParamId id, float value)
+{
+	static constexpr auto setters = createParameterSetters();
+
+	if (const auto setter = setters[toIndex(id)])
+		setter(*this, id, value);
+}
+
+
+template <typename SampleType>
+float PannerManager<SampleType>::getParameter(ParamId id) const
+{
+	static constexpr auto getters = createParameterGetters();
+
+	if (const auto getter = getters[toIndex(id)])
+		return getter(*this, id);
 
 	return 0.0f;
 }
@@ -119,10 +170,27 @@ float PannerManager<SampleType>::getParameter(const std::string &name) const
 template <typename SampleType>
 void PannerManager<SampleType>::enableLFO(bool enabled)
 {
-	if (mPannerMode == PannerType::Mono)
-		mMonoPanner.enableLFO(enabled);
-	else if (mPannerMode == PannerType::Stereo)
-		mStereoPanner.enableLFO(enabled);
+	withActivePanner([enabled](auto &panner) { panner.enableLFO(enabled); });
+}
+
+
+template <typename SampleType>
+void PannerManager<SampleType>::setMathPrecision(MathPrecision newPrecision)
+{
+	EffectBase<SampleType>::setMathPrecision(newPrecision);
+
+	mMonoPanner.setMathPrecision(newPrecision);
+	mStereoPanner.setMathPrecision(newPrecision);
+	mMultichannelPanner.setMathPrecision(newPrecision);
+}
+
+
+template <typename SampleType>
+void PannerManager<SampleType>::setControlInterval(int numSamples)
+{
+	mMonoPanner.setControlInterval(numSamples);
+	mStereoPanner.setControlInterval(numSamples);
+	mMultichannelPanner.setControlInterval(numSamples);
 }
 
 
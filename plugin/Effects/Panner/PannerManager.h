@@ -11,9 +11,12 @@
 
 #include "MonoPanner.h"
 #include "StereoPanner.h"
+#include "MultichannelPanner.h"
 #include "Parameters.h"
 #include "EffectBase.h"
 
+#include <variant>
+
 
 template <typename SampleType>
 class PannerManager : public EffectBase<SampleType>
@@ -27,18 +30,34 @@ public:
 	void	   reset() override;
 	EffectType getEffectType() const override { return EffectType::Panner; }
 
-	void	   setParameter(const std::string &name, float value) override;
-	float	   getParameter(const std::string &name) const override;
+	// Parameters of both panners are kept up to date, whichever one is active
+	void	   setParameter(ParamId id, float value) override;
+	float	   getParameter(ParamId id) const override;
 
 	void	   setPannerMode(int numInputChannels);
 
+	// Channel order of the host bus, the surround layouts select the multichannel panner in the next prepare()
+	void	   setChannelLayout(const juce::AudioChannelSet &layout);
+
 	void	   enableLFO(bool enabled);
 
+	void	   setMathPrecision(MathPrecision newPrecision) override;
+
+	// Samples between two LFO evaluations of both panners, 1 evaluates every sample
+	void	   setControlInterval(int numSamples);
+
 
 private:
+	static constexpr ParameterSetters<PannerManager> createParameterSetters();
+	static constexpr ParameterGetters<PannerManager> createParameterGetters();
+
 	void					 processMonoPanner(float pan, float lfoFreq, float lfoDepth);
 	void					 processStereoPanner(float leftPan, float rightPan, float leftLfoFreq, float rightLfoFreq, float leftLfoDepth, float rightLfoDepth);
 
+	// Calls the function with the concrete panner selected in prepare(), does nothing before
+	template <typename Function>
+	void					 withActivePanner(Function &&function);
+
 
 	PannerType				 mPannerMode{PannerType::Mono};
 
@@ -47,6 +66,11 @@ private:
 	MonoPanner<SampleType>	 mMonoPanner;
 
 	StereoPanner<SampleType> mStereoPanner;
+
+	MultichannelPanner<SampleType> mMultichannelPanner;
+
+	// The panners are final, a call through the pointer held here is a direct call instead of a virtual one
+	std::variant<std::monostate, MonoPanner<SampleType> *, StereoPanner<SampleType> *, MultichannelPanner<SampleType> *> mActivePanner;
 };
 
 
@@ -10,22 +10,17 @@
 #include "StereoPanner.h"
 
 
-template <typename SampleType>
-inline StereoPanner<SampleType>::StereoPanner()
-{
-	// Initialize both LFOs with a sine wave
-	mLeftChannelLFO.initialise([](SampleType x) { return std::sin(x); });
-	mRightChannelLFO.initialise([](SampleType x) { return std::sin(x); });
-}
-
-
 template <typename SampleType>
 void StereoPanner<SampleType>::prepare(const juce::dsp::ProcessSpec &spec)
 {
 	PannerBase<SampleType>::setSampleRate(spec.sampleRate);
-	
-	mLeftChannelLFO.prepare(spec);
-	mRightChannelLFO.prepare(spec);
+
+	mLeftChannelLFO.prepare(spec.sampleRate);
+	mRightChannelLFO.prepare(spec.sampleRate);
+	mScratch.setSize(5, static_cast<int>(spec.maximumBlockSize));
+
+	for (auto *smoother : {&mLeftChannelPan, &mRightChannelPan, &mLeftChannelLfoFrequency, &mRightChannelLfoFrequency, &mLeftChannelLfoDepth, &mRightChannelLfoDepth})
+		smoother->reset(spec.sampleRate, PannerBase<SampleType>::smoothingSeconds);
 
 	reset();
 }
@@ -36,83 +31,95 @@ void StereoPanner<SampleType>::reset()
 {
 	mLeftChannelLFO.reset();
 	mRightChannelLFO.reset();
+	mHasLastGains = false;
 }
 
 
 template <typename SampleType>
 void StereoPanner<SampleType>::process(juce::AudioBuffer<SampleType> &buffer)
 {
-	const int numChannels = buffer.getNumChannels();
-	const int numSamples  = buffer.getNumSamples();
-	const double samplerate  = PannerBase<SampleType>::getSampleRate();
+	const int numChannels  = buffer.getNumChannels();
+	const int numSamples   = buffer.getNumSamples();
+	const int maxBlockSize = mScratch.getNumSamples();
 
-	jassert(samplerate != 0);  // Call ::prepare before attempting to call ::process()!
+	jassert(maxBlockSize > 0);	// Call ::prepare before attempting to call ::process()!
 	jassert(numChannels >= 2); // No panning possible with only one channel!
-	if (numChannels < 2)
+	if (numChannels < 2 || maxBlockSize == 0)
 		return;
 
 	// For convenience
-	auto *leftChanData	= buffer.getWritePointer(0);
-	auto *rightChanData = buffer.getWritePointer(1);
+	auto	  *leftChanData	 = buffer.getWritePointer(0);
+	auto	  *rightChanData = buffer.getWritePointer(1);
 
-	// Read parameter values
-	float leftBasePan	= mLeftChannelPan.getNextValue();
-	float leftLfoFreq	= mLeftChannelLfoFrequency.getNextValue();
-	float leftLfoDepth	= mLeftChannelLfoDepth.getNextValue();
+	// Read parameter values, block rate: the ramps move on by the whole block
+	const auto leftBasePan	 = static_cast<SampleType>(mLeftChannelPan.skip(numSamples));
+	const auto leftLfoFreq	 = mLeftChannelLfoFrequency.skip(numSamples);
+	const auto leftLfoDepth	 = static_cast<SampleType>(mLeftChannelLfoDepth.skip(numSamples));
 
-	float rightBasePan	= mRightChannelPan.getNextValue();
-	float rightLfoFreq	= mRightChannelLfoFrequency.getNextValue();
-	float rightLfoDepth = mRightChannelLfoDepth.getNextValue();
+	const auto rightBasePan	 = static_cast<SampleType>(mRightChannelPan.skip(numSamples));
+	const auto rightLfoFreq	 = mRightChannelLfoFrequency.skip(numSamples);
+	const auto rightLfoDepth = static_cast<SampleType>(mRightChannelLfoDepth.skip(numSamples));
 
-	bool  lfoEnabled	= PannerBase<SampleType>::getLfoEnabled();
+	const bool lfoEnabled	 = PannerBase<SampleType>::getLfoEnabled();
 
 	// Update LFO frequencies
-	mLeftChannelLFO.setFrequency(leftLfoFreq, samplerate);
-	mRightChannelLFO.setFrequency(rightLfoFreq, samplerate);
-
-	for (int sample = 0; sample < numSamples; ++sample)
-	{
-		// Process the LFO, generating a sine wave between -1.0f and +1.0f
-		auto  lfoLeftValue		= mLeftChannelLFO.processSample((SampleType)0.0);
-		auto  lfoRightValue		= mRightChannelLFO.processSample((SampleType)0.0);
-
-		// Final pan for each channel = basePan + LFO*depth
-		float finalPanLeft		= leftBasePan + (lfoLeftValue * leftLfoDepth);
-		float finalPanRight		= rightBasePan + (lfoRightValue * rightLfoDepth);
+	if (leftLfoFreq != mLeftChannelLFO.getFrequency())
+		mLeftChannelLFO.setFrequency(leftLfoFreq);
 
-		// Limit finalPan between -1.0 and +1.0
-		finalPanLeft			= juce::jlimit<float>(-1.0f, 1.0f, finalPanLeft);
-		finalPanRight			= juce::jlimit<float>(-1.0f, 1.0f, finalPanRight);
+	if (rightLfoFreq != mRightChannelLFO.getFrequency())
+		mRightChannelLFO.setFrequency(rightLfoFreq);
 
-		// Convert each pan to left/right gains (constant power pannin)
-		//   leftGain  = cos( (pan + 1)*π/4 )
-		//   rightGain = sin( (pan + 1)*π/4 )
-		auto angleLeft			= juce::MathConstants<SampleType>::pi * ((lfoEnabled ? finalPanLeft : leftBasePan) + 1.0f) * 0.25f;
-		auto angleRight			= juce::MathConstants<SampleType>::pi * ((lfoEnabled ? finalPanRight : rightBasePan) + 1.0f) * 0.25f;
-
-		auto leftChanLeftGain	= std::cos(angleLeft);
-		auto leftChanRightGain	= std::sin(angleLeft);
+	// OutLeft = (LeftChan -> Left) + (RightChan -> Left)
+	// OutRight = (LeftChan -> Right) + (RightChan -> Right)
+	if (!lfoEnabled)
+	{
+		typename StereoMatrix<SampleType>::Gains gains;
+		PannerBase<SampleType>::getPanGains(leftBasePan, gains.leftToLeft, gains.leftToRight);
+		PannerBase<SampleType>::getPanGains(rightBasePan, gains.rightToLeft, gains.rightToRight);
+
+		// The pan ramps move in steps of a block, the matrix glides from the gains of the previous block
+		if (mHasLastGains && !matchesLastGains(gains))
+			StereoMatrix<SampleType>::process(leftChanData, rightChanData, mLastGains, gains, numSamples);
+		else
+			StereoMatrix<SampleType>::process(leftChanData, rightChanData, gains, numSamples);
+
+		mLastGains	  = gains;
+		mHasLastGains = true;
+
+		// The LFOs keep their phase running
+		mLeftChannelLFO.advance(numSamples);
+		mRightChannelLFO.advance(numSamples);
+		return;
+	}
 
-		auto rightChanLeftGain	= std::cos(angleRight);
-		auto rightChanRightGain = std::sin(angleRight);
+	// Hosts may exceed the announced block size, so render the gains in chunks fitting the scratch memory
+	for (int startSample = 0; startSample < numSamples; startSample += maxBlockSize)
+	{
+		const int chunkSize			 = juce::jmin(maxBlockSize, numSamples - startSample);
 
-		// Original input samples
-		auto inL				= leftChanData[sample];
-		auto inR				= rightChanData[sample];
+		auto	 *pan				 = mScratch.getWritePointer(0);
+		auto	 *leftChanLeftGains	 = mScratch.getWritePointer(1);
+		auto	 *leftChanRightGains = mScratch.getWritePointer(2);
+		auto	 *rightChanLeftGains = mScratch.getWritePointer(3);
+		auto	 *rightChanRightGains = mScratch.getWritePointer(4);
 
+		// Final pan for each channel = basePan + LFO*depth
+		PannerBase<SampleType>::renderLfoGains(mLeftChannelLFO, pan, leftChanLeftGains, leftChanRightGains, leftBasePan, leftLfoDepth, chunkSize);
+		PannerBase<SampleType>::renderLfoGains(mRightChannelLFO, pan, rightChanLeftGains, rightChanRightGains, rightBasePan, rightLfoDepth, chunkSize);
 
-		// Apply gain to the channels
+		StereoMatrix<SampleType>::process(leftChanData + startSample, rightChanData + startSample, {leftChanLeftGains, rightChanLeftGains, leftChanRightGains, rightChanRightGains}, chunkSize);
+	}
 
-		// OutLeft = (LeftChan -> Left) + (RightChan -> Left)
-		auto outL				= inL * leftChanLeftGain + inR * rightChanLeftGain;
+	// Switching the LFO off starts the static path from its own gains
+	mHasLastGains = false;
+}
 
-		// OutRight = (LeftChan -> Right) + (RightChan -> Right)
-		auto outR				= inL * leftChanRightGain + inR * rightChanRightGain;
 
-		// Store back
-		leftChanData[sample]	= outL;
-		rightChanData[sample]	= outR;
-	}
+template <typename SampleType>
+bool StereoPanner<SampleType>::matchesLastGains(const typename StereoMatrix<SampleType>::Gains &gains) const
+{
+	return gains.leftToLeft == mLastGains.leftToLeft && gains.rightToLeft == mLastGains.rightToLeft && gains.leftToRight == mLastGains.leftToRight
+		&& gains.rightToRight == mLastGains.rightToRight;
 }
 
 
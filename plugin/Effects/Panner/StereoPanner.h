@@ -10,12 +10,13 @@
 #pragma once
 
 #include "PannerBase.h"
+#include "StereoMatrix.h"
 
 template <typename SampleType>
-class StereoPanner : public PannerBase<SampleType>
+class StereoPanner final : public PannerBase<SampleType>
 {
 public:
-	StereoPanner();
+	StereoPanner()	= default;
 	~StereoPanner() = default;
 
 	void prepare(const juce::dsp::ProcessSpec &spec) override;
@@ -33,15 +34,17 @@ public:
 	void setRightChannelLfoDepth(float newDepth);
 
 	// Getters for PannerManager parameter interface
-	float getLeftChannelPan() const { return mLeftChannelPan.getCurrentValue(); }
-	float getLeftChannelLfoRate() const { return mLeftChannelLfoFrequency.getCurrentValue(); }
-	float getLeftChannelLfoDepth() const { return mLeftChannelLfoDepth.getCurrentValue(); }
+	float getLeftChannelPan() const { return mLeftChannelPan.getTargetValue(); }
+	float getLeftChannelLfoRate() const { return mLeftChannelLfoFrequency.getTargetValue(); }
+	float getLeftChannelLfoDepth() const { return mLeftChannelLfoDepth.getTargetValue(); }
 
-	float getRightChannelPan() const { return mRightChannelPan.getCurrentValue(); }
-	float getRightChannelLfoRate() const { return mRightChannelLfoFrequency.getCurrentValue(); }
-	float getRightChannelLfoDepth() const { return mRightChannelLfoDepth.getCurrentValue(); }
+	float getRightChannelPan() const { return mRightChannelPan.getTargetValue(); }
+	float getRightChannelLfoRate() const { return mRightChannelLfoFrequency.getTargetValue(); }
+	float getRightChannelLfoDepth() const { return mRightChannelLfoDepth.getTargetValue(); }
 
 private:
+	bool							  matchesLastGains(const typename StereoMatrix<SampleType>::Gains &gains) const;
+
 	juce::SmoothedValue<float>		  mLeftChannelPan;
 	juce::SmoothedValue<float>		  mRightChannelPan;
 
@@ -51,6 +54,11 @@ private:
 	juce::SmoothedValue<float>		  mLeftChannelLfoDepth;
 	juce::SmoothedValue<float>		  mRightChannelLfoDepth;
 
-	juce::dsp::Oscillator<SampleType> mLeftChannelLFO;
-	juce::dsp::Oscillator<SampleType> mRightChannelLFO;
+	QuadratureOscillator<SampleType>  mLeftChannelLFO;
+	QuadratureOscillator<SampleType>  mRightChannelLFO;
+
+	juce::AudioBuffer<SampleType>	  mScratch; // Pan positions and the four gains of the LFO path
+
+	typename StereoMatrix<SampleType>::Gains mLastGains; // Matrix of the previous static block
+	bool							  mHasLastGains{false};
 };
@@ -11,6 +11,11 @@
 
 #include <juce_core/juce_core.h>
 
+#include <array>
+#include <optional>
+#include <span>
+#include <string_view>
+
 
 //==============================================================================
 //						PARAMETERS
@@ -33,14 +38,40 @@ constexpr float			outputMinValue			   = -24.0f;
 constexpr float			outputMaxValue			   = 24.0f;
 constexpr float			outputDefaultValue		   = 0.0f;
 
-constexpr auto			paramMixDelay			   = "mix";
+constexpr auto			paramMixDelay			   = "delaymix";
 constexpr auto			delayMixName			   = "Mix (Delay)";
-constexpr auto			paramMixDistortion		   = "mix";
+constexpr auto			paramMixDistortion		   = "mix"; // Registered first under the shared key, sessions keep their value
 constexpr auto			distortionMixName		   = "Mix (Distortion)";
 constexpr float			mixMinValue				   = 0.0f;
 constexpr float			mixMaxValue				   = 1.0f;
 constexpr float			mixDefaultValue			   = 0.0f;
 
+constexpr auto			paramMathPrecision		   = "precision";
+constexpr auto			mathPrecisionName		   = "Math Precision";
+constexpr auto			mathPrecisionArray		   = std::array{"Exact", "Fast"};
+
+
+//==============================================
+//				Effect Chain
+//==============================================
+
+constexpr auto			paramEffectOrder		   = "effectorder";
+constexpr auto			effectOrderName			   = "Effect Order";
+constexpr auto			effectOrderArray		   = std::array{"Distortion > Delay > Panner", "Distortion > Panner > Delay", "Delay > Distortion > Panner",
+															"Delay > Panner > Distortion", "Panner > Distortion > Delay", "Panner > Delay > Distortion"};
+
+constexpr auto			paramDistortionBypass	   = "distortionbypass";
+constexpr auto			distortionBypassName	   = "Bypass (Distortion)";
+constexpr auto			paramDelayBypass		   = "delaybypass";
+constexpr auto			delayBypassName			   = "Bypass (Delay)";
+constexpr auto			paramPannerBypass		   = "pannerbypass";
+constexpr auto			pannerBypassName		   = "Bypass (Panner)";
+constexpr bool			effectBypassDefault		   = false;
+
+constexpr auto			paramChainRouting		   = "routing";
+constexpr auto			chainRoutingName		   = "Routing";
+constexpr auto			chainRoutingArray		   = std::array{"Serial", "Parallel"};
+
 
 //==============================================
 //				Distortion
@@ -52,9 +83,31 @@ constexpr float			distortionDriveMin		   = 0.0f;
 constexpr float			distortionDriveMax		   = 24.0f;
 constexpr float			distortionDriveDefault	   = 0.0f;
 
+constexpr auto			paramDistortionOutput	   = "distortionoutput";
+constexpr auto			distortionOutputName	   = "Output (Distortion)";
+constexpr float			distortionOutputMin		   = -24.0f;
+constexpr float			distortionOutputMax		   = 24.0f;
+constexpr float			distortionOutputDefault	   = 0.0f;
+
 constexpr auto			paramDistortionType		   = "distortiontype";
 constexpr auto			distortionTypeName		   = "Type";
-const juce::StringArray distortionTypeArray		   = {"Hard", "Soft", "Saturation"};
+constexpr auto			distortionTypeArray		   = std::array{"Hard", "Soft", "Saturation"};
+
+constexpr auto			paramDistortionOversampling = "oversampling";
+constexpr auto			distortionOversamplingName	= "Oversampling";
+constexpr auto			distortionOversamplingArray = std::array{"Off", "2x", "4x", "8x"};
+
+constexpr auto			paramDistortionOversamplingFilter = "oversamplingfilter";
+constexpr auto			distortionOversamplingFilterName  = "Oversampling Filter";
+constexpr auto			distortionOversamplingFilterArray = std::array{"Polyphase IIR (Low Latency)", "FIR (Linear Phase)"};
+
+constexpr auto			paramDistortionAntialiasing = "antialiasing";
+constexpr auto			distortionAntialiasingName	= "Anti-Aliasing";
+constexpr auto			distortionAntialiasingArray = std::array{"Off", "ADAA (1st Order)", "ADAA (2nd Order)"};
+
+constexpr auto			paramDistortionDCFilter		= "dcfilter";
+constexpr auto			distortionDCFilterName		= "DC Filter";
+constexpr auto			distortionDCFilterArray		= std::array{"Linkwitz-Riley (4th Order)", "One Pole", "One Pole (after Saturation)"};
 
 
 //==============================================
@@ -77,7 +130,38 @@ constexpr float			delayFeedbackDefault	   = 0.0f;
 
 constexpr auto			paramDelayModel			   = "delaytype";
 constexpr auto			delayTypeName			   = "Type";
-const juce::StringArray delayTypeArray			   = {"Single Tap", "Ping Pong"};
+constexpr auto			delayTypeArray			   = std::array{"Single Tap", "Ping Pong", "Multi Tap"};
+
+constexpr auto			paramDelayInterpolation	   = "delayinterpolation";
+constexpr auto			delayInterpolationName	   = "Interpolation";
+constexpr auto			delayInterpolationArray	   = std::array{"Linear", "Lagrange (3rd Order)", "Thiran Allpass"};
+
+// Multi Tap mode, all taps read from the same delay buffer
+constexpr int			delayMaxTaps			   = 8;
+
+constexpr auto			paramDelayNumTaps		   = "delaynumtaps";
+constexpr auto			delayNumTapsName		   = "Taps";
+constexpr int			delayNumTapsMin			   = 1;
+constexpr int			delayNumTapsDefault		   = 4;
+
+constexpr auto			paramDelayTapTimes		   = std::array{"tapTime1", "tapTime2", "tapTime3", "tapTime4", "tapTime5", "tapTime6", "tapTime7", "tapTime8"};
+constexpr auto			delayTapTimeNames		   = std::array{"Time in MS (Tap 1)", "Time in MS (Tap 2)", "Time in MS (Tap 3)", "Time in MS (Tap 4)",
+															"Time in MS (Tap 5)", "Time in MS (Tap 6)", "Time in MS (Tap 7)", "Time in MS (Tap 8)"};
+constexpr float			delayTapTimeStepDefault	   = 125.0f; // Tap n defaults to n times this
+
+constexpr auto			paramDelayTapGains		   = std::array{"tapGain1", "tapGain2", "tapGain3", "tapGain4", "tapGain5", "tapGain6", "tapGain7", "tapGain8"};
+constexpr auto			delayTapGainNames		   = std::array{"Gain (Tap 1)", "Gain (Tap 2)", "Gain (Tap 3)", "Gain (Tap 4)",
+															"Gain (Tap 5)", "Gain (Tap 6)", "Gain (Tap 7)", "Gain (Tap 8)"};
+constexpr float			delayTapGainMin			   = 0.0f;
+constexpr float			delayTapGainMax			   = 1.0f;
+constexpr float			delayTapGainDefault		   = 0.5f;
+
+constexpr auto			paramDelayTapPans		   = std::array{"tapPan1", "tapPan2", "tapPan3", "tapPan4", "tapPan5", "tapPan6", "tapPan7", "tapPan8"};
+constexpr auto			delayTapPanNames		   = std::array{"Pan (Tap 1)", "Pan (Tap 2)", "Pan (Tap 3)", "Pan (Tap 4)",
+															"Pan (Tap 5)", "Pan (Tap 6)", "Pan (Tap 7)", "Pan (Tap 8)"};
+constexpr float			delayTapPanMin			   = -1.0f;
+constexpr float			delayTapPanMax			   = 1.0f;
+constexpr float			delayTapPanDefault		   = 0.0f;
 
 
 //==============================================
@@ -102,6 +186,18 @@ constexpr float			stereoRightPanValueMin	   = -1.0f;
 constexpr float			stereoRightPanValueMax	   = 1.0f;
 constexpr float			stereoRightPanValueDefault = 0.0f;
 
+constexpr auto			paramSurroundAzimuth	   = "azimuth";
+constexpr auto			surroundAzimuthName		   = "Azimuth (Surround)";
+constexpr float			surroundAzimuthMin		   = -180.0f;
+constexpr float			surroundAzimuthMax		   = 180.0f;
+constexpr float			surroundAzimuthDefault	   = 0.0f;
+
+constexpr auto			paramSurroundElevation	   = "elevation";
+constexpr auto			surroundElevationName	   = "Elevation (Surround)";
+constexpr float			surroundElevationMin	   = 0.0f;
+constexpr float			surroundElevationMax	   = 90.0f;
+constexpr float			surroundElevationDefault   = 0.0f;
+
 
 constexpr auto			paramMonoLfoFreq		   = "lfoFreq";
 constexpr auto			monoLfoFreqName			   = "LFO Frequency";
@@ -146,26 +242,268 @@ constexpr bool			pannerLfoEnabledDefault	   = false;
 
 
 //==============================================
-//				Effect Params
+//				Parameter Registry
 //==============================================
 
-// Distortion parameter mappings (EffectBase parameter name -> JUCE parameter ID)
-constexpr auto			distortionParameters	   = std::array{paramDistortionDrive, paramMixDistortion, paramOutput, paramDistortionType};
+// Every parameter of the plugin, the order is the order in which the processor creates them.
+// The audio thread only passes these IDs around, the string keys are used once when the
+// parameters are created and attached.
+enum class ParamId
+{
+	Input = 0,
+	Output,
+	MathPrecision,
+
+	EffectOrder,
+	DistortionBypass,
+	DelayBypass,
+	PannerBypass,
+	ChainRouting,
+
+	DistortionDrive,
+	DistortionMix,
+	DistortionOutput,
+	DistortionType,
+	DistortionOversampling,
+	DistortionOversamplingFilter,
+	DistortionAntialiasing,
+	DistortionDCFilter,
+
+	DelayMix,
+	DelayTimeLeft,
+	DelayTimeRight,
+	DelayFeedback,
+	DelayModel,
+	DelayInterpolation,
+	DelayNumTaps,
+	DelayTapTime1,
+	DelayTapTime2,
+	DelayTapTime3,
+	DelayTapTime4,
+	DelayTapTime5,
+	DelayTapTime6,
+	DelayTapTime7,
+	DelayTapTime8,
+	DelayTapGain1,
+	DelayTapGain2,
+	DelayTapGain3,
+	DelayTapGain4,
+	DelayTapGain5,
+	DelayTapGain6,
+	DelayTapGain7,
+	DelayTapGain8,
+	DelayTapPan1,
+	DelayTapPan2,
+	DelayTapPan3,
+	DelayTapPan4,
+	DelayTapPan5,
+	DelayTapPan6,
+	DelayTapPan7,
+	DelayTapPan8,
+
+	MonoPanValue,
+	StereoLeftPanValue,
+	StereoRightPanValue,
+	SurroundAzimuth,
+	SurroundElevation,
+	MonoLfoFreq,
+	StereoLeftLfoFreq,
+	StereoRightLfoFreq,
+	MonoLfoDepth,
+	StereoLeftLfoDepth,
+	StereoRightLfoDepth,
+	PannerLfoEnabled,
+
+	NumParameters
+};
+
+
+constexpr size_t numParameters = static_cast<size_t>(ParamId::NumParameters);
+
+constexpr size_t toIndex(ParamId id) noexcept
+{
+	return static_cast<size_t>(id);
+}
+
+// The tap parameters are contiguous, tap is zero based
+constexpr ParamId delayTapTimeId(int tap) noexcept
+{
+	return static_cast<ParamId>(toIndex(ParamId::DelayTapTime1) + static_cast<size_t>(tap));
+}
+
+constexpr ParamId delayTapGainId(int tap) noexcept
+{
+	return static_cast<ParamId>(toIndex(ParamId::DelayTapGain1) + static_cast<size_t>(tap));
+}
+
+constexpr ParamId delayTapPanId(int tap) noexcept
+{
+	return static_cast<ParamId>(toIndex(ParamId::DelayTapPan1) + static_cast<size_t>(tap));
+}
+
+
+enum class ParameterKind
+{
+	Float = 0,
+	Choice,
+	Int,
+	Bool
+};
+
+
+// Choice parameters range over the choice indices, bool parameters over 0 and 1
+struct ParameterInfo
+{
+	ParamId						id;
+	const char				   *key;
+	const char				   *name;
+	ParameterKind				kind;
+	float						minValue;
+	float						maxValue;
+	float						defaultValue;
+	std::span<const char *const> choices;
+};
+
+
+constexpr ParameterInfo floatParameter(ParamId id, const char *key, const char *name, float minValue, float maxValue, float defaultValue)
+{
+	return {id, key, name, ParameterKind::Float, minValue, maxValue, defaultValue, {}};
+}
+
+constexpr ParameterInfo choiceParameter(ParamId id, const char *key, const char *name, std::span<const char *const> choices)
+{
+	return {id, key, name, ParameterKind::Choice, 0.0f, static_cast<float>(choices.size() - 1), 0.0f, choices};
+}
+
+constexpr ParameterInfo intParameter(ParamId id, const char *key, const char *name, int minValue, int maxValue, int defaultValue)
+{
+	return {id, key, name, ParameterKind::Int, static_cast<float>(minValue), static_cast<float>(maxValue), static_cast<float>(defaultValue), {}};
+}
+
+constexpr ParameterInfo boolParameter(ParamId id, const char *key, const char *name, bool defaultValue)
+{
+	return {id, key, name, ParameterKind::Bool, 0.0f, 1.0f, defaultValue ? 1.0f : 0.0f, {}};
+}
+
+
+// clang-format off
+constexpr std::array<ParameterInfo, numParameters> parameterRegistry = {
+	floatParameter(ParamId::Input, paramInput, inputGainName, inputMinValue, inputMaxValue, inputDefaultValue),
+	floatParameter(ParamId::Output, paramOutput, outputName, outputMinValue, outputMaxValue, outputDefaultValue),
+	choiceParameter(ParamId::MathPrecision, paramMathPrecision, mathPrecisionName, mathPrecisionArray),
+
+	choiceParameter(ParamId::EffectOrder, paramEffectOrder, effectOrderName, effectOrderArray),
+	boolParameter(ParamId::DistortionBypass, paramDistortionBypass, distortionBypassName, effectBypassDefault),
+	boolParameter(ParamId::DelayBypass, paramDelayBypass, delayBypassName, effectBypassDefault),
+	boolParameter(ParamId::PannerBypass, paramPannerBypass, pannerBypassName, effectBypassDefault),
+	choiceParameter(ParamId::ChainRouting, paramChainRouting, chainRoutingName, chainRoutingArray),
+
+	floatParameter(ParamId::DistortionDrive, paramDistortionDrive, distortionDriveName, distortionDriveMin, distortionDriveMax, distortionDriveDefault),
+	floatParameter(ParamId::DistortionMix, paramMixDistortion, distortionMixName, mixMinValue, mixMaxValue, mixDefaultValue),
+	floatParameter(ParamId::DistortionOutput, paramDistortionOutput, distortionOutputName, distortionOutputMin, distortionOutputMax, distortionOutputDefault),
+	choiceParameter(ParamId::DistortionType, paramDistortionType, distortionTypeName, distortionTypeArray),
+	choiceParameter(ParamId::DistortionOversampling, paramDistortionOversampling, distortionOversamplingName, distortionOversamplingArray),
+	choiceParameter(ParamId::DistortionOversamplingFilter, paramDistortionOversamplingFilter, distortionOversamplingFilterName, distortionOversamplingFilterArray),
+	choiceParameter(ParamId::DistortionAntialiasing, paramDistortionAntialiasing, distortionAntialiasingName, distortionAntialiasingArray),
+	choiceParameter(ParamId::DistortionDCFilter, paramDistortionDCFilter, distortionDCFilterName, distortionDCFilterArray),
+
+	floatParameter(ParamId::DelayMix, paramMixDelay, delayMixName, mixMinValue, mixMaxValue, mixDefaultValue),
+	floatParameter(ParamId::DelayTimeLeft, paramDelayTimeLeft, delayTimeNameLeft, delayTimeMin, delayTimeMax, delayTimeDefault),
+	floatParameter(ParamId::DelayTimeRight, paramDelayTimeRight, delayTimeNameRight, delayTimeMin, delayTimeMax, delayTimeDefault),
+	floatParameter(ParamId::DelayFeedback, paramDelayFeedback, delayFeedbackName, delayFeedbackMin, delayFeedbackMax, delayFeedbackDefault),
+	choiceParameter(ParamId::DelayModel, paramDelayModel, delayTypeName, delayTypeArray),
+	choiceParameter(ParamId::DelayInterpolation, paramDelayInterpolation, delayInterpolationName, delayInterpolationArray),
+	intParameter(ParamId::DelayNumTaps, paramDelayNumTaps, delayNumTapsName, delayNumTapsMin, delayMaxTaps, delayNumTapsDefault),
+	floatParameter(ParamId::DelayTapTime1, paramDelayTapTimes[0], delayTapTimeNames[0], delayTimeMin, delayTimeMax, delayTapTimeStepDefault * 1.0f),
+	floatParameter(ParamId::DelayTapTime2, paramDelayTapTimes[1], delayTapTimeNames[1], delayTimeMin, delayTimeMax, delayTapTimeStepDefault * 2.0f),
+	floatParameter(ParamId::DelayTapTime3, paramDelayTapTimes[2], delayTapTimeNames[2], delayTimeMin, delayTimeMax, delayTapTimeStepDefault * 3.0f),
+	floatParameter(ParamId::DelayTapTime4, paramDelayTapTimes[3], delayTapTimeNames[3], delayTimeMin, delayTimeMax, delayTapTimeStepDefault * 4.0f),
+	floatParameter(ParamId::DelayTapTime5, paramDelayTapTimes[4], delayTapTimeNames[4], delayTimeMin, delayTimeMax, delayTapTimeStepDefault * 5.0f),
+	floatParameter(ParamId::DelayTapTime6, paramDelayTapTimes[5], delayTapTimeNames[5], delayTimeMin, delayTimeMax, delayTapTimeStepDefault * 6.0f),
+	floatParameter(ParamId::DelayTapTime7, paramDelayTapTimes[6], delayTapTimeNames[6], delayTimeMin, delayTimeMax, delayTapTimeStepDefault * 7.0f),
+	floatParameter(ParamId::DelayTapTime8, paramDelayTapTimes[7], delayTapTimeNames[7], delayTimeMin, delayTimeMax, delayTapTimeStepDefault * 8.0f),
+	floatParameter(ParamId::DelayTapGain1, paramDelayTapGains[0], delayTapGainNames[0], delayTapGainMin, delayTapGainMax, delayTapGainDefault),
+	floatParameter(ParamId::DelayTapGain2, paramDelayTapGains[1], delayTapGainNames[1], delayTapGainMin, delayTapGainMax, delayTapGainDefault),
+	floatParameter(ParamId::DelayTapGain3, paramDelayTapGains[2], delayTapGainNames[2], delayTapGainMin, delayTapGainMax, delayTapGainDefault),
+	floatParameter(ParamId::DelayTapGain4, paramDelayTapGains[3], delayTapGainNames[3], delayTapGainMin, delayTapGainMax, delayTapGainDefault),
+	floatParameter(ParamId::DelayTapGain5, paramDelayTapGains[4], delayTapGainNames[4], delayTapGainMin, delayTapGainMax, delayTapGainDefault),
+	floatParameter(ParamId::DelayTapGain6, paramDelayTapGains[5], delayTapGainNames[5], delayTapGainMin, delayTapGainMax, delayTapGainDefault),
+	floatParameter(ParamId::DelayTapGain7, paramDelayTapGains[6], delayTapGainNames[6], delayTapGainMin, delayTapGainMax, delayTapGainDefault),
+	floatParameter(ParamId::DelayTapGain8, paramDelayTapGains[7], delayTapGainNames[7], delayTapGainMin, delayTapGainMax, delayTapGainDefault),
+	floatParameter(ParamId::DelayTapPan1, paramDelayTapPans[0], delayTapPanNames[0], delayTapPanMin, delayTapPanMax, delayTapPanDefault),
+	floatParameter(ParamId::DelayTapPan2, paramDelayTapPans[1], delayTapPanNames[1], delayTapPanMin, delayTapPanMax, delayTapPanDefault),
+	floatParameter(ParamId::DelayTapPan3, paramDelayTapPans[2], delayTapPanNames[2], delayTapPanMin, delayTapPanMax, delayTapPanDefault),
+	floatParameter(ParamId::DelayTapPan4, paramDelayTapPans[3], delayTapPanNames[3], delayTapPanMin, delayTapPanMax, delayTapPanDefault),
+	floatParameter(ParamId::DelayTapPan5, paramDelayTapPans[4], delayTapPanNames[4], delayTapPanMin, delayTapPanMax, delayTapPanDefault),
+	floatParameter(ParamId::DelayTapPan6, paramDelayTapPans[5], delayTapPanNames[5], delayTapPanMin, delayTapPanMax, delayTapPanDefault),
+	floatParameter(ParamId::DelayTapPan7, paramDelayTapPans[6], delayTapPanNames[6], delayTapPanMin, delayTapPanMax, delayTapPanDefault),
+	floatParameter(ParamId::DelayTapPan8, paramDelayTapPans[7], delayTapPanNames[7], delayTapPanMin, delayTapPanMax, delayTapPanDefault),
+
+	floatParameter(ParamId::MonoPanValue, paramMonoPanValue, monoPanValueName, monoPanValueMin, monoPanValueMax, monoPanValueDefault),
+	floatParameter(ParamId::StereoLeftPanValue, paramStereoLeftPanValue, stereoLeftPanValueName, stereoLeftPanValueMin, stereoLeftPanValueMax, stereoLeftPanValueDefault),
+	floatParameter(ParamId::StereoRightPanValue, paramStereoRightPanValue, stereoRightPanValueName, stereoRightPanValueMin, stereoRightPanValueMax, stereoRightPanValueDefault),
+	floatParameter(ParamId::SurroundAzimuth, paramSurroundAzimuth, surroundAzimuthName, surroundAzimuthMin, surroundAzimuthMax, surroundAzimuthDefault),
+	floatParameter(ParamId::SurroundElevation, paramSurroundElevation, surroundElevationName, surroundElevationMin, surroundElevationMax, surroundElevationDefault),
+	floatParameter(ParamId::MonoLfoFreq, paramMonoLfoFreq, monoLfoFreqName, monoLfoFreqMin, monoLfoFreqMax, monoLfoFreqDefault),
+	floatParameter(ParamId::StereoLeftLfoFreq, paramStereoLeftLfoFreq, stereoLeftLfoFreqName, stereoLeftLfoFreqMin, stereoLeftLfoFreqMax, stereoLeftLfoFreqDefault),
+	floatParameter(ParamId::StereoRightLfoFreq, paramStereoRightLfoFreq, stereoRightLfoFreqName, stereoRightLfoFreqMin, stereoRightLfoFreqMax, stereoRightLfoFreqDefault),
+	floatParameter(ParamId::MonoLfoDepth, paramMonoLfoDepth, monoLfoDepthName, monoLfoDepthMin, monoLfoDepthMax, monoLfoDepthDefault),
+	floatParameter(ParamId::StereoLeftLfoDepth, paramStereoLeftLfoDepth, stereoLeftLfoDepthName, stereoLeftLfoDepthMin, stereoLeftLfoDepthMax, stereoLeftLfoDepthDefault),
+	floatParameter(ParamId::StereoRightLfoDepth, paramStereoRightLfoDepth, stereoRightLfoDepthName, stereoRightLfoDepthMin, stereoRightLfoDepthMax, stereoRightLfoDepthDefault),
+	boolParameter(ParamId::PannerLfoEnabled, paramPannerLfoEnabled, pannerLfoEnabledName, pannerLfoEnabledDefault),
+};
+// clang-format on
+
 
-// Delay parameter mappings
-constexpr auto			delayParameters			   = std::array{paramMixDelay, paramDelayTimeLeft, paramDelayTimeRight, paramDelayFeedback, paramDelayModel};
+constexpr const ParameterInfo &getParameterInfo(ParamId id) noexcept
+{
+	return parameterRegistry[toIndex(id)];
+}
+
+
+// Linear search, only meant for attaching to the parameters of the processor
+constexpr std::optional<ParamId> findParameterId(std::string_view key) noexcept
+{
+	for (const auto &info : parameterRegistry)
+	{
+		if (key == info.key)
+			return info.id;
+	}
 
-// Gain parameter mappings
-constexpr auto			gainParameters			   = std::array{paramInput, paramOutput};
+	return std::nullopt;
+}
 
-// Panner parameter mappings
-constexpr auto			pannerMonoParameters	   = std::array{paramMonoPanValue, paramMonoLfoFreq, paramMonoLfoDepth};
 
-constexpr auto			pannerStereoParameters =
-	std::array{paramStereoLeftPanValue, paramStereoRightPanValue, paramStereoLeftLfoFreq, paramStereoRightLfoFreq, paramStereoLeftLfoDepth, paramStereoRightLfoDepth};
+namespace ParameterRegistryChecks
+{
+constexpr bool isIndexedById()
+{
+	for (size_t index = 0; index < parameterRegistry.size(); ++index)
+	{
+		if (toIndex(parameterRegistry[index].id) != index)
+			return false;
+	}
 
-constexpr auto pannerCommonParameters = std::array{paramPannerLfoEnabled};
+	return true;
+}
 
+constexpr bool hasUniqueKeys()
+{
+	for (size_t first = 0; first < parameterRegistry.size(); ++first)
+	{
+		for (size_t second = first + 1; second < parameterRegistry.size(); ++second)
+		{
+			if (std::string_view(parameterRegistry[first].key) == parameterRegistry[second].key)
+				return false;
+		}
+	}
+
+	return true;
+}
+} // namespace ParameterRegistryChecks
+
+static_assert(ParameterRegistryChecks::isIndexedById(), "The registry has to list the parameters in the order of ParamId");
+static_assert(ParameterRegistryChecks::hasUniqueKeys(), "Two parameters share the same key");
 
 //==============================================================================
 //						ENUM
@@ -179,14 +517,98 @@ enum DistortionType
 };
 
 
+// Value equals the power of two of the oversampling factor
+enum OversamplingFactor
+{
+	NoOversampling = 0,
+	Oversampling2x,
+	Oversampling4x,
+	Oversampling8x
+};
+
+
+enum OversamplingFilter
+{
+	PolyphaseIIR = 1,
+	LinearPhaseFIR
+};
+
+
+// Antiderivative anti-aliasing (ADAA), value equals the order
+enum AntialiasingMode
+{
+	AntialiasingOff = 0,
+	FirstOrderADAA,
+	SecondOrderADAA
+};
+
+
+// Highpass removing the DC offset in the distortion. The Linkwitz-Riley and the one pole filter the input,
+// the last mode filters only the wet signal of the saturation, the only asymmetric curve creating an offset
+enum DCFilterMode
+{
+	DCFilterLinkwitzRiley = 0,
+	DCFilterOnePole,
+	DCFilterAfterSaturation
+};
+
+
+// Exact uses the standard library, Fast the polynomial approximations of FastMath.h
+enum MathPrecision
+{
+	PrecisionExact = 0,
+	PrecisionFast
+};
+
+
 enum DelayType
 {
 	SingleTap = 1,
-	PingPong
+	PingPong,
+	MultiTap
+};
+
+
+// Fractional delay read, see FractionalDelay.h
+enum DelayInterpolation
+{
+	LinearInterpolation = 0,
+	LagrangeInterpolation,
+	ThiranInterpolation
 };
 
 enum PannerType
 {
 	Mono = 1,
-	Stereo
+	Stereo,
+	Multichannel // 5.1, 7.1 and 7.1.4
+};
+
+
+// Serial runs the effects one after the other, parallel feeds each the input and sums them
+enum ChainRouting
+{
+	SerialRouting = 0,
+	ParallelRouting
 };
+
+
+// Index of an effect in the effect chain of the processor
+enum EffectSlot
+{
+	DistortionSlot = 0,
+	DelaySlot,
+	PannerSlot,
+	NumEffectSlots
+};
+
+
+// Processing order of the effect slots for each entry of effectOrderArray
+constexpr std::array<std::array<int, NumEffectSlots>, effectOrderArray.size()> effectOrders = {{
+	{DistortionSlot, DelaySlot, PannerSlot},
+	{DistortionSlot, PannerSlot, DelaySlot},
+	{DelaySlot, DistortionSlot, PannerSlot},
+	{DelaySlot, PannerSlot, DistortionSlot},
+	{PannerSlot, DistortionSlot, DelaySlot},
+	{PannerSlot, DelaySlot, DistortionSlot},
+}};
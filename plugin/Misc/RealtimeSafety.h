@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+	Module			RealtimeSafety
+	Description		Marks the code running on the audio thread for the real-time safety checks
+
+  ==============================================================================
+*/
+
+#pragma once
+
+
+//==============================================================================
+// processBlock(), every branch of the parallel chain (also on the workers of the
+// pool) and the process() of every effect open a ScopedRealtimeSection.
+// While a section is open on a thread, nothing in it may allocate, free or lock:
+// the test build interposes malloc/free, new/delete and pthread_mutex_lock and
+// reports every call made inside a section (see RealtimeSafetyChecker in the
+// tests). The section only counts with MULTIEFFECT_REALTIME_CHECKS, which the
+// test target defines. Everywhere else it is an empty object and the plugin
+// ships without the instrumentation. The two versions live in different inline
+// namespaces, so a test built with the checks can link the plugin built without.
+//==============================================================================
+
+#ifndef MULTIEFFECT_REALTIME_CHECKS
+	#define MULTIEFFECT_REALTIME_CHECKS 0
+#endif
+
+
+namespace RealtimeSafety
+{
+
+#if MULTIEFFECT_REALTIME_CHECKS
+
+inline namespace Checked
+{
+
+// Depth of the nested sections on this thread, the effects run inside processBlock()
+inline thread_local int realtimeSectionDepth = 0;
+
+
+inline bool				isInRealtimeSection() noexcept
+{
+	return realtimeSectionDepth > 0;
+}
+
+
+class ScopedRealtimeSection
+{
+public:
+	ScopedRealtimeSection() noexcept { ++realtimeSectionDepth; }
+	~ScopedRealtimeSection() noexcept { --realtimeSectionDepth; }
+
+	ScopedRealtimeSection(const ScopedRealtimeSection &)			= delete;
+	ScopedRealtimeSection &operator=(const ScopedRealtimeSection &) = delete;
+};
+
+} // namespace Checked
+
+#else
+
+inline namespace Unchecked
+{
+
+inline bool isInRealtimeSection() noexcept
+{
+	return false;
+}
+
+
+class ScopedRealtimeSection
+{
+public:
+	// User provided, so the compilers do not warn about the unused local at every call site
+	ScopedRealtimeSection() noexcept {}
+
+	ScopedRealtimeSection(const ScopedRealtimeSection &)			= delete;
+	ScopedRealtimeSection &operator=(const ScopedRealtimeSection &) = delete;
+};
+
+} // namespace Unchecked
+
+#endif
+
+} // namespace RealtimeSafety
@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+	Module			ParameterSnapshot
+	Description		Lock free hand over of parameter changes to the audio thread
+
+  ==============================================================================
+*/
+
+#include "ParameterSnapshot.h"
+
+
+ParameterSnapshot::~ParameterSnapshot()
+{
+	detach();
+}
+
+
+void ParameterSnapshot::attach(juce::AudioProcessor &processor)
+{
+	detach();
+
+	const auto &parameters = processor.getParameters();
+
+	jassert(parameters.size() <= maxNumParameters); // Increase maxNumParameters!
+
+	for (auto *parameter : parameters)
+	{
+		if (parameter->getParameterIndex() >= maxNumParameters)
+			break;
+
+		auto *ranged = dynamic_cast<juce::RangedAudioParameter *>(parameter);
+
+		jassert(ranged != nullptr); // All parameters are created through the value tree state
+		jassert(parameter->getParameterIndex() == static_cast<int>(mParameters.size()));
+
+		const auto id = ranged != nullptr ? findParameterId(ranged->getParameterID().toStdString()) : std::nullopt;
+
+		jassert(id.has_value()); // Every parameter has to be listed in the parameter registry
+
+		// Unknown parameters keep their slot so the bits stay indexed by the parameter index, but are never reported
+		if (!id.has_value())
+		{
+			mParameters.push_back({});
+			continue;
+		}
+
+		mParameters.push_back({ranged, *id});
+		ranged->addListener(this);
+	}
+
+	markAllChanged();
+}
+
+
+void ParameterSnapshot::detach()
+{
+	for (auto &cached : mParameters)
+	{
+		if (cached.parameter != nullptr)
+			cached.parameter->removeListener(this);
+	}
+
+	mParameters.clear();
+
+	for (auto &word : mChangedBits)
+		word.store(0, std::memory_order_relaxed);
+}
+
+
+void ParameterSnapshot::markAllChanged()
+{
+	for (size_t index = 0; index < mParameters.size(); ++index)
+	{
+		if (mParameters[index].parameter != nullptr)
+			mChangedBits[index / bitsPerWord].fetch_or(uint64_t(1) << (index % bitsPerWord), std::memory_order_release);
+	}
+}
+
+
+void ParameterSnapshot::parameterValueChanged(int parameterIndex, float newValue)
+{
+	juce::ignoreUnused(newValue);
+
+	if (parameterIndex < 0 || parameterIndex >= getNumParameters())
+		return;
+
+	mChangedBits[static_cast<size_t>(parameterIndex / bitsPerWord)].fetch_or(uint64_t(1) << (parameterIndex % bitsPerWord), std::memory_order_release);
+}
@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+	Module			ParameterSnapshot
+	Description		Lock free hand over of parameter changes to the audio thread
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+
+#include "Parameters.h"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+
+
+//==============================================================================
+// Listens to every parameter of a processor and only sets a bit per changed
+// parameter, whichever thread the host automates from. The audio thread pulls
+// the changed parameters at the top of each block with forEachChanged(), so
+// dense automation costs one atomic or per change instead of a full parameter
+// update, and the effects only ever see parameter changes on the audio thread.
+// The parameters and their ParamId are cached once in attach(), nothing is
+// looked up by string later.
+//==============================================================================
+
+class ParameterSnapshot : private juce::AudioProcessorParameter::Listener
+{
+public:
+	ParameterSnapshot() = default;
+	~ParameterSnapshot() override;
+
+	static constexpr int maxNumParameters = 256;
+
+	// Caches all registered parameters of the processor and marks them as changed
+	void				 attach(juce::AudioProcessor &processor);
+
+	void				 detach();
+
+	void				 markAllChanged();
+
+	// Calls function(ParamId, value) for every parameter changed since the last call (audio thread)
+	template <typename Function>
+	void				 forEachChanged(Function &&function);
+
+	int					 getNumParameters() const noexcept { return static_cast<int>(mParameters.size()); }
+
+private:
+	void parameterValueChanged(int parameterIndex, float newValue) override;
+
+	void parameterGestureChanged(int parameterIndex, bool gestureIsStarting) override { juce::ignoreUnused(parameterIndex, gestureIsStarting); }
+
+	struct CachedParameter
+	{
+		juce::RangedAudioParameter *parameter{nullptr};
+		ParamId						id{ParamId::NumParameters};
+	};
+
+	static constexpr int										  bitsPerWord = 64;
+
+	std::vector<CachedParameter>								  mParameters; // Indexed by the parameter index of the processor
+
+	std::array<std::atomic<uint64_t>, maxNumParameters / bitsPerWord> mChangedBits{};
+};
+
+
+template <typename Function>
+void ParameterSnapshot::forEachChanged(Function &&function)
+{
+	const int numWords = (getNumParameters() + bitsPerWord - 1) / bitsPerWord;
+
+	for (int word = 0; word < numWords; ++word)
+	{
+		// Changes arriving while we iterate set the bit again and are picked up in the next block
+		uint64_t changed = mChangedBits[word].exchange(0, std::memory_order_acquire);
+
+		while (changed != 0)
+		{
+			const int bit	= std::countr_zero(changed);
+			changed		   &= changed - 1;
+
+			const auto &cached = mParameters[static_cast<size_t>(word * bitsPerWord + bit)];
+
+			// The parameter holds the current value itself, the value tree state may not have seen the change yet
+			function(cached.id, cached.parameter->convertFrom0to1(cached.parameter->getValue()));
+		}
+	}
+}
@@ -11,219 +11,333 @@
 #include "PluginEditor.h"
 
 
+namespace
+{
+// How often the message thread picks up the latency and the routing the audio thread left for it
+constexpr int messageThreadPollRateHz = 20;
+
+
+// The distortion settings change the latency of the effect, the chain parameters decide which latencies count
+bool changesLatency(ParamId id)
+{
+	return id == ParamId::DistortionOversampling || id == ParamId::DistortionOversamplingFilter || id == ParamId::DistortionAntialiasing
+		|| id == ParamId::EffectOrder || id == ParamId::ChainRouting || id == ParamId::DistortionBypass || id == ParamId::DelayBypass
+		|| id == ParamId::PannerBypass;
+}
+} // namespace
+
+
+template <typename SampleType>
+PluginProcessor::EffectModules<SampleType>::EffectModules()
+{
+	// Added in the order of EffectSlot
+	chain.addEffect(distortion);
+	chain.addEffect(delay);
+	chain.addEffect(panner);
+}
+
+
 PluginProcessor::PluginProcessor()
 	: AudioProcessor(BusesProperties().withInput("Input", juce::AudioChannelSet::stereo(), true).withOutput("Output", juce::AudioChannelSet::stereo(), true)),
 	  mValueTreeState(*this, nullptr, "PARAMETERS", createParameterLayout())
 {
-	mValueTreeState.addParameterListener(paramInput, this);
-	mValueTreeState.addParameterListener(paramOutput, this);
-	mValueTreeState.addParameterListener(paramDistortionDrive, this);
-	mValueTreeState.addParameterListener(paramMixDistortion, this);
-	mValueTreeState.addParameterListener(paramDistortionType, this);
-	mValueTreeState.addParameterListener(paramMixDelay, this);
-	mValueTreeState.addParameterListener(paramDelayTimeLeft, this);
-	mValueTreeState.addParameterListener(paramDelayTimeRight, this);
-	mValueTreeState.addParameterListener(paramDelayFeedback, this);
-	mValueTreeState.addParameterListener(paramDelayModel, this);
-	mValueTreeState.addParameterListener(paramMonoPanValue, this);
-	mValueTreeState.addParameterListener(paramStereoLeftPanValue, this);
-	mValueTreeState.addParameterListener(paramStereoRightPanValue, this);
-	mValueTreeState.addParameterListener(paramMonoLfoFreq, this);
-	mValueTreeState.addParameterListener(paramStereoLeftLfoFreq, this);
-	mValueTreeState.addParameterListener(paramStereoRightLfoFreq, this);
-	mValueTreeState.addParameterListener(paramMonoLfoDepth, this);
-	mValueTreeState.addParameterListener(paramStereoLeftLfoDepth, this);
-	mValueTreeState.addParameterListener(paramStereoRightLfoDepth, this);
-	mValueTreeState.addParameterListener(paramPannerLfoEnabled, this);
+	mFloatModules.chain.setThreadPool(&mThreadPool);
+	mFloatModules.chain.setTelemetry(&mTelemetry);
+	mDoubleModules.chain.setThreadPool(&mThreadPool);
+	mDoubleModules.chain.setTelemetry(&mTelemetry);
+
+	// Parameter changes are pulled at the top of each block
+	mParameterSnapshot.attach(*this);
+
+	// Latency and routing changes of the audio thread are handled on the message thread from here
+	startTimerHz(messageThreadPollRateHz);
 }
 
 
 PluginProcessor::~PluginProcessor()
 {
-	mValueTreeState.removeParameterListener(paramInput, this);
-	mValueTreeState.removeParameterListener(paramOutput, this);
-	mValueTreeState.removeParameterListener(paramDistortionDrive, this);
-	mValueTreeState.removeParameterListener(paramMixDistortion, this);
-	mValueTreeState.removeParameterListener(paramDistortionType, this);
-	mValueTreeState.removeParameterListener(paramMixDelay, this);
-	mValueTreeState.removeParameterListener(paramDelayTimeLeft, this);
-	mValueTreeState.removeParameterListener(paramDelayTimeRight, this);
-	mValueTreeState.removeParameterListener(paramDelayFeedback, this);
-	mValueTreeState.removeParameterListener(paramDelayModel, this);
-	mValueTreeState.removeParameterListener(paramMonoPanValue, this);
-	mValueTreeState.removeParameterListener(paramStereoLeftPanValue, this);
-	mValueTreeState.removeParameterListener(paramStereoRightPanValue, this);
-	mValueTreeState.removeParameterListener(paramMonoLfoFreq, this);
-	mValueTreeState.removeParameterListener(paramStereoLeftLfoFreq, this);
-	mValueTreeState.removeParameterListener(paramStereoRightLfoFreq, this);
-	mValueTreeState.removeParameterListener(paramMonoLfoDepth, this);
-	mValueTreeState.removeParameterListener(paramStereoLeftLfoDepth, this);
-	mValueTreeState.removeParameterListener(paramStereoRightLfoDepth, this);
-	mValueTreeState.removeParameterListener(paramPannerLfoEnabled, this);
+	stopTimer();
+	mParameterSnapshot.detach();
 }
 
 
 void PluginProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
-	mNumInputChannels = getTotalNumInputChannels();
-
 	// Initialize spec for DSP modules
 	juce::dsp::ProcessSpec spec;
 	spec.maximumBlockSize = samplesPerBlock;
 	spec.sampleRate		  = sampleRate;
 	spec.numChannels	  = getTotalNumInputChannels();
 
-	mDistortionModule.prepare(spec);
-	mDelayModule.prepare(spec, 2000);
-	mPanner.prepare(spec);
+	// The host sets the precision before it prepares, every change comes with a new prepareToPlay()
+	if (isUsingDoublePrecision())
+		prepareModules(mDoubleModules, spec);
+	else
+		prepareModules(mFloatModules, spec);
+
+	// The levels start at their parameter values, later changes ramp
+	mInput.reset(sampleRate, levelSmoothingSeconds);
+	mOutput.reset(sampleRate, levelSmoothingSeconds);
 
-	updateParameters();
+	// prepareToPlay() runs outside of the audio callback, the host learns the latency before the first block
+	setLatencySamples(mLatencyInSamples.load());
+
+	// The audio is stopped, the workers of a serial chain can go until the parallel routing is selected
+	if (mParallelRoutingSelected.load())
+		startThreadPool(sampleRate, samplesPerBlock);
+	else
+		mThreadPool.stop();
 }
 
 
-void PluginProcessor::updateParameters()
+void PluginProcessor::startThreadPool(double sampleRate, int samplesPerBlock)
 {
-	updateGainParameter();
-	updateDelayParameter();
-	updateDistortionParameter();
-	updatePannerParameter();
+	// The audio thread takes one branch itself, so one worker less than there are branches or cores
+	const int	 numWorkers	   = juce::jmin(NumEffectSlots - 1, juce::SystemStats::getNumCpus() - 1);
+	const double blockPeriodMs = 1000.0 * samplesPerBlock / sampleRate;
+
+	mThreadPool.start(numWorkers, blockPeriodMs);
 }
 
 
-void PluginProcessor::setParameter(const std::string &name, float value)
+template <typename SampleType>
+void PluginProcessor::prepareModules(EffectModules<SampleType> &modules, const juce::dsp::ProcessSpec &spec)
 {
-	if (name == paramInput)
-		setInput(value);
-	else if (name == paramOutput)
-		setOutput(value);
+	modules.distortion.prepare(spec);
+	modules.delay.setChannelLayout(getChannelLayoutOfBus(true, 0));
+	modules.delay.prepare(spec, 2000);
+	modules.panner.setChannelLayout(getChannelLayoutOfBus(true, 0));
+	modules.panner.prepare(spec);
+
+	modules.chain.prepare(static_cast<int>(spec.numChannels), static_cast<int>(spec.maximumBlockSize));
+
+	// The modules were prepared with their defaults, hand them every parameter again
+	mParameterSnapshot.markAllChanged();
+	applyParameterChanges(modules);
 }
 
 
-bool PluginProcessor::isBusesLayoutSupported(const BusesLayout &layouts) const
+template <typename SampleType>
+void PluginProcessor::applyParameterChanges(EffectModules<SampleType> &modules)
 {
-	if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono() && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
-		return false;
+	bool latencyChanged = false;
 
-	if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
-		return false;
+	mParameterSnapshot.forEachChanged(
+		[this, &modules, &latencyChanged](ParamId id, float value)
+		{
+			// The host already set the value of the last change point, the timed changes lead up to it
+			if (mTimedChanges.hasChangesFor(id))
+				return;
 
-	return true;
+			applyParameter(modules, id, value);
+			latencyChanged |= changesLatency(id);
+		});
+
+	if (latencyChanged)
+		reportLatency(modules);
 }
 
 
-void PluginProcessor::processBlock(juce::AudioBuffer<float> &buffer, juce::MidiBuffer &midiMessages)
+template <typename SampleType>
+void PluginProcessor::applyTimedChanges(EffectModules<SampleType> &modules, int sampleOffset)
 {
-	juce::ignoreUnused(midiMessages);
+	bool latencyChanged = false;
 
-	juce::ScopedNoDenormals noDenormals;
-	auto					totalNumInputChannels  = getTotalNumInputChannels();
-	auto					totalNumOutputChannels = getTotalNumOutputChannels();
+	mTimedChanges.applyUntil(sampleOffset,
+							 [this, &modules, &latencyChanged](ParamId id, float value)
+							 {
+								 applyParameter(modules, id, value);
+								 latencyChanged |= changesLatency(id);
+							 });
 
-	// Apply input gain
-	float					inputLevel			   = mInput.getNextValue();
-	buffer.applyGain(juce::Decibels::decibelsToGain(inputLevel));
+	if (latencyChanged)
+		reportLatency(modules);
+}
 
-	for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
-		buffer.clear(i, 0, buffer.getNumSamples());
 
-	// Processing the distortion
-	mDistortionModule.process(buffer);
+template <typename SampleType>
+void PluginProcessor::reportLatency(EffectModules<SampleType> &modules)
+{
+	// Latency of the oversampling filters and the ADAA, as the chain adds them up. setLatencySamples() locks and calls
+	// the listeners of the host synchronously, so the audio thread only stores it and timerCallback() reports it
+	mLatencyInSamples.store(juce::roundToInt(modules.chain.getLatencyInSamples()), std::memory_order_relaxed);
+}
+
 
-	mDelayModule.process(buffer);
+void PluginProcessor::timerCallback()
+{
+	const int latency = mLatencyInSamples.load(std::memory_order_relaxed);
 
-	mPanner.process(buffer);
+	if (latency != getLatencySamples())
+		setLatencySamples(latency);
 
-	// Apply output gain
-	float outputLevel = mOutput.getNextValue();
-	buffer.applyGain(juce::Decibels::decibelsToGain(outputLevel));
+	// Starting the workers does not touch a batch the audio thread may be running, stopping them would. Switching
+	// back to the serial routing leaves them parked on their atomic wait until the next prepareToPlay()
+	if (mParallelRoutingSelected.load() && mThreadPool.getNumWorkers() == 0 && getSampleRate() > 0.0)
+		startThreadPool(getSampleRate(), getBlockSize());
 }
 
 
-juce::AudioProcessorEditor *PluginProcessor::createEditor()
+template <typename SampleType>
+void PluginProcessor::applyParameter(EffectModules<SampleType> &modules, ParamId id, float value)
 {
-	// We create a generic audio processor editor here, so we can work with the processing
-	// without concerning about the UI at first!
-
-	return new juce::GenericAudioProcessorEditor(*this);
+	// Every module looks the ID up in its own dispatch table and ignores the ones it does not use.
+	// Shared parameters (math precision) are handled by several modules.
+	setParameter(modules, id, value);
+	modules.distortion.setParameter(id, value);
+	modules.delay.setParameter(id, value);
+	modules.panner.setParameter(id, value);
 }
 
 
-template <typename EffectType, size_t N>
-void PluginProcessor::updateEffectParameters(EffectType &effect, const std::array<const char *, N> &parameters)
+template <typename SampleType>
+void PluginProcessor::setParameter(EffectModules<SampleType> &modules, ParamId id, float value)
 {
-	for (const auto &paramId : parameters)
+	switch (id)
 	{
-		if (auto *rawValue = mValueTreeState.getRawParameterValue(paramId))
-		{
-			effect.setParameter(paramId, rawValue->load());
-		}
+	case ParamId::Input: setInput(value); break;
+	case ParamId::Output: setOutput(value); break;
+	case ParamId::EffectOrder: modules.chain.setOrder(effectOrders[static_cast<size_t>(value)]); break;
+	case ParamId::DistortionBypass: modules.chain.setBypassed(DistortionSlot, value > 0.5f); break;
+	case ParamId::DelayBypass: modules.chain.setBypassed(DelaySlot, value > 0.5f); break;
+	case ParamId::PannerBypass: modules.chain.setBypassed(PannerSlot, value > 0.5f); break;
+	case ParamId::ChainRouting:
+	{
+		const auto routing = static_cast<ChainRouting>(static_cast<int>(value));
+		modules.chain.setRouting(routing);
+		mParallelRoutingSelected.store(routing == ParallelRouting);
+		break;
+	}
+	default: break;
 	}
 }
 
 
-void PluginProcessor::updateGainParameter()
+bool PluginProcessor::isBusesLayoutSupported(const BusesLayout &layouts) const
 {
-	updateEffectParameters(*this, gainParameters);
+	const auto &output = layouts.getMainOutputChannelSet();
+
+	// The surround layouts are handled by the multichannel panner, the other effects process any channel count
+	if (output != juce::AudioChannelSet::mono() && output != juce::AudioChannelSet::stereo() && !MultichannelPanner<float>::isLayoutSupported(output))
+		return false;
+
+	if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
+		return false;
+
+	return true;
 }
 
 
-void PluginProcessor::updateDelayParameter()
+double PluginProcessor::getTailLengthSeconds() const
 {
-	updateEffectParameters(mDelayModule, delayParameters);
+	return isUsingDoublePrecision() ? mDoubleModules.chain.getTailLengthSeconds() : mFloatModules.chain.getTailLengthSeconds();
+}
 
-	// Handle special type conversion for delay type
-	auto delayMode = static_cast<int>(mValueTreeState.getRawParameterValue(paramDelayModel)->load());
-	switch (delayMode)
-	{
-	case 0: mDelayModule.setDelayType(DelayType::SingleTap); break;
-	case 1: mDelayModule.setDelayType(DelayType::PingPong); break;
-	default: break;
-	}
+
+void PluginProcessor::processBlock(juce::AudioBuffer<float> &buffer, juce::MidiBuffer &midiMessages)
+{
+	juce::ignoreUnused(midiMessages);
+	processBlockWithModules(buffer, mFloatModules);
 }
 
 
-void PluginProcessor::updateDistortionParameter()
+void PluginProcessor::processBlock(juce::AudioBuffer<double> &buffer, juce::MidiBuffer &midiMessages)
 {
-	mDistortionModule.setDrive(mValueTreeState.getRawParameterValue(paramDistortionDrive)->load());
-	mDistortionModule.setOutput(mValueTreeState.getRawParameterValue(paramOutput)->load());
-	mDistortionModule.setMix(mValueTreeState.getRawParameterValue(paramMixDistortion)->load());
+	juce::ignoreUnused(midiMessages);
+	processBlockWithModules(buffer, mDoubleModules);
+}
 
-	auto model = static_cast<int>(mValueTreeState.getRawParameterValue(paramDistortionType)->load());
-	switch (model)
-	{
-	case 0:
-	{
-		mDistortionModule.setCurrentDistortionType(DistortionType::hardClipping);
-		break;
-	}
-	case 1:
+
+template <typename SampleType>
+void PluginProcessor::processBlockWithModules(juce::AudioBuffer<SampleType> &buffer, EffectModules<SampleType> &modules)
+{
+#if MULTIEFFECT_PROFILING
+	mTelemetry.beginBlock();
+#endif
+
+	RealtimeSafety::ScopedRealtimeSection realtimeSection;
+	ScopedProfilingProbe				  blockProbe(&mTelemetry, ProfilingTelemetry::processBlockProbe, buffer.getNumSamples());
+	juce::ScopedNoDenormals				  noDenormals;
+
+	applyParameterChanges(modules);
+
+	auto totalNumInputChannels	= getTotalNumInputChannels();
+	auto totalNumOutputChannels = getTotalNumOutputChannels();
+
+	for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
+		buffer.clear(i, 0, buffer.getNumSamples());
+
+	if (mTimedChanges.isEmpty())
 	{
-		mDistortionModule.setCurrentDistortionType(DistortionType::softClipping);
-		break;
+		processSubBlock(buffer, modules);
+		return;
 	}
-	case 2:
+
+	// Split at the change points. The parts refer to the host buffer, nothing is copied
+	const int numSamples  = buffer.getNumSamples();
+	int		  startSample = 0;
+
+	while (startSample < numSamples)
 	{
-		mDistortionModule.setCurrentDistortionType(DistortionType::saturation);
-		break;
-	}
-	default: break;
+		applyTimedChanges(modules, startSample);
+
+		int endSample = juce::jmin(numSamples, juce::jmax(startSample + minSubBlockSize, mTimedChanges.getNextOffset()));
+
+		if (numSamples - endSample < minSubBlockSize)
+			endSample = numSamples;
+
+		juce::AudioBuffer<SampleType> subBlock(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), startSample, endSample - startSample);
+		processSubBlock(subBlock, modules);
+
+		startSample = endSample;
 	}
+
+	// Points in the last few samples or past the block hold from the next block on
+	applyTimedChanges(modules, std::numeric_limits<int>::max());
+	mTimedChanges.clear();
 }
 
 
-void PluginProcessor::updatePannerParameter()
+template <typename SampleType>
+void PluginProcessor::processSubBlock(juce::AudioBuffer<SampleType> &buffer, EffectModules<SampleType> &modules)
 {
-	// Always set common parameters
-	updateEffectParameters(mPanner, pannerCommonParameters);
+	// Apply input gain
+	applyLevelRamp(buffer, mInput);
 
-	if (mNumInputChannels == 1) // Mono
-	{
-		updateEffectParameters(mPanner, pannerMonoParameters);
-	}
-	else // Stereo
+	// Silent input and every effect past its tail, the block stays silent without running the chain. The output
+	// level keeps its timing.
+	if (modules.chain.isIdle() && SilenceDetector<SampleType>::isSilent(buffer))
 	{
-		updateEffectParameters(mPanner, pannerStereoParameters);
+		mOutput.skip(buffer.getNumSamples());
+		return;
 	}
+
+	// Processing the effects in the order chosen by the user
+	modules.chain.process(buffer);
+
+	// Apply output gain
+	applyLevelRamp(buffer, mOutput);
+}
+
+
+template <typename SampleType>
+void PluginProcessor::applyLevelRamp(juce::AudioBuffer<SampleType> &buffer, juce::SmoothedValue<float> &level)
+{
+	const int  numSamples = buffer.getNumSamples();
+	const auto startGain  = static_cast<SampleType>(juce::Decibels::decibelsToGain(level.getCurrentValue()));
+	const auto endGain	  = static_cast<SampleType>(juce::Decibels::decibelsToGain(level.skip(numSamples)));
+
+	// A constant level is a plain gain
+	buffer.applyGainRamp(0, numSamples, startGain, endGain);
+}
+
+
+juce::AudioProcessorEditor *PluginProcessor::createEditor()
+{
+	// We create a generic audio processor editor here, so we can work with the processing
+	// without concerning about the UI at first!
+
+	return new juce::GenericAudioProcessorEditor(*this);
 }
 
 
@@ -243,70 +357,44 @@ juce::AudioProcessorValueTreeState::ParameterLayout PluginProcessor::createParam
 {
 	std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
 
-	// add parameters here
-	auto input			 = std::make_unique<juce::AudioParameterFloat>(paramInput, inputGainName, inputMinValue, inputMaxValue, inputDefaultValue);
-	auto output			 = std::make_unique<juce::AudioParameterFloat>(paramOutput, outputName, outputMinValue, outputMaxValue, outputDefaultValue);
-
-	// Distortion
-	auto distModel		 = std::make_unique<juce::AudioParameterChoice>(paramDistortionType, distortionTypeName, distortionTypeArray, 0);
-	auto drive			 = std::make_unique<juce::AudioParameterFloat>(paramDistortionDrive, distortionDriveName, distortionDriveMin, distortionDriveMax, distortionDriveDefault);
-	auto blendDistortion = std::make_unique<juce::AudioParameterFloat>(paramMixDistortion, distortionMixName, mixMinValue, mixMaxValue, mixDefaultValue);
-
-	// Delay
-	auto delayModel		 = std::make_unique<juce::AudioParameterChoice>(paramDelayModel, delayTypeName, delayTypeArray, 0);
-	auto blendDelay		 = std::make_unique<juce::AudioParameterFloat>(paramMixDelay, delayMixName, mixMinValue, mixMaxValue, mixDefaultValue);
-	auto delayTimeLeft	 = std::make_unique<juce::AudioParameterFloat>(paramDelayTimeLeft, delayTimeNameLeft, delayTimeMin, delayTimeMax, delayTimeDefault);
-	auto delayTimeRight	 = std::make_unique<juce::AudioParameterFloat>(paramDelayTimeRight, delayTimeNameRight, delayTimeMin, delayTimeMax, delayTimeDefault);
-	auto delayFeedback	 = std::make_unique<juce::AudioParameterFloat>(paramDelayFeedback, delayFeedbackName, delayFeedbackMin, delayFeedbackMax, delayFeedbackDefault);
-
-	// Panner
-	auto monoPanValue	 = std::make_unique<juce::AudioParameterFloat>(paramMonoPanValue, monoPanValueName, monoPanValueMin, monoPanValueMax, monoPanValueDefault);
-	auto stereoLeftPanValue =
-		std::make_unique<juce::AudioParameterFloat>(paramStereoLeftPanValue, stereoLeftPanValueName, stereoLeftPanValueMin, stereoLeftPanValueMax, stereoLeftPanValueDefault);
-	auto stereoRightPanValue =
-		std::make_unique<juce::AudioParameterFloat>(paramStereoRightPanValue, stereoRightPanValueName, stereoRightPanValueMin, stereoRightPanValueMax, stereoRightPanValueDefault);
-	auto monoLfoFreq = std::make_unique<juce::AudioParameterFloat>(paramMonoLfoFreq, monoLfoFreqName, monoLfoFreqMin, monoLfoFreqMax, monoLfoFreqDefault);
-	auto stereoLeftLfoFreq =
-		std::make_unique<juce::AudioParameterFloat>(paramStereoLeftLfoFreq, stereoLeftLfoFreqName, stereoLeftLfoFreqMin, stereoLeftLfoFreqMax, stereoLeftLfoFreqDefault);
-	auto stereoRightLfoFreq =
-		std::make_unique<juce::AudioParameterFloat>(paramStereoRightLfoFreq, stereoRightLfoFreqName, stereoRightLfoFreqMin, stereoRightLfoFreqMax, stereoRightLfoFreqDefault);
-	auto monoLfoDepth = std::make_unique<juce::AudioParameterFloat>(paramMonoLfoDepth, monoLfoDepthName, monoLfoDepthMin, monoLfoDepthMax, monoLfoDepthDefault);
-	auto stereoLeftLfoDepth =
-		std::make_unique<juce::AudioParameterFloat>(paramStereoLeftLfoDepth, stereoLeftLfoDepthName, stereoLeftLfoDepthMin, stereoLeftLfoDepthMax, stereoLeftLfoDepthDefault);
-	auto stereoRightLfoDepth =
-		std::make_unique<juce::AudioParameterFloat>(paramStereoRightLfoDepth, stereoRightLfoDepthName, stereoRightLfoDepthMin, stereoRightLfoDepthMax, stereoRightLfoDepthDefault);
-	auto pannerLfoEnabled = std::make_unique<juce::AudioParameterBool>(paramPannerLfoEnabled, pannerLfoEnabledName, pannerLfoEnabledDefault);
-
-	// Add all parameters to the parameter list
-	params.push_back(std::move(input));
-	params.push_back(std::move(output));
-	params.push_back(std::move(drive));
-	params.push_back(std::move(blendDistortion));
-	params.push_back(std::move(distModel));
-	params.push_back(std::move(blendDelay));
-	params.push_back(std::move(delayTimeLeft));
-	params.push_back(std::move(delayTimeRight));
-	params.push_back(std::move(delayFeedback));
-	params.push_back(std::move(delayModel));
-	params.push_back(std::move(monoPanValue));
-	params.push_back(std::move(stereoLeftPanValue));
-	params.push_back(std::move(stereoRightPanValue));
-	params.push_back(std::move(monoLfoFreq));
-	params.push_back(std::move(stereoLeftLfoFreq));
-	params.push_back(std::move(stereoRightLfoFreq));
-	params.push_back(std::move(monoLfoDepth));
-	params.push_back(std::move(stereoLeftLfoDepth));
-	params.push_back(std::move(stereoRightLfoDepth));
-	params.push_back(std::move(pannerLfoEnabled));
+	// The registry order is the parameter index order
+	for (const auto &info : parameterRegistry)
+	{
+		switch (info.kind)
+		{
+		case ParameterKind::Float:
+		{
+			params.push_back(std::make_unique<juce::AudioParameterFloat>(info.key, info.name, info.minValue, info.maxValue, info.defaultValue));
+			break;
+		}
+
+		case ParameterKind::Choice:
+		{
+			juce::StringArray choices;
 
-	return {params.begin(), params.end()};
-}
+			for (const auto *choice : info.choices)
+				choices.add(choice);
 
+			params.push_back(std::make_unique<juce::AudioParameterChoice>(info.key, info.name, choices, static_cast<int>(info.defaultValue)));
+			break;
+		}
 
-void PluginProcessor::parameterChanged(const juce::String &parameterID, float newValue)
-{
-	juce::ignoreUnused(parameterID, newValue);
-	updateParameters();
+		case ParameterKind::Int:
+		{
+			params.push_back(std::make_unique<juce::AudioParameterInt>(info.key, info.name, static_cast<int>(info.minValue), static_cast<int>(info.maxValue),
+																	   static_cast<int>(info.defaultValue)));
+			break;
+		}
+
+		case ParameterKind::Bool:
+		{
+			params.push_back(std::make_unique<juce::AudioParameterBool>(info.key, info.name, info.defaultValue > 0.5f));
+			break;
+		}
+		}
+	}
+
+	return {params.begin(), params.end()};
 }
 
 
@@ -10,15 +10,21 @@
 #pragma once
 
 #include <juce_audio_processors/juce_audio_processors.h>
+#include <atomic>
 
 #include "Project.h"
 #include "Parameters.h"
+#include "ParameterSnapshot.h"
+#include "EffectChain.h"
+#include "RealtimeThreadPool.h"
+#include "ProfilingTelemetry.h"
+#include "TimedParameterChanges.h"
 #include "Distortion/Distortion.h"
 #include "Delay/Delay.h"
 #include "Panner/PannerManager.h"
 
 
-class PluginProcessor : public juce::AudioProcessor, public juce::AudioProcessorValueTreeState::Listener
+class PluginProcessor : public juce::AudioProcessor, private juce::Timer
 {
 public:
 	PluginProcessor();
@@ -27,8 +33,6 @@ public:
 
 	juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
-	void												parameterChanged(const juce::String &parameterID, float newValue) override;
-
 	void												prepareToPlay(double sampleRate, int samplesPerBlock) override;
 
 	void												releaseResources() override {}
@@ -37,6 +41,11 @@ public:
 
 	void												processBlock(juce::AudioBuffer<float> &, juce::MidiBuffer &) override;
 
+	// Hosts with a 64 bit mix bus call this one, it runs the double instantiations of the effects without conversion
+	void												processBlock(juce::AudioBuffer<double> &, juce::MidiBuffer &) override;
+
+	bool												supportsDoublePrecisionProcessing() const override { return true; }
+
 	juce::AudioProcessorEditor						   *createEditor() override;
 
 	bool												hasEditor() const override { return true; }
@@ -49,7 +58,7 @@ public:
 
 	bool												isMidiEffect() const override { return false; }
 
-	double												getTailLengthSeconds() const override { return 0.0; }
+	double												getTailLengthSeconds() const override;
 
 	int													getNumPrograms() override { return 1; }
 
@@ -69,42 +78,100 @@ public:
 
 	void setStateInformation(const void *data, int sizeInBytes) override { juce::ignoreUnused(data, sizeInBytes); }
 
+	// Audio thread, before processBlock(): a plain parameter value from a sample offset of the next block on. The block
+	// is split at these offsets, the value the parameter holds at the block start is ignored. False if the queue is full.
+	// Unused hook: the JUCE wrappers do not pass automation offsets, so nothing but the tests calls it so far
+	bool												addParameterChange(ParamId id, int sampleOffset, float value) { return mTimedChanges.add(id, sampleOffset, value); }
+
+	// Shortest part a block is split into, changes closer to the previous split or to the block end are applied late
+	static constexpr int								minSubBlockSize = 32;
+
+	// Ramp time of the input and output levels
+	static constexpr double								levelSmoothingSeconds = 0.02;
+
+	// Timing of every effect and of the whole block, only filled with MULTIEFFECT_PROFILING
+	ProfilingTelemetry &getTelemetry() noexcept { return mTelemetry; }
+
 
 private:
+	// One set of effects per processing precision, only the set of the precision chosen by the host is prepared and processed
+	template <typename SampleType>
+	struct EffectModules
+	{
+		EffectModules();
+
+		Distortion<SampleType>	  distortion;
+		Delay<SampleType>		  delay;
+		PannerManager<SampleType> panner;
+		EffectChain<SampleType>	  chain; // Indexed by EffectSlot
+	};
+
+	template <typename SampleType>
+	void							   prepareModules(EffectModules<SampleType> &modules, const juce::dsp::ProcessSpec &spec);
 
-	void updateParameters();
+	template <typename SampleType>
+	void							   processBlockWithModules(juce::AudioBuffer<SampleType> &buffer, EffectModules<SampleType> &modules);
 
-	void setParameter(const std::string &name, float value);
+	// Gains and effect chain for one part of the block between two change points
+	template <typename SampleType>
+	void							   processSubBlock(juce::AudioBuffer<SampleType> &buffer, EffectModules<SampleType> &modules);
 
-	template <typename EffectType, size_t N>
-	void							   updateEffectParameters(EffectType &effect, const std::array<const char *, N> &parameters);
+	// Moves the smoothed level in decibels on by the block, the gain ramps linearly across it
+	template <typename SampleType>
+	static void						   applyLevelRamp(juce::AudioBuffer<SampleType> &buffer, juce::SmoothedValue<float> &level);
 
-	void							   updateGainParameter();
+	// Pulls the parameters changed since the last block into the modules (audio thread)
+	template <typename SampleType>
+	void							   applyParameterChanges(EffectModules<SampleType> &modules);
 
-	void							   updateDelayParameter();
+	// Applies the timed changes up to the sample offset (audio thread)
+	template <typename SampleType>
+	void							   applyTimedChanges(EffectModules<SampleType> &modules, int sampleOffset);
 
-	void							   updateDistortionParameter();
+	// Stores the latency of the distortion for the timer, the audio thread must not call setLatencySamples()
+	template <typename SampleType>
+	void							   reportLatency(EffectModules<SampleType> &modules);
 
-	void							   updatePannerParameter();
+	// Message thread: hands the latency reported by the audio thread to the host and starts the workers of the
+	// pool once the parallel routing is selected
+	void							   timerCallback() override;
+
+	// Message thread, the workers only run while the parallel routing is selected
+	void							   startThreadPool(double sampleRate, int samplesPerBlock);
+
+	template <typename SampleType>
+	void							   applyParameter(EffectModules<SampleType> &modules, ParamId id, float value);
+
+	// Gains and the routing of the chain
+	template <typename SampleType>
+	void							   setParameter(EffectModules<SampleType> &modules, ParamId id, float value);
 
 	void							   setOutput(float value);
 
 	void							   setInput(float value);
 
 
-	Distortion<float>				   mDistortionModule;
+	EffectModules<float>			   mFloatModules;
 
-	Delay<float>					   mDelayModule;
+	EffectModules<double>			   mDoubleModules;
 
-	PannerManager<float>			   mPanner;
+	RealtimeThreadPool				   mThreadPool; // Runs the branches of the parallel routing
+
+	ProfilingTelemetry				   mTelemetry;
 
 	juce::SmoothedValue<float>		   mInput;
 
 	juce::SmoothedValue<float>		   mOutput;
 
-	int								   mNumInputChannels{0};
-
 	juce::AudioProcessorValueTreeState mValueTreeState;
 
+	ParameterSnapshot				   mParameterSnapshot;
+
+	TimedParameterChanges			   mTimedChanges;
+
+	std::atomic<int>				   mLatencyInSamples{0};
+
+	std::atomic<bool>				   mParallelRoutingSelected{false};
+
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PluginProcessor)
 };
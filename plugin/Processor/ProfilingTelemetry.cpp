@@ -0,0 +1,136 @@
+/*
+  ==============================================================================
+
+	Module			ProfilingTelemetry
+	Description		Timing probes on the audio thread and their statistics for the editor or tests
+
+  ==============================================================================
+*/
+
+#include "ProfilingTelemetry.h"
+
+#include <algorithm>
+#include <bit>
+
+
+void ProfilingTelemetry::beginBlock() noexcept
+{
+	if (--mBlocksUntilSample > 0)
+	{
+		mBlockSampled = false;
+		return;
+	}
+
+	mBlocksUntilSample = mSamplingInterval.load(std::memory_order_relaxed);
+	mBlockSampled	   = true;
+}
+
+
+void ProfilingTelemetry::record(int probe, uint64_t ticks, int numSamples) noexcept
+{
+	if (probe < 0 || probe >= maxNumProbes)
+		return;
+
+	const uint32_t writeIndex = mWriteIndex.load(std::memory_order_relaxed);
+
+	if (writeIndex - mReadIndex.load(std::memory_order_acquire) >= static_cast<uint32_t>(ringSize))
+	{
+		mNumDropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	mRing[writeIndex & (ringSize - 1)] = {ticks, static_cast<uint32_t>(numSamples), static_cast<uint32_t>(probe)};
+	mWriteIndex.store(writeIndex + 1, std::memory_order_release);
+}
+
+
+void ProfilingTelemetry::collect()
+{
+	const uint32_t writeIndex = mWriteIndex.load(std::memory_order_acquire);
+	uint32_t	   readIndex  = mReadIndex.load(std::memory_order_relaxed);
+
+	for (; readIndex != writeIndex; ++readIndex)
+	{
+		const auto &measurement = mRing[readIndex & (ringSize - 1)];
+		auto	   &histogram	= mHistograms[measurement.probe];
+
+		histogram.buckets[getBucket(measurement.ticks)]++;
+		histogram.count++;
+		histogram.minTicks	 = std::min(histogram.minTicks, measurement.ticks);
+		histogram.maxTicks	 = std::max(histogram.maxTicks, measurement.ticks);
+		histogram.sumTicks	+= static_cast<double>(measurement.ticks);
+		histogram.sumSamples += static_cast<double>(measurement.numSamples);
+	}
+
+	// Hands the slots back to the audio thread
+	mReadIndex.store(readIndex, std::memory_order_release);
+}
+
+
+ProfilingTelemetry::Statistics ProfilingTelemetry::getStatistics(int probe) const
+{
+	if (probe < 0 || probe >= maxNumProbes || mHistograms[probe].count == 0)
+		return {};
+
+	const auto &histogram = mHistograms[probe];
+
+	Statistics	statistics;
+	statistics.count			  = histogram.count;
+	statistics.minTicks			  = histogram.minTicks;
+	statistics.maxTicks			  = histogram.maxTicks;
+	statistics.meanTicks		  = histogram.sumTicks / static_cast<double>(histogram.count);
+	statistics.meanTicksPerSample = histogram.sumSamples > 0.0 ? histogram.sumTicks / histogram.sumSamples : 0.0;
+
+	// First bucket that reaches 99 % of the measurements, never outside of the measured range
+	const uint64_t rank			  = (histogram.count * 99 + 99) / 100;
+	uint64_t	   seen			  = 0;
+
+	for (int bucket = 0; bucket < numBuckets; ++bucket)
+	{
+		seen += histogram.buckets[bucket];
+
+		if (seen >= rank)
+		{
+			statistics.p99Ticks = std::clamp(getBucketValue(bucket), histogram.minTicks, histogram.maxTicks);
+			break;
+		}
+	}
+
+	return statistics;
+}
+
+
+void ProfilingTelemetry::resetStatistics()
+{
+	collect();
+
+	mHistograms = {};
+	mNumDropped.store(0, std::memory_order_relaxed);
+}
+
+
+int ProfilingTelemetry::getBucket(uint64_t ticks) noexcept
+{
+	// Values below numSubBuckets are exact, above each power of two is split into numSubBuckets
+	if (ticks < static_cast<uint64_t>(numSubBuckets))
+		return static_cast<int>(ticks);
+
+	const int exponent	= std::bit_width(ticks) - 1 - subBucketBits;
+	const int subBucket = static_cast<int>((ticks >> exponent) & (numSubBuckets - 1));
+
+	return (exponent + 1) * numSubBuckets + subBucket;
+}
+
+
+uint64_t ProfilingTelemetry::getBucketValue(int bucket) noexcept
+{
+	if (bucket < numSubBuckets)
+		return static_cast<uint64_t>(bucket);
+
+	const int	   exponent	 = bucket / numSubBuckets - 1;
+	const uint64_t subBucket = static_cast<uint64_t>(bucket % numSubBuckets);
+	const uint64_t lower	 = (static_cast<uint64_t>(numSubBuckets) | subBucket) << exponent;
+
+	// Middle of the bucket
+	return lower + ((uint64_t(1) << exponent) >> 1);
+}
@@ -0,0 +1,174 @@
+/*
+  ==============================================================================
+
+	Module			ProfilingTelemetry
+	Description		Timing probes on the audio thread and their statistics for the editor or tests
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+	#include <x86intrin.h>
+#endif
+
+// Set by the CMake option MULTIEFFECT_ENABLE_PROFILING, without it the probes compile to nothing
+#ifndef MULTIEFFECT_PROFILING
+	#define MULTIEFFECT_PROFILING 0
+#endif
+
+
+//==============================================================================
+// The audio thread is the only producer: every probe pushes one measurement
+// (probe, ticks, samples) into a fixed size single producer / single consumer
+// ring, a full ring drops the measurement and counts it. A reader (editor timer
+// or test) calls collect() to drain the ring into a histogram per probe and
+// reads min / mean / p99 / max from it, so the audio thread never touches the
+// histograms.
+//
+// Reading the clock costs 10 - 30 ns, on small blocks the probes of every
+// block would take several percent. So only every n-th block is measured
+// (beginBlock() decides, the default of 16 keeps the cost far below 1 % even
+// at 32 samples), the statistics are those of the measured blocks.
+//
+// Ticks are CPU cycles (rdtsc) on x86 and nanoseconds of the steady clock
+// elsewhere. The histogram has 8 linear buckets per power of two, the p99 is
+// accurate to 1/16 of its value.
+//==============================================================================
+
+class ProfilingTelemetry
+{
+public:
+	ProfilingTelemetry() = default;
+	~ProfilingTelemetry() = default;
+
+	static constexpr int maxNumProbes	   = 16;
+	static constexpr int processBlockProbe = maxNumProbes - 1; // The whole block, the effects use their index in the chain
+
+	struct Statistics
+	{
+		uint64_t count{0};
+		uint64_t minTicks{0};
+		uint64_t maxTicks{0};
+		uint64_t p99Ticks{0};
+		double	 meanTicks{0.0};
+		double	 meanTicksPerSample{0.0};
+	};
+
+	static uint64_t now() noexcept
+	{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+		return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+		return __rdtsc();
+#else
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+	}
+
+	// Audio thread only, at the top of every block. Decides if the probes of this block measure
+	void		 beginBlock() noexcept;
+
+	bool		 isBlockSampled() const noexcept { return mBlockSampled; }
+
+	// Any thread, 1 measures every block
+	void		 setSamplingInterval(int numBlocks) noexcept { mSamplingInterval.store(numBlocks < 1 ? 1 : numBlocks, std::memory_order_relaxed); }
+
+	// Audio thread only
+	void		 record(int probe, uint64_t ticks, int numSamples) noexcept;
+
+	// Reader thread only, moves the pending measurements into the histograms
+	void		 collect();
+
+	Statistics	 getStatistics(int probe) const;
+
+	void		 resetStatistics();
+
+	uint64_t	 getNumDropped() const noexcept { return mNumDropped.load(std::memory_order_relaxed); }
+
+private:
+	struct Measurement
+	{
+		uint64_t ticks;
+		uint32_t numSamples;
+		uint32_t probe;
+	};
+
+	static constexpr int	  ringSize			= 4096; // Power of two
+	static constexpr int	  subBucketBits		= 3;
+	static constexpr int	  numSubBuckets		= 1 << subBucketBits;
+	static constexpr int	  numBuckets		= (64 - subBucketBits + 1) * numSubBuckets;
+
+	static int				  getBucket(uint64_t ticks) noexcept;
+	static uint64_t			  getBucketValue(int bucket) noexcept;
+
+	struct Histogram
+	{
+		std::array<uint64_t, numBuckets> buckets{};
+		uint64_t						 count{0};
+		uint64_t						 minTicks{UINT64_MAX};
+		uint64_t						 maxTicks{0};
+		double							 sumTicks{0.0};
+		double							 sumSamples{0.0};
+	};
+
+	std::array<Measurement, ringSize> mRing{};
+
+	alignas(64) std::atomic<uint32_t> mWriteIndex{0};
+	alignas(64) std::atomic<uint32_t> mReadIndex{0};
+
+	std::atomic<uint64_t>			  mNumDropped{0};
+
+	std::atomic<int>				  mSamplingInterval{16};
+
+	int								  mBlocksUntilSample{0}; // Audio thread
+
+	bool							  mBlockSampled{false};	 // Audio thread, read by the workers during the block
+
+	std::array<Histogram, maxNumProbes> mHistograms; // Reader side
+};
+
+
+//==============================================================================
+// Measures its own lifetime and records it on destruction. Without profiling
+// the class is empty and the compiler removes it.
+//==============================================================================
+
+class ScopedProfilingProbe
+{
+public:
+#if MULTIEFFECT_PROFILING
+	ScopedProfilingProbe(ProfilingTelemetry *telemetry, int probe, int numSamples) noexcept
+		: mTelemetry(telemetry != nullptr && telemetry->isBlockSampled() ? telemetry : nullptr), mStart(0), mProbe(probe), mNumSamples(numSamples)
+	{
+		if (mTelemetry != nullptr)
+			mStart = ProfilingTelemetry::now();
+	}
+
+	~ScopedProfilingProbe()
+	{
+		if (mTelemetry != nullptr)
+			mTelemetry->record(mProbe, ProfilingTelemetry::now() - mStart, mNumSamples);
+	}
+
+private:
+	ProfilingTelemetry *mTelemetry;
+	uint64_t			mStart;
+	int					mProbe;
+	int					mNumSamples;
+#else
+	ScopedProfilingProbe(ProfilingTelemetry *, int, int) noexcept {}
+#endif
+
+public:
+	ScopedProfilingProbe(const ScopedProfilingProbe &)			  = delete;
+	ScopedProfilingProbe &operator=(const ScopedProfilingProbe &) = delete;
+};
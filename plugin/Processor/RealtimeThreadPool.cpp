@@ -0,0 +1,159 @@
+/*
+  ==============================================================================
+
+	Module			RealtimeThreadPool
+	Description		Pre-spawned worker threads sharing small batches of tasks with the audio thread
+
+  ==============================================================================
+*/
+
+#include "RealtimeThreadPool.h"
+
+
+RealtimeThreadPool::~RealtimeThreadPool()
+{
+	stop();
+}
+
+
+void RealtimeThreadPool::start(int numWorkers, double blockPeriodMs)
+{
+	numWorkers = juce::jlimit(0, maxNumWorkers, numWorkers);
+
+	if (numWorkers == static_cast<int>(mWorkers.size()) && blockPeriodMs == mBlockPeriodMs)
+		return;
+
+	stop();
+
+	mShouldExit.store(false);
+	mBlockPeriodMs = blockPeriodMs;
+	mWorkers.reserve(static_cast<size_t>(numWorkers));
+
+	auto options = juce::Thread::RealtimeOptions{}.withPriority(workerPriority);
+
+	if (blockPeriodMs > 0.0)
+		options = options.withPeriodMs(blockPeriodMs);
+
+	for (int index = 0; index < numWorkers; ++index)
+	{
+		auto worker = std::make_unique<Worker>(*this);
+
+		// Without the permission (e.g. no rtprio limit on Linux) the request fails and the worker runs unprivileged
+		if (!worker->startRealtimeThread(options))
+			worker->startThread(juce::Thread::Priority::highest);
+
+		mWorkers.push_back(std::move(worker));
+	}
+
+	mNumWorkers.store(numWorkers, std::memory_order_release);
+}
+
+
+void RealtimeThreadPool::stop()
+{
+	if (mWorkers.empty())
+		return;
+
+	mNumWorkers.store(0, std::memory_order_release);
+	mShouldExit.store(true);
+
+	// A new generation without tasks wakes every worker
+	mTaskState.fetch_add(uint64_t(1) << generationShift);
+	mTaskState.notify_all();
+
+	for (auto &worker : mWorkers)
+		worker->waitForThreadToExit(-1);
+
+	mWorkers.clear();
+}
+
+
+void RealtimeThreadPool::run(int numTasks, Task task, void *context)
+{
+	jassert(numTasks >= 0 && static_cast<uint64_t>(numTasks) <= indexMask);
+
+	if (numTasks <= 0)
+		return;
+
+	// The previous batch is complete, nobody reads the task or the context now
+	mTask	 = task;
+	mContext = context;
+	mNumPendingTasks.store(numTasks, std::memory_order_relaxed);
+
+	const uint64_t generation = (mTaskState.load(std::memory_order_relaxed) >> generationShift) + 1;
+	mTaskState.store((generation << generationShift) | (static_cast<uint64_t>(numTasks) << numTasksShift));
+
+	// Only parked workers need the (system) call, spinning ones see the new state themselves
+	if (mNumParkedWorkers.load() > 0)
+		mTaskState.notify_all();
+
+	executeTasks(generation & (UINT64_MAX >> generationShift));
+
+	// The remaining tasks are running on the workers
+	while (mNumPendingTasks.load(std::memory_order_acquire) > 0)
+		std::this_thread::yield();
+}
+
+
+void RealtimeThreadPool::workerLoop()
+{
+	// Same denormal handling as on the audio thread, the tasks are audio processing
+	juce::ScopedNoDenormals noDenormals;
+
+	uint64_t				lastGeneration = mTaskState.load() >> generationShift;
+
+	while (!mShouldExit.load(std::memory_order_relaxed))
+	{
+		uint64_t state = mTaskState.load(std::memory_order_acquire);
+
+		for (int spin = 0; spin < numSpins && (state >> generationShift) == lastGeneration; ++spin)
+		{
+			std::this_thread::yield();
+			state = mTaskState.load(std::memory_order_acquire);
+		}
+
+		if ((state >> generationShift) == lastGeneration)
+		{
+			// Parked until run() or stop() publishes a new generation
+			mNumParkedWorkers.fetch_add(1);
+
+			while ((state >> generationShift) == lastGeneration && !mShouldExit.load())
+			{
+				mTaskState.wait(state);
+				state = mTaskState.load(std::memory_order_acquire);
+			}
+
+			mNumParkedWorkers.fetch_sub(1);
+		}
+
+		lastGeneration = state >> generationShift;
+
+		if (!mShouldExit.load(std::memory_order_relaxed))
+			executeTasks(lastGeneration);
+	}
+}
+
+
+void RealtimeThreadPool::executeTasks(uint64_t generation)
+{
+	uint64_t state = mTaskState.load(std::memory_order_acquire);
+
+	while (true)
+	{
+		const uint64_t taskIndex = state & indexMask;
+		const uint64_t numTasks	 = (state >> numTasksShift) & indexMask;
+
+		// A later batch has started or all tasks are taken
+		if ((state >> generationShift) != generation || taskIndex >= numTasks)
+			return;
+
+		if (!mTaskState.compare_exchange_weak(state, state + 1, std::memory_order_acq_rel, std::memory_order_acquire))
+			continue;
+
+		// The batch cannot end before this task is done, so the task and the context stay valid
+		mTask(mContext, static_cast<int>(taskIndex));
+		mNumPendingTasks.fetch_sub(1, std::memory_order_release);
+
+		state = mTaskState.load(std::memory_order_acquire);
+	}
+}
@@ -0,0 +1,114 @@
+/*
+  ==============================================================================
+
+	Module			RealtimeThreadPool
+	Description		Pre-spawned worker threads sharing small batches of tasks with the audio thread
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+//==============================================================================
+// The workers are spawned once in start() (message thread) and wait for work
+// by spinning for a short while and then parking on an atomic wait. The audio
+// thread waits for them at the end of every batch, so they ask for real-time
+// scheduling and fall back to the highest normal priority without permission.
+// run() publishes a batch of tasks in a single atomic word
+//
+//	bits  0 - 15	index of the next task
+//	bits 16 - 31	number of tasks
+//	bits 32 - 63	generation of the batch
+//
+// The calling thread and all awake workers take the next task with a compare
+// exchange on that word until none is left, so an idle thread steals whatever
+// a slow one has not started yet. run() returns once every task is done and
+// neither locks nor allocates, the task is passed as a function pointer and a
+// context pointer.
+//==============================================================================
+
+class RealtimeThreadPool
+{
+public:
+	RealtimeThreadPool() = default;
+	~RealtimeThreadPool();
+
+	static constexpr int maxNumWorkers = 15;
+
+	using Task						   = void (*)(void *context, int taskIndex);
+
+	// Message thread, restarts the workers if their number or the block period changes. The period (of a block at
+	// the host rate) lets the system schedule them like the audio thread, 0 if it is not known yet
+	void				 start(int numWorkers, double blockPeriodMs = 0.0);
+
+	void				 stop();
+
+	// Any thread, 0 until start() has spawned every worker
+	int					 getNumWorkers() const noexcept { return mNumWorkers.load(std::memory_order_acquire); }
+
+	// Runs task(context, index) for every index below numTasks on the workers and the calling thread
+	void				 run(int numTasks, Task task, void *context);
+
+	template <typename Function>
+	void				 run(int numTasks, Function &function)
+	{
+		run(numTasks, [](void *context, int taskIndex) { (*static_cast<Function *>(context))(taskIndex); }, &function);
+	}
+
+private:
+	// juce::Thread knows how to ask every platform for real-time scheduling, std::thread does not
+	class Worker : public juce::Thread
+	{
+	public:
+		explicit Worker(RealtimeThreadPool &pool) : juce::Thread("Realtime pool worker"), mPool(pool) {}
+
+		void run() override { mPool.workerLoop(); }
+
+	private:
+		RealtimeThreadPool &mPool;
+	};
+
+	using WorkerPointer = std::unique_ptr<Worker>;
+
+	void					   workerLoop();
+
+	// Executes tasks of the generation until none is left
+	void					   executeTasks(uint64_t generation);
+
+	static constexpr uint64_t  indexMask	   = 0xFFFF;
+	static constexpr int	   numTasksShift   = 16;
+	static constexpr int	   generationShift = 32;
+
+	// Spins before parking, long enough to catch the next block of a small buffer size
+	static constexpr int	   numSpins		   = 4096;
+
+	// Of RealtimeOptions (0 - 10), below the audio thread of the host at the default of 5
+	static constexpr int	   workerPriority  = 4;
+
+	std::vector<WorkerPointer> mWorkers;
+
+	std::atomic<int>		   mNumWorkers{0};
+
+	double					   mBlockPeriodMs{0.0};
+
+	std::atomic<uint64_t>	   mTaskState{0};
+
+	std::atomic<int>		   mNumPendingTasks{0};
+
+	std::atomic<int>		   mNumParkedWorkers{0};
+
+	std::atomic<bool>		   mShouldExit{false};
+
+	Task					   mTask{nullptr};
+
+	void					  *mContext{nullptr};
+};
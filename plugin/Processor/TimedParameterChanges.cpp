@@ -0,0 +1,45 @@
+/*
+  ==============================================================================
+
+	Module			TimedParameterChanges
+	Description		Parameter changes at sample offsets within the next block
+
+  ==============================================================================
+*/
+
+#include "TimedParameterChanges.h"
+
+
+bool TimedParameterChanges::add(ParamId id, int sampleOffset, float value) noexcept
+{
+	jassert(toIndex(id) < numParameters);
+
+	if (toIndex(id) >= numParameters || mNumChanges >= maxNumChanges)
+		return false;
+
+	// Points before the block count from its start
+	sampleOffset = juce::jmax(0, sampleOffset);
+
+	// Usually appended, points of several parameters are merged in by moving the later ones back
+	int position = mNumChanges;
+
+	while (position > mReadPosition && mChanges[static_cast<size_t>(position - 1)].sampleOffset > sampleOffset)
+	{
+		mChanges[static_cast<size_t>(position)] = mChanges[static_cast<size_t>(position - 1)];
+		--position;
+	}
+
+	mChanges[static_cast<size_t>(position)] = {sampleOffset, id, value};
+	++mNumChanges;
+
+	mQueuedIds.set(toIndex(id));
+	return true;
+}
+
+
+void TimedParameterChanges::clear() noexcept
+{
+	mNumChanges	  = 0;
+	mReadPosition = 0;
+	mQueuedIds.reset();
+}
@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+	Module			TimedParameterChanges
+	Description		Parameter changes at sample offsets within the next block
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "Parameters.h"
+
+#include <array>
+#include <bitset>
+#include <limits>
+
+
+//==============================================================================
+// The JUCE wrappers only hand over the value of a parameter at the start of a
+// block. A wrapper or host bridge that knows the sample offsets of the
+// automation points (e.g. the point queues of VST3 or the events of CLAP)
+// queues them here before the block, and the processor splits the block at
+// these offsets. Everything runs on the audio thread: add() before the block,
+// applyUntil() at every split and clear() after the block, so no
+// synchronisation is needed. The changes are kept sorted by their offset,
+// changes at the same offset keep the order they were added in. No such
+// wrapper exists in the plugin yet, only the tests queue changes.
+//==============================================================================
+
+class TimedParameterChanges
+{
+public:
+	TimedParameterChanges()	 = default;
+	~TimedParameterChanges() = default;
+
+	static constexpr int maxNumChanges = 512;
+
+	// Plain value as for EffectBase::setParameter(), false if the queue is full
+	bool				 add(ParamId id, int sampleOffset, float value) noexcept;
+
+	bool				 isEmpty() const noexcept { return mReadPosition == mNumChanges; }
+
+	// True if the parameter has a change queued for this block, its value at the block start is ignored then
+	bool				 hasChangesFor(ParamId id) const noexcept { return mQueuedIds[toIndex(id)]; }
+
+	// Offset of the first change that was not applied yet, max int without one
+	int					 getNextOffset() const noexcept
+	{
+		return isEmpty() ? std::numeric_limits<int>::max() : mChanges[static_cast<size_t>(mReadPosition)].sampleOffset;
+	}
+
+	// Calls function(ParamId, value) for every change up to and including the sample offset
+	template <typename Function>
+	void				 applyUntil(int sampleOffset, Function &&function);
+
+	void				 clear() noexcept;
+
+private:
+	struct Change
+	{
+		int		sampleOffset{0};
+		ParamId id{ParamId::NumParameters};
+		float	value{0.0f};
+	};
+
+	std::array<Change, maxNumChanges> mChanges{};
+
+	int								  mNumChanges{0};
+
+	int								  mReadPosition{0};
+
+	std::bitset<numParameters>		  mQueuedIds;
+};
+
+
+template <typename Function>
+void TimedParameterChanges::applyUntil(int sampleOffset, Function &&function)
+{
+	for (; mReadPosition < mNumChanges && mChanges[static_cast<size_t>(mReadPosition)].sampleOffset <= sampleOffset; ++mReadPosition)
+	{
+		const auto &change = mChanges[static_cast<size_t>(mReadPosition)];
+		function(change.id, change.value);
+	}
+}
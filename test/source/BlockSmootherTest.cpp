@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include "BlockSmoother.h"
+
+
+TEST(BlockSmoother, ConstantValueSkipsTheRamp)
+{
+	juce::SmoothedValue<float> smoother;
+	smoother.reset(1000.0, 0.1);
+	smoother.setCurrentAndTargetValue(0.5f);
+
+	BlockSmoother<float> ramp;
+	ramp.prepare(16);
+	ramp.process(smoother, 16);
+
+	EXPECT_FALSE(ramp.isSmoothing());
+	EXPECT_FLOAT_EQ(ramp.getValue(), 0.5f);
+	EXPECT_FLOAT_EQ(ramp.getValue(7), 0.5f);
+
+	std::array<float, 16> data;
+	data.fill(2.0f);
+	ramp.multiply(data.data(), 16);
+
+	for (float sample : data)
+		EXPECT_FLOAT_EQ(sample, 1.0f);
+}
+
+
+TEST(BlockSmoother, RampMatchesTheSmoother)
+{
+	juce::SmoothedValue<float> smoother, reference;
+
+	for (auto *value : {&smoother, &reference})
+	{
+		value->reset(1000.0, 0.1); // 100 steps
+		value->setCurrentAndTargetValue(0.0f);
+		value->setTargetValue(1.0f);
+	}
+
+	BlockSmoother<double> ramp;
+	ramp.prepare(64);
+
+	// The smoother advances once per block, no matter how many channels use the ramp
+	for (int block = 0; block < 2; ++block)
+	{
+		ramp.process(smoother, 64, [](float value) { return 2.0f * value; });
+		EXPECT_TRUE(ramp.isSmoothing());
+
+		for (int i = 0; i < 64; ++i)
+			ASSERT_DOUBLE_EQ(ramp.getValue(i), 2.0 * static_cast<double>(reference.getNextValue())) << "block " << block << ", sample " << i;
+
+		EXPECT_DOUBLE_EQ(ramp.getValue(), ramp.getValue(63));
+	}
+
+	ramp.process(smoother, 64);
+	EXPECT_FALSE(ramp.isSmoothing());
+	EXPECT_DOUBLE_EQ(ramp.getValue(), 1.0);
+}
+
+
+TEST(BlockSmoother, MixFollowsTheRamp)
+{
+	juce::SmoothedValue<float> smoother;
+	smoother.reset(1000.0, 0.004); // 4 steps
+	smoother.setCurrentAndTargetValue(0.0f);
+	smoother.setTargetValue(1.0f);
+
+	BlockSmoother<float> ramp;
+	ramp.prepare(4);
+	ramp.process(smoother, 4);
+
+	std::array<float, 4> dry{1.0f, 1.0f, 1.0f, 1.0f};
+	std::array<float, 4> wet{0.0f, 0.0f, 0.0f, 0.0f};
+	ramp.mix(dry.data(), wet.data(), 4);
+
+	for (int i = 0; i < 4; ++i)
+		EXPECT_NEAR(dry[i], 1.0f - 0.25f * static_cast<float>(i + 1), 1.0e-6f);
+
+	std::array<float, 4> destination{};
+	ramp.addWithMultiply(destination.data(), dry.data(), 4);
+	EXPECT_NEAR(destination[1], 0.5f * 0.5f, 1.0e-6f);
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include "CircularBuffer.h"
+
+#include <numeric>
+
+
+TEST(CircularBuffer, CapacityIsPowerOfTwo)
+{
+	CircularBuffer<float> buffer;
+	buffer.prepare(2, 1000);
+
+	EXPECT_EQ(buffer.getCapacity(), 1024);
+	EXPECT_EQ(buffer.getNumChannels(), 2);
+	EXPECT_EQ(buffer.getWritePosition(), 0);
+
+	buffer.prepare(1, 1024);
+	EXPECT_EQ(buffer.getCapacity(), 1024);
+}
+
+
+TEST(CircularBuffer, WrapUsesMask)
+{
+	CircularBuffer<float> buffer;
+	buffer.prepare(1, 16);
+
+	EXPECT_EQ(buffer.wrap(0), 0);
+	EXPECT_EQ(buffer.wrap(17), 1);
+	EXPECT_EQ(buffer.wrap(-1), 15);
+	EXPECT_EQ(buffer.wrap(-17), 15);
+}
+
+
+TEST(CircularBuffer, RegionsSplitAtTheEnd)
+{
+	CircularBuffer<float> buffer;
+	buffer.prepare(1, 16);
+	buffer.advance(12);
+
+	const auto write = buffer.getWriteRegions(8);
+	EXPECT_EQ(write.start1, 12);
+	EXPECT_EQ(write.size1, 4);
+	EXPECT_EQ(write.start2, 0);
+	EXPECT_EQ(write.size2, 4);
+
+	const auto read = buffer.getReadRegions(4, 4);
+	EXPECT_EQ(read.start1, 8);
+	EXPECT_EQ(read.size1, 4);
+	EXPECT_EQ(read.size2, 0);
+}
+
+
+TEST(CircularBuffer, ReadReturnsWrittenBlockAcrossTheWrap)
+{
+	CircularBuffer<float> buffer;
+	buffer.prepare(1, 16);
+	buffer.advance(10);
+
+	std::vector<float> input(12);
+	std::iota(input.begin(), input.end(), 1.0f);
+
+	buffer.write(0, input.data(), static_cast<int>(input.size()));
+	buffer.advance(static_cast<int>(input.size()));
+	EXPECT_EQ(buffer.getWritePosition(), 6);
+
+	std::vector<float> output(input.size());
+	buffer.read(0, output.data(), static_cast<int>(input.size()), static_cast<int>(output.size()));
+
+	EXPECT_EQ(output, input);
+}
+
+
+TEST(CircularBuffer, CopyAdvancesOncePerBlock)
+{
+	CircularBuffer<float> buffer;
+	buffer.prepare(2, 64);
+
+	juce::AudioBuffer<float> block(2, 32);
+	block.clear();
+
+	buffer.copyFromBufferToCircularBuffer(block);
+	EXPECT_EQ(buffer.getWritePosition(), 32);
+}
+
+
+TEST(CircularBuffer, TwoSecondsFitTheMemoryBudget)
+{
+	CircularBuffer<float> buffer;
+	buffer.prepare(2, 96000);
+
+	EXPECT_EQ(buffer.getCapacity(), 131072);
+	EXPECT_LE(static_cast<size_t>(buffer.getCapacity()) * 2 * sizeof(float), CircularBuffer<float>::maxMemoryInBytes);
+}
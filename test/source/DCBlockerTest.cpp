@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include "DCBlocker.h"
+#include "SilenceDetector.h"
+
+
+namespace
+{
+// Runs a constant offset plus a sine through the blocker, returns the mean and the peak of the last 100 ms
+template <typename SampleType>
+std::pair<double, double> blockOffset(double sineFrequency)
+{
+	constexpr double	  sampleRate = 48000.0;
+	constexpr int		  blockSize	 = 480;
+
+	DCBlocker<SampleType> blocker;
+	blocker.prepare(sampleRate, 2);
+
+	std::vector<SampleType> block(blockSize);
+	double					sum = 0.0, peak = 0.0;
+	int						n	= 0;
+
+	// One second, the blocker settles within 0.22 s
+	for (int blockIndex = 0; blockIndex < 100; ++blockIndex)
+	{
+		for (int i = 0; i < blockSize; ++i, ++n)
+			block[i] = static_cast<SampleType>(0.5 + 0.25 * std::sin(juce::MathConstants<double>::twoPi * sineFrequency * n / sampleRate));
+
+		blocker.process(block.data(), blockSize, 1);
+
+		if (blockIndex >= 90)
+		{
+			for (auto sample : block)
+			{
+				sum += static_cast<double>(sample);
+				peak = std::max(peak, std::abs(static_cast<double>(sample)));
+			}
+		}
+	}
+
+	return {sum / (10.0 * blockSize), peak};
+}
+} // namespace
+
+
+TEST(DCBlocker, RemovesTheOffsetAndKeepsTheSignal)
+{
+	const auto [floatMean, floatPeak]	= blockOffset<float>(1000.0);
+	const auto [doubleMean, doublePeak] = blockOffset<double>(1000.0);
+
+	EXPECT_NEAR(floatMean, 0.0, 1.0e-4);
+	EXPECT_NEAR(doubleMean, 0.0, 1.0e-6);
+
+	// 1 kHz lies two decades above the corner
+	EXPECT_NEAR(floatPeak, 0.25, 1.0e-3);
+	EXPECT_NEAR(doublePeak, 0.25, 1.0e-3);
+}
+
+
+TEST(DCBlocker, ImpulseDecaysWithinTheTail)
+{
+	constexpr double	sampleRate = 48000.0;
+
+	DCBlocker<double> blocker;
+	blocker.prepare(sampleRate, 1);
+
+	const double tailSeconds = DCBlocker<double>::getTailLengthSeconds(DCBlocker<double>::defaultCutoff, SilenceDetector<double>::threshold);
+	const int	 tailSamples = static_cast<int>(std::ceil(tailSeconds * sampleRate));
+
+	std::vector<double> response(static_cast<size_t>(tailSamples) + 1, 0.0);
+	response[0] = 1.0;
+	blocker.process(response.data(), static_cast<int>(response.size()), 0);
+
+	EXPECT_GT(std::abs(response[static_cast<size_t>(tailSamples / 2)]), SilenceDetector<double>::threshold);
+	EXPECT_LE(std::abs(response.back()), SilenceDetector<double>::threshold);
+}
@@ -9,3 +9,486 @@ TEST(Delay, DelayTypeChange)
 
 	ASSERT_EQ(delay.getDelayType(), DelayType::PingPong);
 }
+
+
+namespace
+{
+// Prepares a mono delay with a fully wet output and lets the delay time smoothing settle
+void prepareWetDelay(Delay<float> &delay, float delayTimeInMS, float feedback)
+{
+	juce::dsp::ProcessSpec spec{48000, 1024, 1};
+	delay.prepare(spec, 100.0f);
+	delay.setMix(1.0f);
+	delay.setFeedback(feedback);
+	delay.setChannelDelayTime(0, delayTimeInMS);
+
+	juce::AudioBuffer<float> silence(1, 256);
+	for (int block = 0; block < 8; ++block)
+	{
+		silence.clear();
+		delay.process(silence);
+	}
+
+	delay.reset();
+}
+} // namespace
+
+
+TEST(Delay, ImpulseArrivesAfterDelayTime)
+{
+	Delay<float> delay;
+	prepareWetDelay(delay, 10.0f, 0.0f);
+
+	// 10 ms at 48 kHz, spread over several blocks
+	constexpr int			 delaySamples = 480;
+	juce::AudioBuffer<float> buffer(1, 256);
+	std::vector<float>		 output;
+
+	for (int block = 0; block < 4; ++block)
+	{
+		buffer.clear();
+		if (block == 0)
+			buffer.setSample(0, 0, 1.0f);
+
+		delay.process(buffer);
+		output.insert(output.end(), buffer.getReadPointer(0), buffer.getReadPointer(0) + buffer.getNumSamples());
+	}
+
+	for (int i = 0; i < static_cast<int>(output.size()); ++i)
+		EXPECT_FLOAT_EQ(output[i], i == delaySamples ? 1.0f : 0.0f) << "sample " << i;
+}
+
+
+TEST(Delay, FeedbackRepeatsDelayedSignal)
+{
+	Delay<float> delay;
+	prepareWetDelay(delay, 5.0f, 0.5f);
+
+	constexpr int			 delaySamples = 240;
+	juce::AudioBuffer<float> buffer(1, 1024);
+	buffer.clear();
+	buffer.setSample(0, 0, 1.0f);
+
+	delay.process(buffer);
+
+	EXPECT_FLOAT_EQ(buffer.getSample(0, delaySamples), 1.0f);
+	EXPECT_FLOAT_EQ(buffer.getSample(0, 2 * delaySamples), 0.5f);
+	EXPECT_FLOAT_EQ(buffer.getSample(0, 3 * delaySamples), 0.25f);
+	EXPECT_FLOAT_EQ(buffer.getSample(0, 2 * delaySamples - 1), 0.0f);
+}
+
+
+TEST(Delay, BufferMemoryStaysSmall)
+{
+	Delay<float> delay;
+	delay.prepare({48000, 512, 2}, 2000.0f);
+
+	// 2 s at 48 kHz plus one block, rounded up to the next power of two
+	EXPECT_EQ(delay.getDelayBufferCapacity(), 131072);
+}
+
+
+TEST(Delay, InterpolationChange)
+{
+	Delay<float> delay;
+	ASSERT_EQ(delay.getInterpolation(), DelayInterpolation::LinearInterpolation);
+
+	delay.setParameter(ParamId::DelayInterpolation, 2.0f);
+	ASSERT_EQ(delay.getInterpolation(), DelayInterpolation::ThiranInterpolation);
+}
+
+
+namespace
+{
+constexpr double fractionalSampleRate = 1000.0;
+constexpr double fractionalDelay	  = 10.5;
+constexpr int	 fractionalNumSamples = 1024;
+
+
+double tenHertzSine(double t)
+{
+	return std::sin(juce::MathConstants<double>::twoPi * 10.0 * t / fractionalSampleRate);
+}
+
+
+// Delays a 10 Hz sine by 10.5 samples (1 ms = 1 sample) in blocks of the given size
+std::vector<float> delayTenHertzSine(DelayInterpolation interpolation, int blockSize)
+{
+	Delay<float> delay;
+	delay.prepare({fractionalSampleRate, 64, 1}, 100.0f);
+	delay.setInterpolation(interpolation);
+	delay.setMix(1.0f);
+	delay.setChannelDelayTime(0, static_cast<float>(fractionalDelay));
+
+	std::vector<float>		 output;
+	juce::AudioBuffer<float> buffer(1, blockSize);
+
+	for (int start = 0; start < fractionalNumSamples; start += blockSize)
+	{
+		for (int i = 0; i < blockSize; ++i)
+			buffer.setSample(0, i, static_cast<float>(tenHertzSine(start + i)));
+
+		delay.process(buffer);
+		output.insert(output.end(), buffer.getReadPointer(0), buffer.getReadPointer(0) + blockSize);
+	}
+
+	return output;
+}
+
+
+// Largest deviation from the ideal delayed sine, skipping the delay time smoothing and the start of the sine
+double fractionalDelayError(DelayInterpolation interpolation)
+{
+	const auto output  = delayTenHertzSine(interpolation, 64);
+	double	   largest = 0.0;
+
+	for (int i = 256; i < fractionalNumSamples; ++i)
+		largest = std::max(largest, std::abs(output[i] - tenHertzSine(i - fractionalDelay)));
+
+	return largest;
+}
+} // namespace
+
+
+TEST(Delay, FractionalDelayAccuracy)
+{
+	EXPECT_LT(fractionalDelayError(DelayInterpolation::LinearInterpolation), 1.0e-3);
+	EXPECT_LT(fractionalDelayError(DelayInterpolation::LagrangeInterpolation), 1.0e-5);
+	EXPECT_LT(fractionalDelayError(DelayInterpolation::ThiranInterpolation), 2.0e-4);
+}
+
+
+TEST(Delay, BlockPathMatchesSamplePath)
+{
+	// Blocks of 8 samples lie behind the 10.5 samples delay and take the block path, blocks of 64 samples are processed per sample
+	for (auto interpolation : {DelayInterpolation::LinearInterpolation, DelayInterpolation::LagrangeInterpolation, DelayInterpolation::ThiranInterpolation})
+	{
+		const auto blockOutput	= delayTenHertzSine(interpolation, 8);
+		const auto sampleOutput = delayTenHertzSine(interpolation, 64);
+
+		for (int i = 0; i < fractionalNumSamples; ++i)
+			ASSERT_NEAR(blockOutput[i], sampleOutput[i], 1.0e-6f) << "interpolation " << interpolation << ", sample " << i;
+	}
+}
+
+
+namespace
+{
+// Stereo ping pong with a fully wet output, the left and right delay times are given in samples at 1 kHz
+void preparePingPong(Delay<float> &delay, float leftDelay, float rightDelay, float feedback, DelayInterpolation interpolation = LinearInterpolation)
+{
+	delay.prepare({1000.0, 64, 2}, 500.0f);
+	delay.setDelayType(DelayType::PingPong);
+	delay.setInterpolation(interpolation);
+	delay.setMix(1.0f);
+	delay.setFeedback(feedback);
+	delay.setChannelDelayTime(0, leftDelay);
+	delay.setChannelDelayTime(1, rightDelay);
+
+	// Let the delay time smoothing settle
+	juce::AudioBuffer<float> silence(2, 64);
+	silence.clear();
+	delay.process(silence);
+	delay.reset();
+}
+
+
+std::vector<juce::AudioBuffer<float>> processInBlocks(Delay<float> &delay, const juce::AudioBuffer<float> &input, int blockSize)
+{
+	std::vector<juce::AudioBuffer<float>> blocks;
+
+	for (int start = 0; start < input.getNumSamples(); start += blockSize)
+	{
+		juce::AudioBuffer<float> block(2, blockSize);
+		for (int channel = 0; channel < 2; ++channel)
+			block.copyFrom(channel, 0, input, channel, start, blockSize);
+
+		delay.process(block);
+		blocks.push_back(std::move(block));
+	}
+
+	return blocks;
+}
+} // namespace
+
+
+TEST(Delay, PingPongAlternatesSides)
+{
+	Delay<float> delay;
+	preparePingPong(delay, 30.0f, 50.0f, 0.5f);
+
+	juce::AudioBuffer<float> buffer(2, 256);
+	buffer.clear();
+	buffer.setSample(0, 0, 1.0f);
+
+	delay.process(buffer);
+
+	// The mono sum of the impulse comes back left, then right and left again, each repeat scaled by the feedback
+	for (int i = 0; i < buffer.getNumSamples(); ++i)
+	{
+		float expectedLeft	= 0.0f;
+		float expectedRight = 0.0f;
+
+		if (i >= 30 && (i - 30) % 80 == 0)
+			expectedLeft = 0.5f * std::pow(0.25f, static_cast<float>((i - 30) / 80));
+		if (i >= 80 && (i - 80) % 80 == 0)
+			expectedRight = 0.25f * std::pow(0.25f, static_cast<float>((i - 80) / 80));
+
+		EXPECT_FLOAT_EQ(buffer.getSample(0, i), expectedLeft) << "sample " << i;
+		EXPECT_FLOAT_EQ(buffer.getSample(1, i), expectedRight) << "sample " << i;
+	}
+}
+
+
+TEST(Delay, PingPongBlockPathMatchesSamplePath)
+{
+	juce::AudioBuffer<float> input(2, 512);
+	for (int i = 0; i < input.getNumSamples(); ++i)
+	{
+		input.setSample(0, i, std::sin(0.05f * static_cast<float>(i)));
+		input.setSample(1, i, std::cos(0.031f * static_cast<float>(i)));
+	}
+
+	for (auto interpolation : {DelayInterpolation::LinearInterpolation, DelayInterpolation::LagrangeInterpolation, DelayInterpolation::ThiranInterpolation})
+	{
+		// Blocks of 16 lie behind both delays and take the block path, blocks of 64 are processed per sample
+		Delay<float> blockDelay, sampleDelay;
+		preparePingPong(blockDelay, 20.25f, 33.5f, 0.6f, interpolation);
+		preparePingPong(sampleDelay, 20.25f, 33.5f, 0.6f, interpolation);
+
+		const auto blockOutput	= processInBlocks(blockDelay, input, 16);
+		const auto sampleOutput = processInBlocks(sampleDelay, input, 64);
+
+		for (int i = 0; i < input.getNumSamples(); ++i)
+			for (int channel = 0; channel < 2; ++channel)
+				ASSERT_NEAR(blockOutput[i / 16].getSample(channel, i % 16), sampleOutput[i / 64].getSample(channel, i % 64), 1.0e-5f)
+					<< "interpolation " << interpolation << ", channel " << channel << ", sample " << i;
+	}
+}
+
+
+TEST(Delay, PingPongFallsBackToSingleTapForMono)
+{
+	Delay<float> delay;
+	delay.prepare({1000.0, 64, 1}, 500.0f);
+	delay.setDelayType(DelayType::PingPong);
+	delay.setMix(1.0f);
+	delay.setChannelDelayTime(0, 10.0f);
+
+	juce::AudioBuffer<float> silence(1, 64);
+	silence.clear();
+	delay.process(silence);
+	delay.reset();
+
+	juce::AudioBuffer<float> buffer(1, 64);
+	buffer.clear();
+	buffer.setSample(0, 0, 1.0f);
+	delay.process(buffer);
+
+	EXPECT_FLOAT_EQ(buffer.getSample(0, 10), 1.0f);
+}
+
+
+namespace
+{
+// Three taps at 10, 20 and 30 samples (1 kHz), panned left, center and right, with a fully wet output
+void prepareMultiTap(Delay<float> &delay, float feedback, DelayInterpolation interpolation = LinearInterpolation)
+{
+	delay.prepare({1000.0, 64, 2}, 500.0f);
+	delay.setDelayType(DelayType::MultiTap);
+	delay.setInterpolation(interpolation);
+	delay.setMix(1.0f);
+	delay.setFeedback(feedback);
+	delay.setNumTaps(3);
+
+	const float times[] = {10.0f, 20.0f, 30.0f};
+	const float gains[] = {1.0f, 0.5f, 0.25f};
+	const float pans[]	= {-1.0f, 0.0f, 1.0f};
+
+	for (int tap = 0; tap < 3; ++tap)
+	{
+		delay.setTapTime(tap, times[tap]);
+		delay.setTapGain(tap, gains[tap]);
+		delay.setTapPan(tap, pans[tap]);
+	}
+
+	// Let the smoothing settle
+	juce::AudioBuffer<float> silence(2, 64);
+	silence.clear();
+	delay.process(silence);
+	delay.reset();
+}
+} // namespace
+
+
+TEST(Delay, MultiTapPansEachTap)
+{
+	Delay<float> delay;
+	prepareMultiTap(delay, 0.5f);
+
+	juce::AudioBuffer<float> buffer(2, 64);
+	buffer.clear();
+	buffer.setSample(0, 0, 1.0f);
+	buffer.setSample(1, 0, 1.0f);
+
+	delay.process(buffer);
+
+	const float center = std::sqrt(0.5f);
+
+	EXPECT_NEAR(buffer.getSample(0, 10), 1.0f, 1.0e-6f);
+	EXPECT_NEAR(buffer.getSample(1, 10), 0.0f, 1.0e-6f);
+	EXPECT_NEAR(buffer.getSample(0, 20), 0.5f * center, 1.0e-6f);
+	EXPECT_NEAR(buffer.getSample(1, 20), 0.5f * center, 1.0e-6f);
+	EXPECT_NEAR(buffer.getSample(0, 30), 0.0f, 1.0e-6f);
+	EXPECT_NEAR(buffer.getSample(1, 30), 0.25f, 1.0e-6f);
+
+	// The last tap is fed back and comes around through the first tap
+	EXPECT_NEAR(buffer.getSample(0, 40), 0.5f, 1.0e-6f);
+	EXPECT_NEAR(buffer.getSample(1, 60), 0.5f * 0.25f, 1.0e-6f);
+
+	EXPECT_NEAR(buffer.getSample(0, 5), 0.0f, 1.0e-6f);
+	EXPECT_NEAR(buffer.getSample(1, 15), 0.0f, 1.0e-6f);
+}
+
+
+TEST(Delay, MultiTapBlockPathMatchesSamplePath)
+{
+	juce::AudioBuffer<float> input(2, 512);
+	for (int i = 0; i < input.getNumSamples(); ++i)
+	{
+		input.setSample(0, i, std::sin(0.05f * static_cast<float>(i)));
+		input.setSample(1, i, std::cos(0.031f * static_cast<float>(i)));
+	}
+
+	for (auto interpolation : {DelayInterpolation::LinearInterpolation, DelayInterpolation::LagrangeInterpolation, DelayInterpolation::ThiranInterpolation})
+	{
+		// Blocks of 8 lie behind all taps and take the block path, blocks of 64 are processed per sample
+		Delay<float> blockDelay, sampleDelay;
+		prepareMultiTap(blockDelay, 0.6f, interpolation);
+		prepareMultiTap(sampleDelay, 0.6f, interpolation);
+
+		for (auto *delay : {&blockDelay, &sampleDelay})
+			delay->setTapTime(1, 20.4f);
+
+		const auto blockOutput	= processInBlocks(blockDelay, input, 8);
+		const auto sampleOutput = processInBlocks(sampleDelay, input, 64);
+
+		for (int i = 0; i < input.getNumSamples(); ++i)
+			for (int channel = 0; channel < 2; ++channel)
+				ASSERT_NEAR(blockOutput[i / 8].getSample(channel, i % 8), sampleOutput[i / 64].getSample(channel, i % 64), 1.0e-5f)
+					<< "interpolation " << interpolation << ", channel " << channel << ", sample " << i;
+	}
+}
+
+
+TEST(Delay, MultiTapCountIsClamped)
+{
+	Delay<float> delay;
+
+	delay.setNumTaps(0);
+	EXPECT_EQ(delay.getNumTaps(), 1);
+
+	delay.setParameter(ParamId::DelayNumTaps, 100.0f);
+	EXPECT_EQ(delay.getNumTaps(), delayMaxTaps);
+}
+
+
+TEST(Delay, TailLengthFollowsDelayTimeAndFeedback)
+{
+	Delay<float>		   delay;
+	juce::dsp::ProcessSpec spec{48000, 480, 1};
+	delay.prepare(spec, 100.0f);
+
+	const double blockSeconds = 480.0 / 48000.0;
+
+	delay.setChannelDelayTime(0, 10.0f);
+	EXPECT_NEAR(delay.getTailLengthSeconds(), 0.01 + blockSeconds, 1.0e-9);
+
+	// Halving per pass, 20 passes until -120 dB plus the first one
+	delay.setFeedback(0.5f);
+	EXPECT_NEAR(delay.getTailLengthSeconds(), 21.0 * 0.01 + blockSeconds, 1.0e-9);
+
+	delay.setFeedback(1.0f);
+	EXPECT_TRUE(std::isinf(delay.getTailLengthSeconds()));
+}
+
+
+TEST(Delay, SilentInputRunsUntilTheTailDecayed)
+{
+	Delay<float> delay;
+	prepareWetDelay(delay, 5.0f, 0.5f);
+
+	juce::AudioBuffer<float> buffer(1, 240);
+	buffer.clear();
+	buffer.setSample(0, 0, 1.0f);
+	delay.process(buffer);
+
+	EXPECT_FALSE(delay.isIdle());
+
+	// The echoes go on with silent input, every 240 samples at half the level
+	float expected = 1.0f;
+	int	  numBlocks = 1;
+
+	for (; !delay.isIdle() && numBlocks < 100; ++numBlocks)
+	{
+		buffer.clear();
+		delay.process(buffer);
+
+		if (expected > 1.0e-3f)
+			EXPECT_FLOAT_EQ(buffer.getSample(0, 0), expected) << "block " << numBlocks;
+
+		expected *= 0.5f;
+	}
+
+	// Idle as soon as the silent blocks cover the tail
+	EXPECT_TRUE(delay.isIdle());
+	EXPECT_EQ(numBlocks - 1, static_cast<int>(std::ceil(delay.getTailLengthSeconds() * 48000.0 / 240.0)));
+
+	buffer.clear();
+	delay.process(buffer);
+	EXPECT_EQ(buffer.getMagnitude(0, 240), 0.0f);
+
+	// Signal wakes it up again
+	buffer.setSample(0, 0, 1.0f);
+	delay.process(buffer);
+	EXPECT_FALSE(delay.isIdle());
+}
+
+
+TEST(Delay, ChannelsShareTheParameterRamps)
+{
+	// Identical channels have to stay identical while feedback and mix are smoothed, on the block and on the sample path
+	for (int blockSize : {8, 256})
+	{
+		Delay<float> delay;
+		delay.prepare({48000.0, 256, 2}, 100.0f);
+		delay.setChannelDelayTime(0, 0.25f);
+		delay.setChannelDelayTime(1, 0.25f);
+		delay.setMix(0.0f);
+		delay.setFeedback(0.0f);
+
+		juce::AudioBuffer<float> buffer(2, blockSize);
+
+		for (int block = 0; block < 2048 / blockSize; ++block)
+		{
+			// Start the ramps after the delay time settled
+			if (block == 1024 / blockSize)
+			{
+				delay.setMix(1.0f);
+				delay.setFeedback(0.9f);
+			}
+
+			for (int i = 0; i < blockSize; ++i)
+			{
+				const float sample = std::sin(0.05f * static_cast<float>(block * blockSize + i));
+				buffer.setSample(0, i, sample);
+				buffer.setSample(1, i, sample);
+			}
+
+			delay.process(buffer);
+
+			for (int i = 0; i < blockSize; ++i)
+				ASSERT_EQ(buffer.getSample(0, i), buffer.getSample(1, i)) << "block size " << blockSize << ", sample " << block * blockSize + i;
+		}
+	}
+}
@@ -54,3 +54,161 @@ TEST(Distortion, Reset)
 
 	ASSERT_FLOAT_EQ(distortion.processSample(1.0f), 0.0f); // Default values should lead to no distortion
 }
+
+TEST(Distortion, BlockProcessingMatchesSampleProcessing)
+{
+	juce::dsp::ProcessSpec spec{44100, 64, 1};
+
+	for (auto type : {DistortionType::hardClipping, DistortionType::softClipping, DistortionType::saturation})
+	{
+		Distortion<float> blockDistortion;
+		Distortion<float> sampleDistortion;
+
+		for (auto *distortion : {&blockDistortion, &sampleDistortion})
+		{
+			distortion->prepare(spec);
+			distortion->setCurrentDistortionType(type);
+			distortion->setDrive(12.0f);
+			distortion->setMix(0.7f);
+			distortion->setOutput(-3.0f);
+		}
+
+		// Use more samples than the maximum block size to cover the chunking as well
+		juce::AudioBuffer<float> buffer(1, 200);
+		for (int i = 0; i < buffer.getNumSamples(); ++i)
+			buffer.setSample(0, i, 0.8f * std::sin(0.1f * static_cast<float>(i)));
+
+		// process() removes DC from the input first, processSample() does not. The reference runs the input through
+		// the same 10 Hz Linkwitz-Riley highpass, so both shape the same signal.
+		juce::dsp::LinkwitzRileyFilter<float> dcFilter;
+		dcFilter.prepare(spec);
+		dcFilter.setCutoffFrequency(10.0f);
+		dcFilter.setType(juce::dsp::LinkwitzRileyFilter<float>::Type::highpass);
+
+		std::vector<float> expected;
+		for (int i = 0; i < buffer.getNumSamples(); ++i)
+			expected.push_back(sampleDistortion.processSample(dcFilter.processSample(0, buffer.getSample(0, i))));
+
+		blockDistortion.process(buffer);
+
+		for (int i = 0; i < buffer.getNumSamples(); ++i)
+			ASSERT_NEAR(buffer.getSample(0, i), expected[i], 1.0e-5f);
+	}
+}
+
+TEST(Distortion, OversamplingLatency)
+{
+	Distortion<float>	   distortion;
+	juce::dsp::ProcessSpec spec{44100, 512, 2};
+	distortion.prepare(spec);
+
+	ASSERT_FLOAT_EQ(distortion.getLatencyInSamples(), 0.0f);
+
+	distortion.setOversamplingFactor(OversamplingFactor::Oversampling4x);
+	distortion.setOversamplingFilter(OversamplingFilter::LinearPhaseFIR);
+	const float firLatency = distortion.getLatencyInSamples();
+
+	distortion.setOversamplingFilter(OversamplingFilter::PolyphaseIIR);
+	const float iirLatency = distortion.getLatencyInSamples();
+
+	ASSERT_GT(firLatency, 0.0f);
+	ASSERT_GT(iirLatency, 0.0f);
+	ASSERT_LT(iirLatency, firLatency); // The polyphase IIR is the low latency option
+
+	juce::AudioBuffer<float> buffer(2, 512);
+	buffer.clear();
+	buffer.setSample(0, 0, 0.5f);
+
+	distortion.process(buffer);
+
+	for (int i = 0; i < buffer.getNumSamples(); ++i)
+		ASSERT_TRUE(std::isfinite(buffer.getSample(0, i)));
+}
+
+TEST(Distortion, AntiderivativeAntialiasingSettlesOnCurve)
+{
+	// A constant input hits the ill-conditioned fallback, the output has to settle on the static curve
+	juce::dsp::ProcessSpec spec{44100, 256, 1};
+
+	for (auto mode : {AntialiasingMode::FirstOrderADAA, AntialiasingMode::SecondOrderADAA})
+	{
+		for (auto type : {DistortionType::hardClipping, DistortionType::softClipping, DistortionType::saturation})
+		{
+			Distortion<float> reference;
+			Distortion<float> distortion;
+
+			for (auto *effect : {&reference, &distortion})
+			{
+				effect->prepare(spec);
+				effect->setCurrentDistortionType(type);
+				effect->setMix(1.0f);
+			}
+
+			distortion.setAntialiasingMode(mode);
+
+			juce::AudioBuffer<float> referenceBuffer(1, 256);
+			juce::AudioBuffer<float> buffer(1, 256);
+
+			for (int block = 0; block < 4; ++block)
+			{
+				for (auto *b : {&referenceBuffer, &buffer})
+					for (int i = 0; i < b->getNumSamples(); ++i)
+						b->setSample(0, i, -0.6f);
+
+				reference.process(referenceBuffer);
+				distortion.process(buffer);
+			}
+
+			// The ADAA output lags by up to one sample behind the slowly decaying DC filter output
+			ASSERT_NEAR(buffer.getSample(0, 255), referenceBuffer.getSample(0, 255), 2.0e-3f);
+		}
+	}
+}
+
+
+TEST(Distortion, AntiderivativeAntialiasingLatency)
+{
+	Distortion<float>	   distortion;
+	juce::dsp::ProcessSpec spec{44100, 512, 2};
+	distortion.prepare(spec);
+
+	distortion.setAntialiasingMode(AntialiasingMode::FirstOrderADAA);
+	ASSERT_FLOAT_EQ(distortion.getLatencyInSamples(), 0.5f);
+
+	distortion.setAntialiasingMode(AntialiasingMode::SecondOrderADAA);
+	ASSERT_FLOAT_EQ(distortion.getLatencyInSamples(), 1.0f);
+}
+
+
+TEST(Distortion, DCFilterAfterSaturationRemovesTheOffset)
+{
+	Distortion<float> distortion;
+	distortion.prepare({48000, 480, 1});
+	distortion.setCurrentDistortionType(DistortionType::saturation);
+	distortion.setDCFilterMode(DCFilterMode::DCFilterAfterSaturation);
+	distortion.setDrive(24.0f);
+	distortion.setMix(1.0f);
+
+	juce::AudioBuffer<float> buffer(1, 480);
+	double					 sum = 0.0;
+
+	// The asymmetric curve turns a sine into an offset, the blocker has settled after 0.22 s
+	for (int block = 0; block < 100; ++block)
+	{
+		for (int i = 0; i < 480; ++i)
+			buffer.setSample(0, i, 0.8f * std::sin(juce::MathConstants<float>::twoPi * 100.0f * static_cast<float>(block * 480 + i) / 48000.0f));
+
+		distortion.process(buffer);
+
+		if (block >= 90)
+			for (int i = 0; i < 480; ++i)
+				sum += buffer.getSample(0, i);
+	}
+
+	EXPECT_NEAR(sum / (10.0 * 480.0), 0.0, 1.0e-3);
+
+	// The one pole filter decays faster than the Linkwitz-Riley
+	const double onePoleTail = distortion.getTailLengthSeconds();
+	distortion.setDCFilterMode(DCFilterMode::DCFilterLinkwitzRiley);
+	EXPECT_LT(onePoleTail, distortion.getTailLengthSeconds());
+}
@@ -0,0 +1,324 @@
+#include <gtest/gtest.h>
+
+#include "PluginProcessor.h"
+
+
+namespace
+{
+// Adds offset to every sample, then multiplies with gain, so the result depends on the order
+class TestEffect : public EffectBase<float>
+{
+public:
+	TestEffect(float offset, float gain) : mOffset(offset), mGain(gain) {}
+
+	void prepare(const juce::dsp::ProcessSpec &) override {}
+	void reset() override { mNumResets++; }
+	EffectType getEffectType() const override { return EffectType::None; }
+
+	void process(juce::AudioBuffer<float> &buffer) override
+	{
+		for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+			for (int i = 0; i < buffer.getNumSamples(); ++i)
+				buffer.setSample(channel, i, (buffer.getSample(channel, i) + mOffset) * mGain);
+	}
+
+	int mNumResets{0};
+
+private:
+	float mOffset;
+	float mGain;
+};
+
+
+float processOne(EffectChain<float> &chain, float input)
+{
+	juce::AudioBuffer<float> buffer(1, 1);
+	buffer.setSample(0, 0, input);
+	chain.process(buffer);
+	return buffer.getSample(0, 0);
+}
+} // namespace
+
+
+TEST(EffectChain, ProcessesInTheOrderOfAdding)
+{
+	TestEffect		   addOne(1.0f, 1.0f);
+	TestEffect		   twice(0.0f, 2.0f);
+	EffectChain<float> chain;
+	chain.addEffect(addOne);
+	chain.addEffect(twice);
+
+	EXPECT_EQ(chain.getNumEffects(), 2);
+	EXPECT_EQ(chain.getEffectAt(0), 0);
+	EXPECT_EQ(chain.getEffectAt(1), 1);
+	EXPECT_EQ(chain.getEffectAt(2), -1);
+	EXPECT_FLOAT_EQ(processOne(chain, 1.0f), 4.0f);
+}
+
+
+TEST(EffectChain, OrderCanBeChanged)
+{
+	TestEffect		   addOne(1.0f, 1.0f);
+	TestEffect		   twice(0.0f, 2.0f);
+	EffectChain<float> chain;
+	chain.addEffect(addOne);
+	chain.addEffect(twice);
+
+	chain.setOrder(std::array{1, 0});
+	EXPECT_FLOAT_EQ(processOne(chain, 1.0f), 3.0f);
+
+	// Effects left out of the order are not processed
+	chain.setOrder(std::array{1});
+	EXPECT_FLOAT_EQ(processOne(chain, 1.0f), 2.0f);
+	EXPECT_EQ(chain.getEffectAt(1), -1);
+}
+
+
+TEST(EffectChain, BypassSkipsTheEffectAndKeepsTheOrder)
+{
+	TestEffect		   addOne(1.0f, 1.0f);
+	TestEffect		   twice(0.0f, 2.0f);
+	TestEffect		   addTen(10.0f, 1.0f);
+	EffectChain<float> chain;
+	chain.addEffect(addOne);
+	chain.addEffect(twice);
+	chain.addEffect(addTen);
+	chain.setOrder(std::array{2, 1, 0});
+
+	chain.setBypassed(1, true);
+	EXPECT_TRUE(chain.isBypassed(1));
+	EXPECT_FLOAT_EQ(processOne(chain, 1.0f), 12.0f);
+
+	chain.setBypassed(1, false);
+	EXPECT_FALSE(chain.isBypassed(1));
+	EXPECT_FLOAT_EQ(processOne(chain, 1.0f), 23.0f);
+
+	// Changing the order does not touch the bypass state
+	chain.setBypassed(2, true);
+	chain.setOrder(std::array{0, 1, 2});
+	EXPECT_TRUE(chain.isBypassed(2));
+	EXPECT_FLOAT_EQ(processOne(chain, 1.0f), 4.0f);
+}
+
+
+TEST(EffectChain, ResetReachesEveryEffect)
+{
+	TestEffect		   first(0.0f, 1.0f);
+	TestEffect		   second(0.0f, 1.0f);
+	EffectChain<float> chain;
+	chain.addEffect(first);
+	chain.addEffect(second);
+	chain.setOrder(std::array{1});
+
+	chain.reset();
+	EXPECT_EQ(first.mNumResets, 1);
+	EXPECT_EQ(second.mNumResets, 1);
+}
+
+
+TEST(EffectChain, StaticChainMatchesDynamicChain)
+{
+	TestEffect								   addOne(1.0f, 1.0f);
+	TestEffect								   twice(0.0f, 2.0f);
+	EffectChain<float>						   dynamicChain;
+	StaticEffectChain<float, TestEffect, TestEffect> staticChain(twice, addOne);
+	dynamicChain.addEffect(twice);
+	dynamicChain.addEffect(addOne);
+
+	juce::AudioBuffer<float> buffer(2, 16);
+	for (int i = 0; i < 16; ++i)
+	{
+		buffer.setSample(0, i, static_cast<float>(i));
+		buffer.setSample(1, i, -static_cast<float>(i));
+	}
+
+	juce::AudioBuffer<float> reference;
+	reference.makeCopyOf(buffer);
+
+	staticChain.process(buffer);
+	dynamicChain.process(reference);
+
+	for (int channel = 0; channel < 2; ++channel)
+		for (int i = 0; i < 16; ++i)
+			EXPECT_FLOAT_EQ(buffer.getSample(channel, i), reference.getSample(channel, i));
+}
+
+
+TEST(EffectChain, ParallelRoutingSumsTheBranches)
+{
+	TestEffect		   addOne(1.0f, 1.0f);
+	TestEffect		   twice(0.0f, 2.0f);
+	EffectChain<float> chain;
+	chain.addEffect(addOne);
+	chain.addEffect(twice);
+	chain.prepare(1, 16);
+	chain.setRouting(ChainRouting::ParallelRouting);
+
+	// (1 + 1) and (1 * 2) with equal weight
+	EXPECT_EQ(chain.getRouting(), ChainRouting::ParallelRouting);
+	EXPECT_FLOAT_EQ(processOne(chain, 1.0f), 2.0f);
+
+	// A single branch is processed in place
+	chain.setBypassed(0, true);
+	EXPECT_FLOAT_EQ(processOne(chain, 3.0f), 6.0f);
+}
+
+
+TEST(EffectChain, LargerBlocksThanPreparedKeepTheParallelSum)
+{
+	TestEffect		   addOne(1.0f, 1.0f);
+	TestEffect		   twice(0.0f, 2.0f);
+	EffectChain<float> chain;
+	chain.addEffect(addOne);
+	chain.addEffect(twice);
+	chain.prepare(1, 16);
+	chain.setRouting(ChainRouting::ParallelRouting);
+
+	// Two and a half prepared blocks, the serial chain would give (1 + 1) * 2
+	juce::AudioBuffer<float> buffer(1, 40);
+
+	for (int i = 0; i < buffer.getNumSamples(); ++i)
+		buffer.setSample(0, i, 1.0f);
+
+	chain.process(buffer);
+
+	for (int i = 0; i < buffer.getNumSamples(); ++i)
+		ASSERT_FLOAT_EQ(buffer.getSample(0, i), 2.0f) << i;
+}
+
+
+TEST(EffectChain, ParallelBranchesAreAlignedToTheSlowestOne)
+{
+	juce::dsp::ProcessSpec spec{48000.0, 64, 1};
+
+	// Only the dry signal, delayed by the oversampling filters
+	Distortion<float>	   distortion;
+	distortion.prepare(spec);
+	distortion.setCurrentDistortionType(DistortionType::softClipping);
+	distortion.setParameter(ParamId::DistortionMix, 0.0f);
+	distortion.setOversamplingFactor(OversamplingFactor::Oversampling4x);
+	distortion.setOversamplingFilter(OversamplingFilter::LinearPhaseFIR);
+
+	const int latency = juce::roundToInt(distortion.getLatencyInSamples());
+	ASSERT_GT(latency, 0);
+
+	TestEffect		   passThrough(0.0f, 1.0f);
+	EffectChain<float> chain;
+	chain.addEffect(distortion);
+	chain.addEffect(passThrough);
+	chain.prepare(1, 64);
+	chain.setRouting(ChainRouting::ParallelRouting);
+
+	EXPECT_FLOAT_EQ(chain.getLatencyInSamples(), distortion.getLatencyInSamples());
+
+	juce::AudioBuffer<float> buffer(1, 64);
+	buffer.clear();
+	buffer.setSample(0, 0, 1.0f);
+	chain.process(buffer);
+
+	// Both halves of the sum arrive together, unaligned they would be two impulses of 0.5. The tolerance covers the
+	// slow decay of the DC filter in the distortion branch
+	for (int i = 0; i < buffer.getNumSamples(); ++i)
+		EXPECT_NEAR(buffer.getSample(0, i), i == latency ? 1.0f : 0.0f, 1.0e-2f) << i;
+}
+
+
+TEST(EffectChain, ThreadPoolMatchesSingleThreadedBranches)
+{
+	TestEffect		   addOne(1.0f, 1.0f);
+	TestEffect		   twice(0.0f, 2.0f);
+	TestEffect		   addTen(10.0f, 1.0f);
+	EffectChain<float> chain;
+	chain.addEffect(addOne);
+	chain.addEffect(twice);
+	chain.addEffect(addTen);
+	chain.prepare(2, 64);
+	chain.setRouting(ChainRouting::ParallelRouting);
+
+	juce::AudioBuffer<float> input(2, 64);
+	for (int i = 0; i < 64; ++i)
+	{
+		input.setSample(0, i, static_cast<float>(i));
+		input.setSample(1, i, 0.5f * static_cast<float>(i));
+	}
+
+	juce::AudioBuffer<float> reference;
+	reference.makeCopyOf(input);
+	chain.process(reference);
+	EXPECT_FALSE(chain.wasLastBlockThreaded());
+
+	RealtimeThreadPool pool;
+	pool.start(2);
+	chain.setThreadPool(&pool);
+	chain.setCostModelEnabled(false);
+
+	for (int run = 0; run < 100; ++run)
+	{
+		juce::AudioBuffer<float> buffer;
+		buffer.makeCopyOf(input);
+		chain.process(buffer);
+
+		ASSERT_TRUE(chain.wasLastBlockThreaded());
+
+		for (int channel = 0; channel < 2; ++channel)
+			for (int i = 0; i < 64; ++i)
+				ASSERT_FLOAT_EQ(buffer.getSample(channel, i), reference.getSample(channel, i));
+	}
+}
+
+
+TEST(EffectChain, CostModelKeepsCheapBranchesOnTheAudioThread)
+{
+	TestEffect		   addOne(1.0f, 1.0f);
+	TestEffect		   twice(0.0f, 2.0f);
+	EffectChain<float> chain;
+	chain.addEffect(addOne);
+	chain.addEffect(twice);
+	chain.prepare(1, 1);
+	chain.setRouting(ChainRouting::ParallelRouting);
+
+	RealtimeThreadPool pool;
+	pool.start(1);
+	chain.setThreadPool(&pool);
+
+	// A single sample costs far less than handing it to another thread
+	for (int run = 0; run < 100; ++run)
+	{
+		processOne(chain, 1.0f);
+		EXPECT_FALSE(chain.wasLastBlockThreaded());
+	}
+}
+
+
+namespace
+{
+class TailEffect : public TestEffect
+{
+public:
+	explicit TailEffect(double tailSeconds) : TestEffect(0.0f, 1.0f), mTailSeconds(tailSeconds) {}
+
+	double getTailLengthSeconds() const override { return mTailSeconds; }
+
+private:
+	double mTailSeconds;
+};
+} // namespace
+
+
+TEST(EffectChain, TailLengthsAddUpInSeriesAndTakeTheLongestBranch)
+{
+	TailEffect		   shortTail(0.5);
+	TailEffect		   longTail(2.0);
+	EffectChain<float> chain;
+	chain.addEffect(shortTail);
+	chain.addEffect(longTail);
+
+	EXPECT_DOUBLE_EQ(chain.getTailLengthSeconds(), 2.5);
+
+	chain.setRouting(ChainRouting::ParallelRouting);
+	EXPECT_DOUBLE_EQ(chain.getTailLengthSeconds(), 2.0);
+
+	// Bypassed effects add nothing
+	chain.setBypassed(1, true);
+	EXPECT_DOUBLE_EQ(chain.getTailLengthSeconds(), 0.5);
+}
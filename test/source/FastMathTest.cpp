@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+
+#include "FastMath.h"
+#include "PluginProcessor.h"
+
+#include <functional>
+
+
+namespace
+{
+// Error bounds documented in FastMath.h
+template <typename T>
+struct ErrorBounds;
+
+template <>
+struct ErrorBounds<float>
+{
+	static constexpr double exp2	   = 1.0e-7;
+	static constexpr double sinCos	   = 2.0e-7;
+	static constexpr double tanh	   = 1.5e-7;
+	static constexpr double sinhSmall  = 3.5e-7;
+	static constexpr double sinhLarge  = 4.0e-6;
+	static constexpr double atan	   = 2.0e-7;
+	static constexpr double dbToGain   = 8.0e-7;
+};
+
+template <>
+struct ErrorBounds<double>
+{
+	static constexpr double exp2	   = 3.0e-16;
+	static constexpr double sinCos	   = 5.0e-16;
+	static constexpr double tanh	   = 4.0e-16;
+	static constexpr double sinhSmall  = 8.0e-16;
+	static constexpr double sinhLarge  = 1.0e-14;
+	static constexpr double atan	   = 5.0e-16;
+	static constexpr double dbToGain   = 3.0e-15;
+};
+
+
+// Largest absolute (or relative) error of the approximation against the long double libm over [start, end]
+template <typename T>
+double maxError(const std::function<T(T)> &approximation, const std::function<long double(long double)> &reference, double start, double end, bool relative)
+{
+	constexpr int numPoints = 200000;
+	double		  largest	= 0.0;
+
+	for (int i = 0; i <= numPoints; ++i)
+	{
+		const T			  x		= static_cast<T>(start + (end - start) * i / numPoints);
+		const long double exact = reference(static_cast<long double>(x));
+		long double		  error = std::abs(static_cast<long double>(approximation(x)) - exact);
+
+		if (relative)
+			error /= std::abs(exact);
+
+		largest = std::max(largest, static_cast<double>(error));
+	}
+
+	return largest;
+}
+} // namespace
+
+
+template <typename T>
+class FastMathAccuracy : public ::testing::Test
+{
+};
+
+using FastMathTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(FastMathAccuracy, FastMathTypes);
+
+
+TYPED_TEST(FastMathAccuracy, Exp2)
+{
+	using T = TypeParam;
+	EXPECT_LE(maxError<T>([](T x) { return FastMath::exp2(x); }, [](long double x) { return std::exp2(x); }, -120.0, 120.0, true), ErrorBounds<T>::exp2);
+
+	// Exact at integer exponents
+	EXPECT_EQ(FastMath::exp2(T(0)), T(1));
+	EXPECT_EQ(FastMath::exp2(T(10)), T(1024));
+}
+
+
+TYPED_TEST(FastMathAccuracy, SinCos)
+{
+	using T = TypeParam;
+	EXPECT_LE(maxError<T>([](T x) { return FastMath::sin(x); }, [](long double x) { return std::sin(x); }, -10.0, 10.0, false), ErrorBounds<T>::sinCos);
+	EXPECT_LE(maxError<T>([](T x) { return FastMath::cos(x); }, [](long double x) { return std::cos(x); }, -10.0, 10.0, false), ErrorBounds<T>::sinCos);
+	EXPECT_LE(maxError<T>([](T x) { return FastMath::sin(x); }, [](long double x) { return std::sin(x); }, -1.0e4, 1.0e4, false), ErrorBounds<T>::sinCos);
+	EXPECT_LE(maxError<T>([](T x) { return FastMath::cos(x); }, [](long double x) { return std::cos(x); }, -1.0e4, 1.0e4, false), ErrorBounds<T>::sinCos);
+}
+
+
+TYPED_TEST(FastMathAccuracy, Tanh)
+{
+	using T = TypeParam;
+	EXPECT_LE(maxError<T>([](T x) { return FastMath::tanh(x); }, [](long double x) { return std::tanh(x); }, -30.0, 30.0, false), ErrorBounds<T>::tanh);
+	EXPECT_LE(maxError<T>([](T x) { return FastMath::tanh(x); }, [](long double x) { return std::tanh(x); }, -1.0, 1.0, false), ErrorBounds<T>::tanh);
+
+	// Saturates without overflowing
+	EXPECT_EQ(FastMath::tanh(T(1000)), T(1));
+	EXPECT_EQ(FastMath::tanh(T(-1000)), T(-1));
+}
+
+
+TYPED_TEST(FastMathAccuracy, Sinh)
+{
+	using T = TypeParam;
+	EXPECT_LE(maxError<T>([](T x) { return FastMath::sinh(x); }, [](long double x) { return std::sinh(x); }, -1.0, 1.0, false), ErrorBounds<T>::sinhSmall);
+	EXPECT_LE(maxError<T>([](T x) { return FastMath::sinh(x); }, [](long double x) { return std::sinh(x); }, 1.0, 80.0, true), ErrorBounds<T>::sinhLarge);
+	EXPECT_LE(maxError<T>([](T x) { return FastMath::sinh(x); }, [](long double x) { return std::sinh(x); }, -80.0, -1.0, true), ErrorBounds<T>::sinhLarge);
+}
+
+
+TYPED_TEST(FastMathAccuracy, Atan)
+{
+	using T = TypeParam;
+	EXPECT_LE(maxError<T>([](T x) { return FastMath::atan(x); }, [](long double x) { return std::atan(x); }, -2.0, 2.0, false), ErrorBounds<T>::atan);
+	EXPECT_LE(maxError<T>([](T x) { return FastMath::atan(x); }, [](long double x) { return std::atan(x); }, -1000.0, 1000.0, false), ErrorBounds<T>::atan);
+}
+
+
+TYPED_TEST(FastMathAccuracy, DecibelsToGain)
+{
+	using T = TypeParam;
+	EXPECT_LE(maxError<T>([](T x) { return FastMath::dbToGain(x); }, [](long double x) { return std::pow(10.0L, x / 20.0L); }, -99.9, 100.0, true),
+			  ErrorBounds<T>::dbToGain);
+
+	// Same floor as juce::Decibels
+	EXPECT_EQ(FastMath::dbToGain(T(-100)), T(0));
+	EXPECT_EQ(FastMath::dbToGain(T(-120)), T(0));
+}
+
+
+TEST(FastMath, ConstantEvaluation)
+{
+	static_assert(FastMath::exp2(3.0) == 8.0);
+	static_assert(FastMath::sin(0.0f) == 0.0f);
+
+	constexpr double quarterPi = FastMath::atan(1.0);
+	EXPECT_NEAR(quarterPi, juce::MathConstants<double>::pi / 4.0, 1.0e-15);
+}
+
+
+TEST(FastMath, DistortionMatchesExactPrecision)
+{
+	juce::dsp::ProcessSpec spec{48000, 256, 1};
+
+	for (auto type : {DistortionType::softClipping, DistortionType::saturation})
+	{
+		Distortion<float> exact;
+		Distortion<float> fast;
+
+		for (auto *distortion : {&exact, &fast})
+		{
+			distortion->prepare(spec);
+			distortion->setCurrentDistortionType(type);
+			distortion->setDrive(12.0f);
+			distortion->setMix(1.0f);
+		}
+
+		fast.setMathPrecision(MathPrecision::PrecisionFast);
+
+		juce::AudioBuffer<float> exactBuffer(1, 256);
+		for (int i = 0; i < exactBuffer.getNumSamples(); ++i)
+			exactBuffer.setSample(0, i, 0.9f * std::sin(juce::MathConstants<float>::twoPi * 440.0f * static_cast<float>(i) / 48000.0f));
+
+		juce::AudioBuffer<float> fastBuffer;
+		fastBuffer.makeCopyOf(exactBuffer);
+
+		exact.process(exactBuffer);
+		fast.process(fastBuffer);
+
+		for (int i = 0; i < exactBuffer.getNumSamples(); ++i)
+			ASSERT_NEAR(fastBuffer.getSample(0, i), exactBuffer.getSample(0, i), 1.0e-5f) << "sample " << i;
+	}
+}
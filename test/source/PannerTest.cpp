@@ -19,9 +19,9 @@ TEST(PannerManager, MonoPanning)
 	panner.enableLFO(false);
 
 	// Use the public setParameter method instead of the private processMonoPanner
-	panner.setParameter(paramMonoPanValue, -0.5f);
-	panner.setParameter(paramMonoLfoFreq, 0.0f);
-	panner.setParameter(paramMonoLfoDepth, 0.0f);
+	panner.setParameter(ParamId::MonoPanValue, -0.5f);
+	panner.setParameter(ParamId::MonoLfoFreq, 0.0f);
+	panner.setParameter(ParamId::MonoLfoDepth, 0.0f);
 
 	std::this_thread::sleep_for(std::chrono::milliseconds(10));
 
@@ -49,12 +49,12 @@ TEST(PannerManager, StereoPanning)
 	buffer.setSample(0, 0, 1.0f); // Impulse in left channel
 
 	// Use the public setParameter method instead of the private processStereoPanner
-	panner.setParameter(paramStereoLeftPanValue, +1.0f);
-	panner.setParameter(paramStereoRightPanValue, -1.0f);
-	panner.setParameter(paramStereoLeftLfoFreq, 0.0f);
-	panner.setParameter(paramStereoRightLfoFreq, 0.0f);
-	panner.setParameter(paramStereoLeftLfoDepth, 0.0f);
-	panner.setParameter(paramStereoRightLfoDepth, 0.0f);
+	panner.setParameter(ParamId::StereoLeftPanValue, +1.0f);
+	panner.setParameter(ParamId::StereoRightPanValue, -1.0f);
+	panner.setParameter(ParamId::StereoLeftLfoFreq, 0.0f);
+	panner.setParameter(ParamId::StereoRightLfoFreq, 0.0f);
+	panner.setParameter(ParamId::StereoLeftLfoDepth, 0.0f);
+	panner.setParameter(ParamId::StereoRightLfoDepth, 0.0f);
 
 	std::this_thread::sleep_for(std::chrono::milliseconds(10));
 
@@ -63,3 +63,393 @@ TEST(PannerManager, StereoPanning)
 	ASSERT_NEAR(buffer.getSample(0, 0), 0.0f, 0.1f); // Expect full pan to the right
 	ASSERT_NEAR(buffer.getSample(1, 0), 1.0f, 0.1f); // Full signal in the right channel
 }
+
+
+TEST(MonoPanner, LfoRunsAtTheSameSpeedAtEverySampleRate)
+{
+	for (double sampleRate : {44100.0, 48000.0, 96000.0})
+	{
+		MonoPanner<float>	   panner;
+		juce::dsp::ProcessSpec spec{sampleRate, 256, 2};
+		panner.prepare(spec);
+		panner.setPan(0.0f);
+		panner.setLfoRate(1.0f);
+		panner.setLfoDepth(1.0f);
+		panner.enableLFO(true);
+
+		// A quarter period of the 1 Hz LFO swings the pan fully to the right
+		const int				 peakSample = static_cast<int>(0.25 * sampleRate);
+		juce::AudioBuffer<float> buffer(2, 256);
+
+		for (int start = 0; start <= peakSample; start += 256)
+		{
+			for (int channel = 0; channel < 2; ++channel)
+				juce::FloatVectorOperations::fill(buffer.getWritePointer(channel), 1.0f, 256);
+
+			panner.process(buffer);
+
+			if (peakSample < start + 256)
+			{
+				EXPECT_NEAR(buffer.getSample(0, peakSample - start), 0.0f, 1.0e-3f) << "sample rate " << sampleRate;
+				EXPECT_NEAR(buffer.getSample(1, peakSample - start), 1.0f, 1.0e-3f) << "sample rate " << sampleRate;
+			}
+		}
+	}
+}
+
+
+// Worst difference between the control rate output and the per sample reference, for the fastest and deepest LFO
+template <typename Panner, typename Setup>
+static float getControlRateDeviation(int controlInterval, Setup &&setup)
+{
+	constexpr int blockSize = 250; // Not a multiple of the interval, every block ends with a shorter segment
+	constexpr int numBlocks = 40;  // Over four periods of the 20 Hz LFO at 44.1 kHz
+
+	Panner		  reference, controlRate;
+	juce::dsp::ProcessSpec spec{44100.0, blockSize, 2};
+
+	for (auto *panner : {&reference, &controlRate})
+	{
+		panner->prepare(spec);
+		setup(*panner);
+		panner->enableLFO(true);
+	}
+
+	reference.setControlInterval(1);
+	controlRate.setControlInterval(controlInterval);
+
+	juce::AudioBuffer<float> referenceBuffer(2, blockSize), controlRateBuffer(2, blockSize);
+	juce::Random			 random(42);
+	float					 deviation = 0.0f;
+
+	for (int block = 0; block < numBlocks; ++block)
+	{
+		for (int channel = 0; channel < 2; ++channel)
+			for (int sample = 0; sample < blockSize; ++sample)
+				referenceBuffer.setSample(channel, sample, random.nextFloat() * 2.0f - 1.0f);
+
+		controlRateBuffer.makeCopyOf(referenceBuffer);
+
+		reference.process(referenceBuffer);
+		controlRate.process(controlRateBuffer);
+
+		for (int channel = 0; channel < 2; ++channel)
+			for (int sample = 0; sample < blockSize; ++sample)
+				deviation = juce::jmax(deviation, std::abs(referenceBuffer.getSample(channel, sample) - controlRateBuffer.getSample(channel, sample)));
+	}
+
+	return deviation;
+}
+
+
+TEST(MonoPanner, ControlRateStaysCloseToThePerSampleReference)
+{
+	auto setup = [](MonoPanner<float> &panner)
+	{
+		panner.setPan(0.0f);
+		panner.setLfoRate(monoLfoFreqMax);
+		panner.setLfoDepth(1.0f);
+	};
+
+	// The error of a linear segment grows with the square of its length
+	const float deviation16 = getControlRateDeviation<MonoPanner<float>>(16, setup);
+	const float deviation32 = getControlRateDeviation<MonoPanner<float>>(32, setup);
+
+	RecordProperty("DeviationInterval16", std::to_string(deviation16));
+	RecordProperty("DeviationInterval32", std::to_string(deviation32));
+
+	EXPECT_LT(deviation16, 5.0e-4f);
+	EXPECT_LT(deviation32, 2.0e-3f);
+}
+
+
+TEST(MonoPanner, StaticPanChangesGlideAcrossTheBlock)
+{
+	constexpr int		   blockSize = 256;
+	MonoPanner<float>	   panner;
+	juce::dsp::ProcessSpec spec{44100.0, blockSize, 2};
+	panner.prepare(spec);
+	panner.enableLFO(false);
+	panner.setPan(-1.0f);
+
+	juce::AudioBuffer<float> buffer(2, blockSize);
+	float					 previous = 0.0f, largestStep = 0.0f;
+
+	for (int block = 0; block < 8; ++block)
+	{
+		// Sweep the source across the image, the 10 ms parameter ramp spans about two blocks
+		if (block == 2)
+			panner.setPan(1.0f);
+
+		juce::FloatVectorOperations::fill(buffer.getWritePointer(0), 1.0f, blockSize);
+		juce::FloatVectorOperations::fill(buffer.getWritePointer(1), 1.0f, blockSize);
+		panner.process(buffer);
+
+		if (block == 0)
+			previous = buffer.getSample(0, 0);
+
+		for (int sample = 0; sample < blockSize; ++sample)
+		{
+			largestStep = juce::jmax(largestStep, std::abs(buffer.getSample(0, sample) - previous));
+			previous	= buffer.getSample(0, sample);
+		}
+	}
+
+	// A gain jump at the block boundaries would be about 0.5
+	EXPECT_NEAR(previous, 0.0f, 1.0e-6f);
+	EXPECT_LT(largestStep, 0.01f);
+}
+
+
+TEST(StereoPanner, ControlRateStaysCloseToThePerSampleReference)
+{
+	auto setup = [](StereoPanner<float> &panner)
+	{
+		panner.setLeftChannelPan(-0.5f);
+		panner.setRightChannelPan(0.5f);
+		panner.setLeftChannelLfoRate(stereoLeftLfoFreqMax);
+		panner.setRightChannelLfoRate(stereoRightLfoFreqMax);
+		// Deeper swings are clamped at the edges, the segments cut the corner of the clamp
+		panner.setLeftChannelLfoDepth(0.5f);
+		panner.setRightChannelLfoDepth(0.5f);
+	};
+
+	const float deviation16 = getControlRateDeviation<StereoPanner<float>>(16, setup);
+	const float deviation32 = getControlRateDeviation<StereoPanner<float>>(32, setup);
+
+	RecordProperty("DeviationInterval16", std::to_string(deviation16));
+	RecordProperty("DeviationInterval32", std::to_string(deviation32));
+
+	EXPECT_LT(deviation16, 5.0e-4f);
+	EXPECT_LT(deviation32, 2.0e-3f);
+}
+
+
+TEST(StereoPanner, StaticPanChangesGlideAcrossTheBlock)
+{
+	constexpr int		   blockSize = 256;
+	StereoPanner<float>	   panner;
+	juce::dsp::ProcessSpec spec{44100.0, blockSize, 2};
+	panner.prepare(spec);
+	panner.enableLFO(false);
+	panner.setLeftChannelPan(-1.0f);
+	panner.setRightChannelPan(1.0f);
+
+	juce::AudioBuffer<float> buffer(2, blockSize);
+	float					 previous = 0.0f, largestStep = 0.0f;
+
+	for (int block = 0; block < 8; ++block)
+	{
+		// Sweep the left channel across the image, the 10 ms parameter ramp spans about two blocks
+		if (block == 2)
+			panner.setLeftChannelPan(1.0f);
+
+		juce::FloatVectorOperations::fill(buffer.getWritePointer(0), 1.0f, blockSize);
+		buffer.clear(1, 0, blockSize);
+		panner.process(buffer);
+
+		if (block == 0)
+			previous = buffer.getSample(0, 0);
+
+		for (int sample = 0; sample < blockSize; ++sample)
+		{
+			largestStep = juce::jmax(largestStep, std::abs(buffer.getSample(0, sample) - previous));
+			previous	= buffer.getSample(0, sample);
+		}
+	}
+
+	// A gain jump at the block boundaries would be about 0.5
+	EXPECT_NEAR(previous, 0.0f, 1.0e-6f);
+	EXPECT_LT(largestStep, 0.01f);
+}
+
+
+// Channel of each type in the JUCE order of the layout
+static int channelOf(const juce::AudioChannelSet &layout, juce::AudioChannelSet::ChannelType type)
+{
+	for (int channel = 0; channel < layout.size(); ++channel)
+		if (layout.getTypeOfChannel(channel) == type)
+			return channel;
+
+	return -1;
+}
+
+
+TEST(PannerManager, SurroundLayoutsPanTheSourceBetweenSpeakers)
+{
+	const auto			   layout = juce::AudioChannelSet::create7point1point4();
+	PannerManager<float>   panner;
+	juce::dsp::ProcessSpec spec{48000.0, 256, static_cast<juce::uint32>(layout.size())};
+	panner.setChannelLayout(layout);
+	panner.prepare(spec);
+
+	panner.setParameter(ParamId::SurroundAzimuth, 90.0f);
+	panner.setParameter(ParamId::SurroundElevation, 0.0f);
+
+	const int				 centre = channelOf(layout, juce::AudioChannelSet::centre);
+	const int				 lfe	= channelOf(layout, juce::AudioChannelSet::LFE);
+	juce::AudioBuffer<float> buffer(layout.size(), 256);
+
+	// Past the 10 ms parameter ramp, the source on the centre ends up on the right side speaker. It is one of the
+	// eleven speakers averaged into the source
+	for (int block = 0; block < 4; ++block)
+	{
+		buffer.clear();
+		juce::FloatVectorOperations::fill(buffer.getWritePointer(centre), 1.0f, 256);
+		juce::FloatVectorOperations::fill(buffer.getWritePointer(lfe), 0.5f, 256);
+		panner.process(buffer);
+	}
+
+	for (int channel = 0; channel < layout.size(); ++channel)
+	{
+		const auto	type	 = layout.getTypeOfChannel(channel);
+		const float expected = type == juce::AudioChannelSet::rightSurroundSide ? 1.0f / 11.0f : type == juce::AudioChannelSet::LFE ? 0.5f : 0.0f;
+		EXPECT_NEAR(buffer.getSample(channel, 255), expected, 1.0e-5f) << "channel " << channel;
+	}
+
+	EXPECT_NEAR(panner.getParameter(ParamId::SurroundAzimuth), 90.0f, 1.0e-6f);
+}
+
+
+TEST(PannerManager, SurroundBedKeepsItsLevel)
+{
+	for (const auto &layout : {juce::AudioChannelSet::create5point1(), juce::AudioChannelSet::create7point1point4()})
+	{
+		PannerManager<float>   panner;
+		juce::dsp::ProcessSpec spec{48000.0, 256, static_cast<juce::uint32>(layout.size())};
+		panner.setChannelLayout(layout);
+		panner.prepare(spec);
+
+		panner.setParameter(ParamId::SurroundAzimuth, 0.0f);
+		panner.setParameter(ParamId::SurroundElevation, 0.0f);
+
+		const int				 lfe = channelOf(layout, juce::AudioChannelSet::LFE);
+		juce::AudioBuffer<float> buffer(layout.size(), 256);
+
+		// The same signal on every channel, it reaches the centre speaker at the level of one channel
+		for (int block = 0; block < 4; ++block)
+		{
+			for (int channel = 0; channel < layout.size(); ++channel)
+				juce::FloatVectorOperations::fill(buffer.getWritePointer(channel), channel == lfe ? 0.5f : 1.0f, 256);
+
+			panner.process(buffer);
+		}
+
+		for (int channel = 0; channel < layout.size(); ++channel)
+		{
+			const auto	type	 = layout.getTypeOfChannel(channel);
+			const float expected = type == juce::AudioChannelSet::centre ? 1.0f : type == juce::AudioChannelSet::LFE ? 0.5f : 0.0f;
+			EXPECT_NEAR(buffer.getSample(channel, 255), expected, 1.0e-5f) << layout.size() << " channels, channel " << channel;
+		}
+	}
+}
+
+
+TEST(PannerManager, PrepareSelectsThePannerOfTheChannelCount)
+{
+	const auto			   layout = juce::AudioChannelSet::create5point1();
+	PannerManager<float>   panner;
+	panner.setChannelLayout(layout);
+	panner.setParameter(ParamId::StereoLeftPanValue, 1.0f);
+	panner.setParameter(ParamId::StereoRightPanValue, -1.0f);
+
+	// Process and reset before the first prepare() have no panner to call
+	juce::AudioBuffer<float> stereo(2, 64);
+	juce::FloatVectorOperations::fill(stereo.getWritePointer(0), 1.0f, 64);
+	stereo.clear(1, 0, 64);
+	panner.reset();
+	panner.process(stereo);
+	EXPECT_EQ(stereo.getSample(0, 63), 1.0f);
+
+	// From surround back to stereo, the swapped stereo pans move the left input to the right
+	for (const int numChannels : {layout.size(), 2})
+		panner.prepare({48000.0, 64, static_cast<juce::uint32>(numChannels)});
+
+	panner.process(stereo);
+	EXPECT_NEAR(stereo.getSample(0, 63), 0.0f, 1.0e-5f);
+	EXPECT_NEAR(stereo.getSample(1, 63), 1.0f, 1.0e-5f);
+}
+
+
+TEST(MultichannelPanner, AzimuthTakesTheShorterWayAround)
+{
+	MultichannelPanner<float> panner;
+	juce::dsp::ProcessSpec	  spec{48000.0, 480, 6}; // 5.1 by default
+	panner.prepare(spec);
+	panner.setAzimuth(170.0f);
+
+	juce::AudioBuffer<float> buffer(6, 480);
+	const auto				 layout = MultichannelPanner<float>::getDefaultLayout(6);
+	const int				 left	= channelOf(layout, juce::AudioChannelSet::left);
+	const int				 right	= channelOf(layout, juce::AudioChannelSet::right);
+	const int				 centre = channelOf(layout, juce::AudioChannelSet::centre);
+
+	auto					 processBlock = [&]()
+	{
+		buffer.clear();
+		juce::FloatVectorOperations::fill(buffer.getWritePointer(centre), 1.0f, 480);
+		panner.process(buffer);
+	};
+
+	processBlock();
+	processBlock();
+
+	// From 170 to -170 degrees the source passes behind the listener, the front speakers stay silent
+	panner.setAzimuth(-170.0f);
+
+	for (int block = 0; block < 2; ++block)
+	{
+		processBlock();
+
+		for (int sample = 0; sample < 480; ++sample)
+			for (int channel : {left, right, centre})
+				EXPECT_EQ(buffer.getSample(channel, sample), 0.0f);
+	}
+
+	EXPECT_NEAR(panner.getAzimuth(), -170.0f, 1.0e-4f);
+}
+
+
+TEST(MultichannelPanner, ControlRateStaysCloseToThePerSampleReference)
+{
+	const auto				  layout = juce::AudioChannelSet::create7point1point4();
+	juce::dsp::ProcessSpec	  spec{44100.0, 250, static_cast<juce::uint32>(layout.size())};
+	MultichannelPanner<float> reference, controlRate;
+
+	for (auto *panner : {&reference, &controlRate})
+	{
+		// Set before prepare() the parameters start without a ramp, which steps at the block boundaries
+		panner->setChannelLayout(layout);
+		panner->setElevation(30.0f);
+		panner->setLfoRate(monoLfoFreqMax);
+		panner->setLfoDepth(1.0f);
+		panner->enableLFO(true);
+		panner->prepare(spec);
+	}
+
+	reference.setControlInterval(1);
+
+	juce::AudioBuffer<float> referenceBuffer(layout.size(), 250), controlRateBuffer(layout.size(), 250);
+	juce::Random			 random(3);
+	float					 deviation = 0.0f;
+
+	for (int block = 0; block < 40; ++block)
+	{
+		referenceBuffer.clear();
+		for (int sample = 0; sample < 250; ++sample)
+			referenceBuffer.setSample(channelOf(layout, juce::AudioChannelSet::centre), sample, random.nextFloat() * 2.0f - 1.0f);
+
+		controlRateBuffer.makeCopyOf(referenceBuffer);
+		reference.process(referenceBuffer);
+		controlRate.process(controlRateBuffer);
+
+		for (int channel = 0; channel < layout.size(); ++channel)
+			for (int sample = 0; sample < 250; ++sample)
+				deviation = juce::jmax(deviation, std::abs(referenceBuffer.getSample(channel, sample) - controlRateBuffer.getSample(channel, sample)));
+	}
+
+	// A full circle at 20 Hz moves the source by up to 8 degrees per interval of 16 samples, where it crosses from
+	// one speaker pair to the next the linear ramp misses the kink of the gains by a few percent
+	RecordProperty("Deviation", std::to_string(deviation));
+	EXPECT_LT(deviation, 0.1f);
+}
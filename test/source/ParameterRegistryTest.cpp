@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include "PluginProcessor.h"
+
+
+TEST(ParameterRegistry, KeysMapBackToTheirId)
+{
+	for (const auto &info : parameterRegistry)
+	{
+		const auto id = findParameterId(info.key);
+
+		ASSERT_TRUE(id.has_value()) << info.key;
+		EXPECT_EQ(*id, info.id) << info.key;
+	}
+
+	// Saved sessions stored the distortion mix under the key both mixes used to share
+	EXPECT_EQ(findParameterId("mix"), ParamId::DistortionMix);
+}
+
+
+TEST(ParameterRegistry, MixParametersAreSeparate)
+{
+	EXPECT_STRNE(getParameterInfo(ParamId::DelayMix).key, getParameterInfo(ParamId::DistortionMix).key);
+	EXPECT_STRNE(getParameterInfo(ParamId::Output).key, getParameterInfo(ParamId::DistortionOutput).key);
+}
+
+
+TEST(ParameterRegistry, DefaultsLieWithinRange)
+{
+	for (const auto &info : parameterRegistry)
+	{
+		EXPECT_LT(info.minValue, info.maxValue) << info.key;
+		EXPECT_GE(info.defaultValue, info.minValue) << info.key;
+		EXPECT_LE(info.defaultValue, info.maxValue) << info.key;
+
+		if (info.kind == ParameterKind::Choice)
+			EXPECT_EQ(static_cast<size_t>(info.maxValue) + 1, info.choices.size()) << info.key;
+	}
+}
+
+
+TEST(ParameterRegistry, ProcessorCreatesParametersInRegistryOrder)
+{
+	PluginProcessor processor;
+	const auto	   &parameters = processor.getParameters();
+
+	ASSERT_EQ(static_cast<size_t>(parameters.size()), numParameters);
+
+	for (size_t index = 0; index < numParameters; ++index)
+	{
+		auto *ranged = dynamic_cast<juce::RangedAudioParameter *>(parameters[static_cast<int>(index)]);
+
+		ASSERT_NE(ranged, nullptr);
+		EXPECT_EQ(ranged->getParameterID(), juce::String(parameterRegistry[index].key));
+		EXPECT_NEAR(ranged->convertFrom0to1(ranged->getDefaultValue()), parameterRegistry[index].defaultValue, 1.0e-3f) << parameterRegistry[index].key;
+	}
+}
+
+
+TEST(ParameterRegistry, EffectsRoundTripTheirParameters)
+{
+	Delay<float>	  delay;
+	Distortion<float> distortion;
+
+	delay.setParameter(ParamId::DelayMix, 0.25f);
+	delay.setParameter(delayTapGainId(5), 0.75f);
+	delay.setParameter(ParamId::DelayModel, 2.0f);
+	distortion.setParameter(ParamId::DistortionMix, 0.5f);
+	distortion.setParameter(ParamId::DistortionType, 1.0f);
+
+	EXPECT_FLOAT_EQ(delay.getParameter(ParamId::DelayMix), 0.25f);
+	EXPECT_FLOAT_EQ(delay.getParameter(delayTapGainId(5)), 0.75f);
+	EXPECT_EQ(delay.getDelayType(), DelayType::MultiTap);
+	EXPECT_FLOAT_EQ(delay.getParameter(ParamId::DelayModel), 2.0f);
+	EXPECT_FLOAT_EQ(distortion.getParameter(ParamId::DistortionMix), 0.5f);
+	EXPECT_EQ(distortion.getCurrentDistortionType(), DistortionType::softClipping);
+
+	// IDs of other modules are ignored
+	delay.setParameter(ParamId::DistortionMix, 1.0f);
+	EXPECT_FLOAT_EQ(delay.getParameter(ParamId::DelayMix), 0.25f);
+	EXPECT_FLOAT_EQ(delay.getParameter(ParamId::DistortionMix), 0.0f);
+}
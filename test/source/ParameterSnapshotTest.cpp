@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include "PluginProcessor.h"
+
+
+namespace
+{
+juce::RangedAudioParameter *findParameter(juce::AudioProcessor &processor, const juce::String &id)
+{
+	for (auto *parameter : processor.getParameters())
+		if (auto *ranged = dynamic_cast<juce::RangedAudioParameter *>(parameter); ranged != nullptr && ranged->getParameterID() == id)
+			return ranged;
+
+	return nullptr;
+}
+} // namespace
+
+
+TEST(ParameterSnapshot, ReportsEveryParameterAfterAttach)
+{
+	PluginProcessor	  processor;
+	ParameterSnapshot snapshot;
+	snapshot.attach(processor);
+
+	int numChanged = 0;
+	snapshot.forEachChanged([&numChanged](ParamId, float) { ++numChanged; });
+	EXPECT_EQ(numChanged, static_cast<int>(processor.getParameters().size()));
+
+	// Pulling clears the changes
+	numChanged = 0;
+	snapshot.forEachChanged([&numChanged](ParamId, float) { ++numChanged; });
+	EXPECT_EQ(numChanged, 0);
+}
+
+
+TEST(ParameterSnapshot, ReportsOnlyChangedParameters)
+{
+	PluginProcessor	  processor;
+	ParameterSnapshot snapshot;
+	snapshot.attach(processor);
+	snapshot.forEachChanged([](ParamId, float) {});
+
+	auto *drive = findParameter(processor, paramDistortionDrive);
+	ASSERT_NE(drive, nullptr);
+
+	// Several changes between two blocks arrive as one with the latest value
+	drive->setValueNotifyingHost(drive->convertTo0to1(6.0f));
+	drive->setValueNotifyingHost(drive->convertTo0to1(12.0f));
+
+	std::vector<std::pair<ParamId, float>> changes;
+	snapshot.forEachChanged([&changes](ParamId id, float value) { changes.emplace_back(id, value); });
+
+	ASSERT_EQ(changes.size(), 1u);
+	EXPECT_EQ(changes[0].first, ParamId::DistortionDrive);
+	EXPECT_NEAR(changes[0].second, 12.0f, 1.0e-4f);
+}
+
+
+TEST(ParameterSnapshot, DetachStopsListening)
+{
+	PluginProcessor	  processor;
+	ParameterSnapshot snapshot;
+	snapshot.attach(processor);
+	snapshot.detach();
+
+	auto *drive = findParameter(processor, paramDistortionDrive);
+	ASSERT_NE(drive, nullptr);
+	drive->setValueNotifyingHost(0.5f);
+
+	int numChanged = 0;
+	snapshot.forEachChanged([&numChanged](ParamId, float) { ++numChanged; });
+	EXPECT_EQ(numChanged, 0);
+}
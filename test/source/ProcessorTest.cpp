@@ -27,3 +27,229 @@ TEST(PluginProcessor, ProcessBlock)
 	ASSERT_NE(buffer.getSample(0, 0), 0.0f); // Expect processing to occur
 }
 
+
+
+TEST(PluginProcessor, TailLengthFollowsTheDelay)
+{
+	PluginProcessor processor;
+	processor.prepareToPlay(48000, 512);
+
+	const double			 defaultTail = processor.getTailLengthSeconds();
+	EXPECT_GT(defaultTail, 0.0);
+
+	juce::AudioBuffer<float> buffer(2, 512);
+	juce::MidiBuffer		 midi;
+
+	// Full feedback never decays
+	processor.getParameters()[static_cast<int>(toIndex(ParamId::DelayFeedback))]->setValueNotifyingHost(1.0f);
+	buffer.clear();
+	processor.processBlock(buffer, midi);
+	EXPECT_TRUE(std::isinf(processor.getTailLengthSeconds()));
+
+	processor.getParameters()[static_cast<int>(toIndex(ParamId::DelayBypass))]->setValueNotifyingHost(1.0f);
+	buffer.clear();
+	processor.processBlock(buffer, midi);
+	EXPECT_LT(processor.getTailLengthSeconds(), defaultTail);
+}
+
+
+TEST(PluginProcessor, SilentInputStaysSilent)
+{
+	PluginProcessor processor;
+	processor.prepareToPlay(48000, 512);
+
+	juce::AudioBuffer<float> buffer(2, 512);
+	juce::MidiBuffer		 midi;
+
+	for (int block = 0; block < 200; ++block)
+	{
+		buffer.clear();
+		processor.processBlock(buffer, midi);
+		ASSERT_EQ(buffer.getMagnitude(0, 512), 0.0f) << "block " << block;
+	}
+}
+
+
+TEST(PluginProcessor, DoublePrecisionMatchesSinglePrecision)
+{
+	PluginProcessor floatProcessor;
+	PluginProcessor doubleProcessor;
+
+	EXPECT_TRUE(doubleProcessor.supportsDoublePrecisionProcessing());
+
+	doubleProcessor.setProcessingPrecision(juce::AudioProcessor::doublePrecision);
+	ASSERT_TRUE(doubleProcessor.isUsingDoublePrecision());
+
+	// An audible delay with feedback, so the state of every block carries into the next
+	for (auto *processor : {&floatProcessor, &doubleProcessor})
+	{
+		processor->getParameters()[static_cast<int>(toIndex(ParamId::DelayFeedback))]->setValueNotifyingHost(0.5f);
+		processor->getParameters()[static_cast<int>(toIndex(ParamId::DelayMix))]->setValueNotifyingHost(0.5f);
+		processor->prepareToPlay(48000, 256);
+	}
+
+	juce::AudioBuffer<float>  floatBuffer(2, 256);
+	juce::AudioBuffer<double> doubleBuffer(2, 256);
+	juce::MidiBuffer		  midi;
+
+	for (int block = 0; block < 20; ++block)
+	{
+		for (int channel = 0; channel < 2; ++channel)
+		{
+			for (int i = 0; i < 256; ++i)
+			{
+				const double input = 0.5 * std::sin(0.01 * (block * 256 + i) + channel);
+				floatBuffer.setSample(channel, i, static_cast<float>(input));
+				doubleBuffer.setSample(channel, i, input);
+			}
+		}
+
+		floatProcessor.processBlock(floatBuffer, midi);
+		doubleProcessor.processBlock(doubleBuffer, midi);
+
+		for (int channel = 0; channel < 2; ++channel)
+			for (int i = 0; i < 256; ++i)
+				ASSERT_NEAR(floatBuffer.getSample(channel, i), doubleBuffer.getSample(channel, i), 1.0e-4) << "block " << block << ", sample " << i;
+	}
+
+	EXPECT_DOUBLE_EQ(floatProcessor.getTailLengthSeconds(), doubleProcessor.getTailLengthSeconds());
+}
+
+
+TEST(PluginProcessor, TimedChangesSplitTheBlock)
+{
+	PluginProcessor processor;
+
+	// Without effects only the output gain shapes the block
+	for (auto id : {ParamId::DistortionBypass, ParamId::DelayBypass, ParamId::PannerBypass})
+		processor.getParameters()[static_cast<int>(toIndex(id))]->setValueNotifyingHost(1.0f);
+
+	processor.prepareToPlay(48000, 512);
+
+	juce::AudioBuffer<float> buffer(2, 512);
+	juce::MidiBuffer		 midi;
+
+	for (int channel = 0; channel < 2; ++channel)
+		for (int i = 0; i < 512; ++i)
+			buffer.setSample(channel, i, 0.5f);
+
+	// The second change is closer than the shortest part to the first and lands at the next split
+	ASSERT_TRUE(processor.addParameterChange(ParamId::Output, 128, -6.0f));
+	ASSERT_TRUE(processor.addParameterChange(ParamId::Output, 140, -12.0f));
+
+	processor.processBlock(buffer, midi);
+
+	// The level holds until the first change point and then ramps towards the changes without a jump at the splits
+	const float stepLimit	= 0.5f * (1.0f - juce::Decibels::decibelsToGain(-12.0f)) / 960.0f * 2.0f;
+	float		largestStep = 0.0f;
+
+	for (int i = 0; i < 128; ++i)
+		ASSERT_NEAR(buffer.getSample(0, i), 0.5f, 1.0e-6f) << "sample " << i;
+
+	for (int i = 128; i < 512; ++i)
+		largestStep = juce::jmax(largestStep, std::abs(buffer.getSample(0, i) - buffer.getSample(0, i - 1)));
+
+	EXPECT_LT(buffer.getSample(0, 511), buffer.getSample(0, 128));
+	EXPECT_GT(largestStep, 0.0f);
+	EXPECT_LT(largestStep, stepLimit);
+
+	// The 20 ms ramp ends in the following blocks, the last value holds from there on
+	for (int block = 0; block < 3; ++block)
+	{
+		for (int channel = 0; channel < 2; ++channel)
+			for (int i = 0; i < 512; ++i)
+				buffer.setSample(channel, i, 0.5f);
+
+		processor.processBlock(buffer, midi);
+	}
+
+	EXPECT_NEAR(buffer.getSample(1, 0), 0.5f * juce::Decibels::decibelsToGain(-12.0f), 1.0e-6f);
+	EXPECT_NEAR(buffer.getSample(1, 511), 0.5f * juce::Decibels::decibelsToGain(-12.0f), 1.0e-6f);
+}
+
+
+TEST(PluginProcessor, SurroundLayoutsAreSupported)
+{
+	PluginProcessor processor;
+
+	auto			isSupported = [&processor](const juce::AudioChannelSet &input, const juce::AudioChannelSet &output)
+	{
+		juce::AudioProcessor::BusesLayout layout;
+		layout.inputBuses.add(input);
+		layout.outputBuses.add(output);
+		return processor.isBusesLayoutSupported(layout);
+	};
+
+	for (const auto &set : {juce::AudioChannelSet::mono(), juce::AudioChannelSet::stereo(), juce::AudioChannelSet::create5point1(), juce::AudioChannelSet::create7point1(),
+							juce::AudioChannelSet::create7point1point4()})
+		EXPECT_TRUE(isSupported(set, set)) << set.size() << " channels";
+
+	// Layouts without speaker directions, and a different layout on the way out
+	EXPECT_FALSE(isSupported(juce::AudioChannelSet::discreteChannels(4), juce::AudioChannelSet::discreteChannels(4)));
+	EXPECT_FALSE(isSupported(juce::AudioChannelSet::create5point1(), juce::AudioChannelSet::create7point1()));
+}
+
+
+TEST(PluginProcessor, SurroundChannelsFollowTheDelayTimes)
+{
+	const auto layout = juce::AudioChannelSet::create5point1();
+
+	// Parameter values are normalised, the delay times span 0 .. 2000 ms
+	for (const float delayModel : {0.0f, 0.5f})
+	{
+		PluginProcessor					  processor;
+		juce::AudioProcessor::BusesLayout buses;
+		buses.inputBuses.add(layout);
+		buses.outputBuses.add(layout);
+		ASSERT_TRUE(processor.setBusesLayout(buses));
+
+		auto setParameter = [&processor](ParamId id, float value) { processor.getParameters()[static_cast<int>(toIndex(id))]->setValueNotifyingHost(value); };
+
+		// Only the delay, fully wet, 10 ms on the left and 20 ms on the right
+		setParameter(ParamId::DistortionBypass, 1.0f);
+		setParameter(ParamId::PannerBypass, 1.0f);
+		setParameter(ParamId::DelayMix, 1.0f);
+		setParameter(ParamId::DelayFeedback, 0.0f);
+		setParameter(ParamId::DelayTimeLeft, 10.0f / delayTimeMax);
+		setParameter(ParamId::DelayTimeRight, 20.0f / delayTimeMax);
+		setParameter(ParamId::DelayModel, delayModel); // Single Tap, Ping Pong
+		processor.prepareToPlay(48000, 1024);
+
+		juce::AudioBuffer<float> buffer(layout.size(), 1024);
+		juce::MidiBuffer		 midi;
+
+		// The repeats stay within the block, so every block looks the same once the 20 ms ramps of the mix and the
+		// delay times have passed. Idle blocks would not move the ramps on.
+		for (int block = 0; block < 4; ++block)
+		{
+			buffer.clear();
+
+			for (int channel = 0; channel < layout.size(); ++channel)
+				buffer.setSample(channel, 0, 1.0f);
+
+			processor.processBlock(buffer, midi);
+		}
+
+		// The surround pair repeats like the front pair, the centre on its own after the left time, also in ping pong,
+		// which feeds the left line with the mono sum of each pair. The LFE stays dry.
+		for (int channel = 0; channel < layout.size(); ++channel)
+		{
+			const auto type = layout.getTypeOfChannel(channel);
+
+			if (type == juce::AudioChannelSet::LFE)
+			{
+				EXPECT_NEAR(buffer.getSample(channel, 0), 1.0f, 1.0e-6f);
+				EXPECT_NEAR(buffer.getSample(channel, 480), 0.0f, 1.0e-6f);
+				EXPECT_NEAR(buffer.getSample(channel, 960), 0.0f, 1.0e-6f);
+				continue;
+			}
+
+			const bool	isRight		   = type == juce::AudioChannelSet::right || type == juce::AudioChannelSet::rightSurround;
+			const int	delayInSamples = isRight ? 960 : 480;
+			const float expected	   = delayModel == 0.0f || !isRight ? 1.0f : 0.0f;
+
+			EXPECT_NEAR(buffer.getSample(channel, 0), 0.0f, 1.0e-6f) << "channel " << channel;
+			EXPECT_NEAR(buffer.getSample(channel, delayInSamples), expected, 1.0e-5f) << "channel " << channel;
+		}
+	}
+}
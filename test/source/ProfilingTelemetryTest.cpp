@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include "PluginProcessor.h"
+#include "ProfilingTelemetry.h"
+
+
+TEST(ProfilingTelemetry, StatisticsOfTheRecordedTicks)
+{
+	ProfilingTelemetry telemetry;
+
+	// 1 ... 100 ticks, 10 samples each
+	for (int ticks = 1; ticks <= 100; ++ticks)
+		telemetry.record(2, static_cast<uint64_t>(ticks), 10);
+
+	// Nothing is visible before the reader collects
+	EXPECT_EQ(telemetry.getStatistics(2).count, 0u);
+
+	telemetry.collect();
+
+	const auto statistics = telemetry.getStatistics(2);
+	EXPECT_EQ(statistics.count, 100u);
+	EXPECT_EQ(statistics.minTicks, 1u);
+	EXPECT_EQ(statistics.maxTicks, 100u);
+	EXPECT_DOUBLE_EQ(statistics.meanTicks, 50.5);
+	EXPECT_DOUBLE_EQ(statistics.meanTicksPerSample, 5.05);
+
+	// Within the bucket resolution of 1/16
+	EXPECT_NEAR(static_cast<double>(statistics.p99Ticks), 99.0, 99.0 / 16.0);
+
+	EXPECT_EQ(telemetry.getStatistics(0).count, 0u);
+	EXPECT_EQ(telemetry.getStatistics(ProfilingTelemetry::maxNumProbes).count, 0u);
+}
+
+
+TEST(ProfilingTelemetry, PercentileFollowsTheOutliers)
+{
+	ProfilingTelemetry telemetry;
+
+	for (int block = 0; block < 980; ++block)
+		telemetry.record(0, 1000, 64);
+
+	for (int block = 0; block < 20; ++block)
+		telemetry.record(0, 1000000, 64);
+
+	telemetry.collect();
+
+	const auto statistics = telemetry.getStatistics(0);
+	EXPECT_NEAR(static_cast<double>(statistics.p99Ticks), 1000000.0, 1000000.0 / 16.0);
+	EXPECT_EQ(statistics.maxTicks, 1000000u);
+}
+
+
+TEST(ProfilingTelemetry, FullRingDropsMeasurements)
+{
+	ProfilingTelemetry telemetry;
+
+	for (int block = 0; block < 5000; ++block)
+		telemetry.record(1, 10, 1);
+
+	EXPECT_EQ(telemetry.getNumDropped(), 5000u - 4096u);
+
+	// Collecting frees the ring again
+	telemetry.collect();
+	telemetry.record(1, 10, 1);
+	telemetry.collect();
+
+	EXPECT_EQ(telemetry.getStatistics(1).count, 4097u);
+
+	telemetry.resetStatistics();
+	EXPECT_EQ(telemetry.getStatistics(1).count, 0u);
+	EXPECT_EQ(telemetry.getNumDropped(), 0u);
+}
+
+
+TEST(ProfilingTelemetry, ProbesOnlyMeasureSampledBlocks)
+{
+	ProfilingTelemetry telemetry;
+	telemetry.setSamplingInterval(16);
+
+	int				   numSampled = 0;
+
+	for (int block = 0; block < 64; ++block)
+	{
+		telemetry.beginBlock();
+		numSampled += telemetry.isBlockSampled() ? 1 : 0;
+
+		ScopedProfilingProbe probe(&telemetry, 3, 32);
+	}
+
+	telemetry.collect();
+
+	EXPECT_EQ(numSampled, 4);
+	EXPECT_EQ(telemetry.getStatistics(3).count, MULTIEFFECT_PROFILING ? 4u : 0u);
+}
+
+
+TEST(ProfilingTelemetry, ProbesOfTheProcessor)
+{
+	PluginProcessor processor;
+	processor.prepareToPlay(48000.0, 256);
+	processor.getTelemetry().setSamplingInterval(1);
+
+	juce::AudioBuffer<float> buffer(2, 256);
+	juce::MidiBuffer		 midi;
+
+	for (int block = 0; block < 10; ++block)
+	{
+		buffer.clear();
+		processor.processBlock(buffer, midi);
+	}
+
+	auto &telemetry = processor.getTelemetry();
+	telemetry.collect();
+
+#if MULTIEFFECT_PROFILING
+	EXPECT_EQ(telemetry.getStatistics(ProfilingTelemetry::processBlockProbe).count, 10u);
+
+	for (int slot = 0; slot < NumEffectSlots; ++slot)
+	{
+		const auto effect = telemetry.getStatistics(slot);
+		EXPECT_EQ(effect.count, 10u);
+		EXPECT_LE(effect.maxTicks, telemetry.getStatistics(ProfilingTelemetry::processBlockProbe).maxTicks);
+	}
+#else
+	// Compiled out
+	EXPECT_EQ(telemetry.getStatistics(ProfilingTelemetry::processBlockProbe).count, 0u);
+#endif
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include "QuadratureOscillator.h"
+#include "PanGainTable.h"
+
+
+TEST(QuadratureOscillator, FollowsTheSineAtEverySampleRate)
+{
+	for (double sampleRate : {44100.0, 48000.0, 96000.0, 192000.0})
+	{
+		QuadratureOscillator<float> lfo;
+		lfo.prepare(sampleRate);
+		lfo.setFrequency(5.0);
+
+		// One minute of audio in blocks of 512 samples, the renormalisation keeps the phasor on the unit circle
+		std::vector<float> block(512);
+		const int		   numBlocks = static_cast<int>(60.0 * sampleRate) / 512;
+
+		for (int blockIndex = 0; blockIndex < numBlocks; ++blockIndex)
+			lfo.process(block.data(), 512);
+
+		const double time	  = static_cast<double>(numBlocks) * 512.0 / sampleRate;
+		const double expected = std::sin(juce::MathConstants<double>::twoPi * 5.0 * time);
+
+		EXPECT_NEAR(lfo.getSine(), expected, 1.0e-5) << "sample rate " << sampleRate;
+		EXPECT_NEAR(std::hypot(lfo.getSine(), lfo.getCosine()), 1.0, 1.0e-6) << "sample rate " << sampleRate;
+	}
+}
+
+
+TEST(QuadratureOscillator, AdvanceMatchesProcess)
+{
+	QuadratureOscillator<double> rendered, skipped;
+
+	for (auto *lfo : {&rendered, &skipped})
+	{
+		lfo->prepare(48000.0);
+		lfo->setFrequency(3.0);
+	}
+
+	std::vector<double> block(480);
+	for (int blockIndex = 0; blockIndex < 25; ++blockIndex)
+	{
+		rendered.process(block.data(), 480);
+		skipped.advance(480);
+	}
+
+	EXPECT_NEAR(rendered.getSine(), skipped.getSine(), 1.0e-12);
+	EXPECT_NEAR(rendered.getCosine(), skipped.getCosine(), 1.0e-12);
+}
+
+
+TEST(PanGainTable, MatchesTheConstantPowerLaw)
+{
+	PanGainTable<double> table;
+
+	for (int i = -1000; i <= 1000; ++i)
+	{
+		const double pan   = i / 1000.0;
+		const double angle = juce::MathConstants<double>::pi * (pan + 1.0) * 0.25;
+		double		 left = 0.0, right = 0.0;
+		table.getGains(pan, left, right);
+
+		ASSERT_NEAR(left, std::cos(angle), 1.2e-6) << "pan " << pan;
+		ASSERT_NEAR(right, std::sin(angle), 1.2e-6) << "pan " << pan;
+	}
+
+	// Clamped outside of the range
+	double left = 0.0, right = 0.0;
+	table.getGains(2.0, left, right);
+	EXPECT_NEAR(left, 0.0, 1.0e-12);
+	EXPECT_NEAR(right, 1.0, 1.0e-12);
+}
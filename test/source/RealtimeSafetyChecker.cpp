@@ -0,0 +1,326 @@
+#include "RealtimeSafetyChecker.h"
+
+#include "RealtimeSafety.h"
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <new>
+
+#if defined(__SANITIZE_ADDRESS__)
+	#define REALTIME_SAFETY_CHECKER_ENABLED 0
+#elif defined(__has_feature)
+	#if __has_feature(address_sanitizer)
+		#define REALTIME_SAFETY_CHECKER_ENABLED 0
+	#endif
+#endif
+
+#if !defined(REALTIME_SAFETY_CHECKER_ENABLED)
+	#if defined(__linux__) && defined(__GLIBC__)
+		#define REALTIME_SAFETY_CHECKER_ENABLED 1
+	#else
+		#define REALTIME_SAFETY_CHECKER_ENABLED 0
+	#endif
+#endif
+
+
+namespace
+{
+// Plain atomics only, recording may not allocate or lock itself
+std::array<std::atomic<int>, RealtimeSafetyChecker::NumViolationKinds> violationCounts{};
+
+std::atomic<bool>														hasFirstViolation{false};
+std::atomic<int>														firstViolationKind{0};
+std::atomic<size_t>														firstViolationSize{0};
+
+
+[[maybe_unused]] void recordViolation(RealtimeSafetyChecker::ViolationKind kind, size_t size)
+{
+	if (!RealtimeSafety::isInRealtimeSection())
+		return;
+
+	violationCounts[kind].fetch_add(1, std::memory_order_relaxed);
+
+	bool expected = false;
+
+	if (hasFirstViolation.compare_exchange_strong(expected, true))
+	{
+		firstViolationKind.store(kind);
+		firstViolationSize.store(size);
+	}
+}
+} // namespace
+
+
+namespace RealtimeSafetyChecker
+{
+
+bool isSupported()
+{
+	return REALTIME_SAFETY_CHECKER_ENABLED != 0;
+}
+
+
+void resetViolations()
+{
+	for (auto &count : violationCounts)
+		count.store(0);
+
+	firstViolationKind.store(0);
+	firstViolationSize.store(0);
+	hasFirstViolation.store(false);
+}
+
+
+int getNumViolations(ViolationKind kind)
+{
+	return violationCounts[kind].load();
+}
+
+
+int getTotalNumViolations()
+{
+	int total = 0;
+
+	for (const auto &count : violationCounts)
+		total += count.load();
+
+	return total;
+}
+
+
+ViolationKind getFirstViolationKind()
+{
+	return static_cast<ViolationKind>(firstViolationKind.load());
+}
+
+
+size_t getFirstViolationSize()
+{
+	return firstViolationSize.load();
+}
+
+
+const char *getViolationName(ViolationKind kind)
+{
+	switch (kind)
+	{
+	case Allocation: return "allocation";
+	case Deallocation: return "deallocation";
+	case MutexLock: return "mutex lock";
+	default: return "unknown";
+	}
+}
+
+} // namespace RealtimeSafetyChecker
+
+
+#if REALTIME_SAFETY_CHECKER_ENABLED
+
+	#include <dlfcn.h>
+	#include <pthread.h>
+
+//==============================================================================
+// Interposed functions. The executable defines them, so every call from the
+// plugin code, the C++ runtime and JUCE binds here first. glibc exports its own
+// allocator as __libc_*, the mutex is looked up once with dlsym.
+//==============================================================================
+
+extern "C"
+{
+	void *__libc_malloc(size_t size);
+	void *__libc_calloc(size_t count, size_t size);
+	void *__libc_realloc(void *pointer, size_t size);
+	void *__libc_memalign(size_t alignment, size_t size);
+	void  __libc_free(void *pointer);
+
+
+	void *malloc(size_t size)
+	{
+		recordViolation(RealtimeSafetyChecker::Allocation, size);
+		return __libc_malloc(size);
+	}
+
+
+	void *calloc(size_t count, size_t size)
+	{
+		recordViolation(RealtimeSafetyChecker::Allocation, count * size);
+		return __libc_calloc(count, size);
+	}
+
+
+	void *realloc(void *pointer, size_t size)
+	{
+		recordViolation(RealtimeSafetyChecker::Allocation, size);
+		return __libc_realloc(pointer, size);
+	}
+
+
+	void *memalign(size_t alignment, size_t size)
+	{
+		recordViolation(RealtimeSafetyChecker::Allocation, size);
+		return __libc_memalign(alignment, size);
+	}
+
+
+	void *aligned_alloc(size_t alignment, size_t size)
+	{
+		recordViolation(RealtimeSafetyChecker::Allocation, size);
+		return __libc_memalign(alignment, size);
+	}
+
+
+	int posix_memalign(void **result, size_t alignment, size_t size)
+	{
+		recordViolation(RealtimeSafetyChecker::Allocation, size);
+
+		void *pointer = __libc_memalign(alignment, size);
+
+		if (pointer == nullptr)
+			return ENOMEM;
+
+		*result = pointer;
+		return 0;
+	}
+
+
+	void free(void *pointer)
+	{
+		if (pointer != nullptr)
+			recordViolation(RealtimeSafetyChecker::Deallocation, 0);
+
+		__libc_free(pointer);
+	}
+
+
+	int pthread_mutex_lock(pthread_mutex_t *mutex)
+	{
+		using LockFunction = int (*)(pthread_mutex_t *);
+
+		// No function local static, its guard could lock a mutex itself
+		static std::atomic<LockFunction> realLock{nullptr};
+
+		auto							 lock = realLock.load(std::memory_order_acquire);
+
+		if (lock == nullptr)
+		{
+			lock = reinterpret_cast<LockFunction>(dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+			realLock.store(lock, std::memory_order_release);
+		}
+
+		recordViolation(RealtimeSafetyChecker::MutexLock, 0);
+		return lock(mutex);
+	}
+}
+
+
+namespace
+{
+void *allocate(size_t size, bool shouldThrow)
+{
+	recordViolation(RealtimeSafetyChecker::Allocation, size);
+
+	void *pointer = __libc_malloc(size == 0 ? 1 : size);
+
+	if (pointer == nullptr && shouldThrow)
+		throw std::bad_alloc();
+
+	return pointer;
+}
+
+
+void *allocateAligned(size_t size, std::align_val_t alignment, bool shouldThrow)
+{
+	recordViolation(RealtimeSafetyChecker::Allocation, size);
+
+	void *pointer = __libc_memalign(static_cast<size_t>(alignment), size == 0 ? 1 : size);
+
+	if (pointer == nullptr && shouldThrow)
+		throw std::bad_alloc();
+
+	return pointer;
+}
+
+
+void deallocate(void *pointer)
+{
+	if (pointer != nullptr)
+		recordViolation(RealtimeSafetyChecker::Deallocation, 0);
+
+	__libc_free(pointer);
+}
+} // namespace
+
+
+// Recorded once here instead of again in malloc/free
+void *operator new(size_t size)
+{
+	return allocate(size, true);
+}
+
+void *operator new[](size_t size)
+{
+	return allocate(size, true);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+	return allocate(size, false);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+	return allocate(size, false);
+}
+
+void *operator new(size_t size, std::align_val_t alignment)
+{
+	return allocateAligned(size, alignment, true);
+}
+
+void *operator new[](size_t size, std::align_val_t alignment)
+{
+	return allocateAligned(size, alignment, true);
+}
+
+void operator delete(void *pointer) noexcept
+{
+	deallocate(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+	deallocate(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept
+{
+	deallocate(pointer);
+}
+
+void operator delete[](void *pointer, size_t) noexcept
+{
+	deallocate(pointer);
+}
+
+void operator delete(void *pointer, std::align_val_t) noexcept
+{
+	deallocate(pointer);
+}
+
+void operator delete[](void *pointer, std::align_val_t) noexcept
+{
+	deallocate(pointer);
+}
+
+void operator delete(void *pointer, size_t, std::align_val_t) noexcept
+{
+	deallocate(pointer);
+}
+
+void operator delete[](void *pointer, size_t, std::align_val_t) noexcept
+{
+	deallocate(pointer);
+}
+
+#endif
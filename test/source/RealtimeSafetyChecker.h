@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+
+
+//==============================================================================
+// Counts the calls that are not real-time safe while a ScopedRealtimeSection is
+// open on the calling thread. RealtimeSafetyChecker.cpp replaces malloc/free,
+// operator new/delete and pthread_mutex_lock of the test executable and
+// forwards to the C library after recording the call. Only available on Linux
+// with glibc (and not together with the address sanitizer, which replaces the
+// allocator itself), elsewhere isSupported() is false and nothing is counted.
+//==============================================================================
+
+namespace RealtimeSafetyChecker
+{
+
+enum ViolationKind
+{
+	Allocation = 0,
+	Deallocation,
+	MutexLock,
+	NumViolationKinds
+};
+
+
+bool		isSupported();
+
+void		resetViolations();
+
+int			getNumViolations(ViolationKind kind);
+
+int			getTotalNumViolations();
+
+// Kind and size of the first violation since the last reset, the size is 0 for frees and locks
+ViolationKind getFirstViolationKind();
+size_t		getFirstViolationSize();
+
+const char *getViolationName(ViolationKind kind);
+
+} // namespace RealtimeSafetyChecker
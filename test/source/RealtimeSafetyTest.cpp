@@ -0,0 +1,269 @@
+#include <gtest/gtest.h>
+
+#include "PluginProcessor.h"
+#include "RealtimeSafetyChecker.h"
+
+#include <mutex>
+#include <random>
+
+
+namespace
+{
+class RealtimeSafetyTest : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		if (!RealtimeSafetyChecker::isSupported())
+			GTEST_SKIP() << "The real-time safety checker needs Linux with glibc and no address sanitizer";
+
+		RealtimeSafetyChecker::resetViolations();
+	}
+
+
+	static void expectNoViolations(const char *context)
+	{
+		const int numViolations = RealtimeSafetyChecker::getTotalNumViolations();
+
+		EXPECT_EQ(numViolations, 0) << context << ": first violation was a " << RealtimeSafetyChecker::getViolationName(RealtimeSafetyChecker::getFirstViolationKind())
+									<< " of " << RealtimeSafetyChecker::getFirstViolationSize() << " bytes ("
+									<< RealtimeSafetyChecker::getNumViolations(RealtimeSafetyChecker::Allocation) << " allocations, "
+									<< RealtimeSafetyChecker::getNumViolations(RealtimeSafetyChecker::Deallocation) << " deallocations, "
+									<< RealtimeSafetyChecker::getNumViolations(RealtimeSafetyChecker::MutexLock) << " mutex locks)";
+	}
+};
+
+
+// Opens a section around the wrapped effect. The plugin is built without MULTIEFFECT_REALTIME_CHECKS, so the section
+// the chain opens on the workers of the pool does not count
+template <typename SampleType>
+class RealtimeSectionEffect : public EffectBase<SampleType>
+{
+public:
+	explicit RealtimeSectionEffect(EffectBase<SampleType> &effect) : mEffect(effect) {}
+
+	void	   prepare(const juce::dsp::ProcessSpec &spec) override { mEffect.prepare(spec); }
+	void	   reset() override { mEffect.reset(); }
+	EffectType getEffectType() const override { return mEffect.getEffectType(); }
+
+	void	   process(juce::AudioBuffer<SampleType> &buffer) override
+	{
+		RealtimeSafety::ScopedRealtimeSection section;
+		mEffect.process(buffer);
+	}
+
+	void	   setParameter(ParamId id, float value) override { mEffect.setParameter(id, value); }
+	double	   getTailLengthSeconds() const override { return mEffect.getTailLengthSeconds(); }
+	float	   getLatencyInSamples() const override { return mEffect.getLatencyInSamples(); }
+	float	   getMaxLatencyInSamples() const override { return mEffect.getMaxLatencyInSamples(); }
+
+private:
+	EffectBase<SampleType> &mEffect;
+};
+
+
+// Host automation arrives between the blocks, with a normalised value per parameter
+void automateRandomParameters(PluginProcessor &processor, std::mt19937 &random, int numChanges)
+{
+	const auto							 &parameters = processor.getParameters();
+	std::uniform_int_distribution<int>	  pickParameter(0, static_cast<int>(parameters.size()) - 1);
+	std::uniform_real_distribution<float> pickValue(0.0f, 1.0f);
+
+	for (int change = 0; change < numChanges; ++change)
+		parameters[pickParameter(random)]->setValueNotifyingHost(pickValue(random));
+}
+} // namespace
+
+
+TEST_F(RealtimeSafetyTest, CheckerDetectsViolationsInsideASection)
+{
+	std::mutex mutex;
+
+	{
+		auto outside = std::make_unique<int>(1);
+		std::lock_guard<std::mutex> lock(mutex);
+	}
+
+	EXPECT_EQ(RealtimeSafetyChecker::getTotalNumViolations(), 0);
+
+	{
+		RealtimeSafety::ScopedRealtimeSection section;
+
+		auto								  inside = std::make_unique<int>(1);
+		std::lock_guard<std::mutex>			  lock(mutex);
+	}
+
+	EXPECT_EQ(RealtimeSafetyChecker::getNumViolations(RealtimeSafetyChecker::Allocation), 1);
+	EXPECT_EQ(RealtimeSafetyChecker::getNumViolations(RealtimeSafetyChecker::Deallocation), 1);
+	EXPECT_EQ(RealtimeSafetyChecker::getNumViolations(RealtimeSafetyChecker::MutexLock), 1);
+	EXPECT_EQ(RealtimeSafetyChecker::getFirstViolationKind(), RealtimeSafetyChecker::Allocation);
+	EXPECT_EQ(RealtimeSafetyChecker::getFirstViolationSize(), sizeof(int));
+}
+
+
+TEST_F(RealtimeSafetyTest, ProcessBlockUnderRandomAutomation)
+{
+	constexpr int			 maxBlockSize = 512;
+	constexpr int			 numBlocks	  = 2000;
+
+	PluginProcessor			 processor;
+	processor.prepareToPlay(48000.0, maxBlockSize);
+
+	juce::AudioBuffer<float> buffer(2, maxBlockSize);
+	juce::MidiBuffer		 midi;
+
+	std::mt19937			 random(0x5eed);
+	std::uniform_int_distribution<int> pickBlockSize(1, maxBlockSize);
+	std::uniform_int_distribution<int> pickNumChanges(0, 4);
+	std::normal_distribution<float>	   pickSample(0.0f, 0.3f);
+
+	RealtimeSafetyChecker::resetViolations();
+
+	for (int block = 0; block < numBlocks; ++block)
+	{
+		automateRandomParameters(processor, random, pickNumChanges(random));
+
+		// Hosts may send any block size up to the prepared one
+		buffer.setSize(2, pickBlockSize(random), false, false, true);
+
+		for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+			for (int i = 0; i < buffer.getNumSamples(); ++i)
+				buffer.setSample(channel, i, pickSample(random));
+
+		// The plugin itself is built without MULTIEFFECT_REALTIME_CHECKS, its own sections do not count
+		{
+			RealtimeSafety::ScopedRealtimeSection section;
+			processor.processBlock(buffer, midi);
+		}
+
+		if (RealtimeSafetyChecker::getTotalNumViolations() > 0)
+			break;
+	}
+
+	expectNoViolations("processBlock");
+}
+
+
+TEST_F(RealtimeSafetyTest, EffectsUnderRandomAutomation)
+{
+	constexpr int			 maxBlockSize = 256;
+	juce::dsp::ProcessSpec	 spec{48000.0, static_cast<juce::uint32>(maxBlockSize), 2};
+
+	Distortion<double>		 distortion;
+	Delay<double>			 delay;
+	PannerManager<double>	 panner;
+	distortion.prepare(spec);
+	delay.prepare(spec, 2000.0f);
+	panner.prepare(spec);
+
+	std::array<EffectBase<double> *, 3> effects{&distortion, &delay, &panner};
+
+	juce::AudioBuffer<double> buffer(2, maxBlockSize);
+	std::mt19937			  random(0xdecaf);
+	std::uniform_int_distribution<int> pickId(0, numParameters - 1);
+	std::uniform_real_distribution<float> pickValue(0.0f, 1.0f);
+
+	RealtimeSafetyChecker::resetViolations();
+
+	for (int block = 0; block < 1000; ++block)
+	{
+		// The effects take plain values, in the range of the parameter
+		const auto &info  = getParameterInfo(static_cast<ParamId>(pickId(random)));
+		float		value = info.minValue + pickValue(random) * (info.maxValue - info.minValue);
+
+		if (info.kind != ParameterKind::Float)
+			value = std::round(value);
+
+		for (auto *effect : effects)
+		{
+			effect->setParameter(info.id, value);
+
+			buffer.clear();
+			buffer.setSample(0, 0, 1.0);
+
+			RealtimeSafety::ScopedRealtimeSection section;
+			effect->process(buffer);
+		}
+	}
+
+	expectNoViolations("EffectBase::process");
+}
+
+
+TEST_F(RealtimeSafetyTest, ParallelBranchesOnTheThreadPool)
+{
+	constexpr int			 maxBlockSize = 512;
+	juce::dsp::ProcessSpec	 spec{48000.0, static_cast<juce::uint32>(maxBlockSize), 2};
+
+	Distortion<float>		 distortion;
+	Delay<float>			 delay;
+	PannerManager<float>	 panner;
+	distortion.prepare(spec);
+	delay.prepare(spec, 2000.0f);
+	panner.prepare(spec);
+
+	// The oversampled distortion has a latency the other branches are aligned to
+	distortion.setCurrentDistortionType(DistortionType::softClipping);
+	delay.setParameter(ParamId::DelayTimeLeft, 250.0f);
+	delay.setParameter(ParamId::DelayTimeRight, 375.0f);
+
+	RealtimeSectionEffect<float> checkedDistortion(distortion);
+	RealtimeSectionEffect<float> checkedDelay(delay);
+	RealtimeSectionEffect<float> checkedPanner(panner);
+	std::array<EffectBase<float> *, 3> effects{&checkedDistortion, &checkedDelay, &checkedPanner};
+
+	EffectChain<float>		 chain;
+	for (auto *effect : effects)
+		chain.addEffect(*effect);
+
+	chain.setRouting(ChainRouting::ParallelRouting);
+	chain.prepare(2, maxBlockSize);
+
+	// Every block goes to the workers, however small
+	RealtimeThreadPool pool;
+	pool.start(2);
+	chain.setThreadPool(&pool);
+	chain.setCostModelEnabled(false);
+
+	juce::AudioBuffer<float> buffer(2, maxBlockSize);
+	std::mt19937			 random(0xb4a7c4);
+	std::uniform_int_distribution<int>	  pickBlockSize(1, maxBlockSize);
+	std::uniform_int_distribution<int>	  pickId(0, numParameters - 1);
+	std::uniform_real_distribution<float> pickValue(0.0f, 1.0f);
+	std::normal_distribution<float>		  pickSample(0.0f, 0.3f);
+
+	RealtimeSafetyChecker::resetViolations();
+
+	for (int block = 0; block < 1000; ++block)
+	{
+		// The effects take plain values, in the range of the parameter
+		const auto &info  = getParameterInfo(static_cast<ParamId>(pickId(random)));
+		float		value = info.minValue + pickValue(random) * (info.maxValue - info.minValue);
+
+		if (info.kind != ParameterKind::Float)
+			value = std::round(value);
+
+		for (auto *effect : effects)
+			effect->setParameter(info.id, value);
+
+		buffer.setSize(2, pickBlockSize(random), false, false, true);
+
+		for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+			for (int i = 0; i < buffer.getNumSamples(); ++i)
+				buffer.setSample(channel, i, pickSample(random));
+
+		{
+			RealtimeSafety::ScopedRealtimeSection section;
+			chain.process(buffer);
+		}
+
+		ASSERT_TRUE(chain.wasLastBlockThreaded()) << "block " << block;
+
+		if (RealtimeSafetyChecker::getTotalNumViolations() > 0)
+			break;
+	}
+
+	pool.stop();
+
+	expectNoViolations("EffectChain::process on the thread pool");
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include "RealtimeThreadPool.h"
+
+#include <array>
+
+
+TEST(RealtimeThreadPool, RunsEveryTaskOnce)
+{
+	RealtimeThreadPool pool;
+	pool.start(3);
+	ASSERT_EQ(pool.getNumWorkers(), 3);
+
+	std::array<std::atomic<int>, 8> counts{};
+
+	auto							task = [&counts](int taskIndex) { counts[taskIndex].fetch_add(1); };
+
+	// Later batches must not pick up tasks of earlier ones
+	for (int run = 0; run < 1000; ++run)
+		pool.run(static_cast<int>(counts.size()), task);
+
+	for (const auto &count : counts)
+		EXPECT_EQ(count.load(), 1000);
+}
+
+
+TEST(RealtimeThreadPool, WorksWithoutWorkers)
+{
+	RealtimeThreadPool pool;
+	pool.start(0);
+
+	int	 sum  = 0;
+	auto task = [&sum](int taskIndex) { sum += taskIndex; };
+	pool.run(4, task);
+
+	EXPECT_EQ(sum, 6);
+}
+
+
+TEST(RealtimeThreadPool, WakesParkedWorkers)
+{
+	RealtimeThreadPool pool;
+	pool.start(2);
+
+	// Long enough for the workers to park
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+	std::array<std::atomic<int>, 3> counts{};
+	auto							task = [&counts](int taskIndex) { counts[taskIndex].fetch_add(1); };
+	pool.run(static_cast<int>(counts.size()), task);
+
+	for (const auto &count : counts)
+		EXPECT_EQ(count.load(), 1);
+
+	// Restarting with another number of workers
+	pool.start(1);
+	EXPECT_EQ(pool.getNumWorkers(), 1);
+	pool.run(static_cast<int>(counts.size()), task);
+
+	for (const auto &count : counts)
+		EXPECT_EQ(count.load(), 2);
+}
+
+
+TEST(RealtimeThreadPool, RestartsForANewBlockPeriod)
+{
+	RealtimeThreadPool pool;
+	pool.start(2, 10.0);
+	ASSERT_EQ(pool.getNumWorkers(), 2);
+
+	// A new sample rate or block size reschedules the workers
+	pool.start(2, 5.0);
+	ASSERT_EQ(pool.getNumWorkers(), 2);
+
+	std::array<std::atomic<int>, 3> counts{};
+	auto							task = [&counts](int taskIndex) { counts[taskIndex].fetch_add(1); };
+	pool.run(static_cast<int>(counts.size()), task);
+
+	for (const auto &count : counts)
+		EXPECT_EQ(count.load(), 1);
+
+	pool.stop();
+	EXPECT_EQ(pool.getNumWorkers(), 0);
+}
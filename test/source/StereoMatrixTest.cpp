@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include "StereoMatrix.h"
+
+#include <vector>
+
+
+namespace
+{
+struct StereoBlock
+{
+	explicit StereoBlock(int numSamples) : left(static_cast<size_t>(numSamples)), right(static_cast<size_t>(numSamples))
+	{
+		juce::Random random(7);
+
+		for (size_t i = 0; i < left.size(); ++i)
+		{
+			left[i]	 = random.nextFloat() * 2.0f - 1.0f;
+			right[i] = random.nextFloat() * 2.0f - 1.0f;
+		}
+	}
+
+	std::vector<float> left, right;
+};
+} // namespace
+
+
+TEST(StereoMatrix, StaticGainsMatchTheScalarMix)
+{
+	constexpr int				  numSamples = 37; // Leaves a remainder after the vector loop
+	const StereoMatrix<float>::Gains gains{0.9f, 0.2f, -0.3f, 0.7f};
+
+	StereoBlock					  block(numSamples), input(numSamples);
+	StereoMatrix<float>::process(block.left.data(), block.right.data(), gains, numSamples);
+
+	for (int i = 0; i < numSamples; ++i)
+	{
+		EXPECT_NEAR(block.left[i], 0.9f * input.left[i] + 0.2f * input.right[i], 1.0e-6f);
+		EXPECT_NEAR(block.right[i], -0.3f * input.left[i] + 0.7f * input.right[i], 1.0e-6f);
+	}
+}
+
+
+TEST(StereoMatrix, RampStartsAtTheFirstGainsAndEndsBeforeTheSecond)
+{
+	constexpr int					 numSamples = 64;
+	const StereoMatrix<float>::Gains start{1.0f, 0.0f, 0.0f, 1.0f};
+	const StereoMatrix<float>::Gains end{0.0f, 1.0f, 1.0f, 0.0f}; // Swaps the channels
+
+	std::vector<float>				 left(numSamples, 1.0f), right(numSamples, 0.0f);
+	StereoMatrix<float>::process(left.data(), right.data(), start, end, numSamples);
+
+	// The left input moves linearly from the left to the right output, the next block starts at the end gains
+	for (int i = 0; i < numSamples; ++i)
+	{
+		const float t = static_cast<float>(i) / numSamples;
+		EXPECT_NEAR(left[i], 1.0f - t, 1.0e-6f);
+		EXPECT_NEAR(right[i], t, 1.0e-6f);
+	}
+}
+
+
+TEST(StereoMatrix, PerSampleGainsMatchTheScalarMix)
+{
+	constexpr int	   numSamples = 50;
+	std::vector<float> ll(numSamples), rl(numSamples), lr(numSamples), rr(numSamples);
+
+	for (int i = 0; i < numSamples; ++i)
+	{
+		ll[i] = std::cos(0.1f * i);
+		rl[i] = std::sin(0.1f * i);
+		lr[i] = 0.5f;
+		rr[i] = -0.25f * i;
+	}
+
+	StereoBlock block(numSamples), input(numSamples);
+	StereoMatrix<float>::process(block.left.data(), block.right.data(), {ll.data(), rl.data(), lr.data(), rr.data()}, numSamples);
+
+	for (int i = 0; i < numSamples; ++i)
+	{
+		EXPECT_NEAR(block.left[i], ll[i] * input.left[i] + rl[i] * input.right[i], 1.0e-5f);
+		EXPECT_NEAR(block.right[i], lr[i] * input.left[i] + rr[i] * input.right[i], 1.0e-5f);
+	}
+}
+
+
+TEST(StereoMatrix, WidthAndMidSide)
+{
+	constexpr int numSamples = 16;
+	StereoBlock	  block(numSamples), input(numSamples);
+
+	// Full width leaves the image unchanged
+	StereoMatrix<float>::process(block.left.data(), block.right.data(), StereoMatrix<float>::width(1.0f), numSamples);
+
+	for (int i = 0; i < numSamples; ++i)
+	{
+		EXPECT_FLOAT_EQ(block.left[i], input.left[i]);
+		EXPECT_FLOAT_EQ(block.right[i], input.right[i]);
+	}
+
+	// Encoding and decoding restores the input, zero width leaves the mid on both channels
+	auto decode = StereoMatrix<float>::midSide();
+	for (auto *gain : {&decode.leftToLeft, &decode.rightToLeft, &decode.leftToRight, &decode.rightToRight})
+		*gain *= 2.0f;
+
+	StereoMatrix<float>::process(block.left.data(), block.right.data(), StereoMatrix<float>::midSide(), numSamples);
+	StereoMatrix<float>::process(block.left.data(), block.right.data(), decode, numSamples);
+
+	for (int i = 0; i < numSamples; ++i)
+	{
+		EXPECT_NEAR(block.left[i], input.left[i], 1.0e-6f);
+		EXPECT_NEAR(block.right[i], input.right[i], 1.0e-6f);
+	}
+
+	StereoMatrix<float>::process(block.left.data(), block.right.data(), StereoMatrix<float>::width(0.0f), numSamples);
+
+	for (int i = 0; i < numSamples; ++i)
+	{
+		EXPECT_NEAR(block.left[i], 0.5f * (input.left[i] + input.right[i]), 1.0e-6f);
+		EXPECT_FLOAT_EQ(block.left[i], block.right[i]);
+	}
+}
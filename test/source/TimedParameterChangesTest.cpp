@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+
+#include "TimedParameterChanges.h"
+
+#include <vector>
+
+
+TEST(TimedParameterChanges, KeepsTheChangesSortedByOffset)
+{
+	TimedParameterChanges changes;
+	EXPECT_TRUE(changes.isEmpty());
+
+	changes.add(ParamId::DelayMix, 100, 0.1f);
+	changes.add(ParamId::DelayFeedback, 50, 0.2f);
+	changes.add(ParamId::DelayMix, 100, 0.3f); // Same offset, stays behind the first one
+	changes.add(ParamId::Output, -10, 0.4f);   // Before the block counts as its start
+
+	EXPECT_TRUE(changes.hasChangesFor(ParamId::DelayMix));
+	EXPECT_FALSE(changes.hasChangesFor(ParamId::Input));
+	EXPECT_EQ(changes.getNextOffset(), 0);
+
+	std::vector<std::pair<ParamId, float>> applied;
+	auto								   collect = [&applied](ParamId id, float value) { applied.emplace_back(id, value); };
+
+	changes.applyUntil(60, collect);
+	ASSERT_EQ(applied.size(), 2u);
+	EXPECT_EQ(applied[0].first, ParamId::Output);
+	EXPECT_EQ(applied[1].first, ParamId::DelayFeedback);
+	EXPECT_EQ(changes.getNextOffset(), 100);
+
+	changes.applyUntil(100, collect);
+	ASSERT_EQ(applied.size(), 4u);
+	EXPECT_FLOAT_EQ(applied[2].second, 0.1f);
+	EXPECT_FLOAT_EQ(applied[3].second, 0.3f);
+	EXPECT_TRUE(changes.isEmpty());
+
+	changes.clear();
+	EXPECT_FALSE(changes.hasChangesFor(ParamId::DelayMix));
+}
+
+
+TEST(TimedParameterChanges, FullQueueRejectsChanges)
+{
+	TimedParameterChanges changes;
+
+	for (int change = 0; change < TimedParameterChanges::maxNumChanges; ++change)
+		ASSERT_TRUE(changes.add(ParamId::Output, change, 0.0f));
+
+	EXPECT_FALSE(changes.add(ParamId::Output, 0, 0.0f));
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include "VBAPGainTable.h"
+
+
+namespace
+{
+using Speaker = VBAPGainTable<float>::Speaker;
+
+// Ear level of 5.1 without the LFE
+const std::vector<Speaker> surround51 = {{-30.0, 0.0}, {30.0, 0.0}, {0.0, 0.0}, {-110.0, 0.0}, {110.0, 0.0}};
+
+// 7.1.4 without the LFE
+const std::vector<Speaker> surround714 = {{-30.0, 0.0},	  {30.0, 0.0},	 {0.0, 0.0},	 {-90.0, 0.0},	{90.0, 0.0},	{-150.0, 0.0},
+										  {150.0, 0.0},	  {-45.0, 45.0}, {45.0, 45.0},	 {-135.0, 45.0}, {135.0, 45.0}};
+
+int countActive(const std::vector<float> &gains)
+{
+	return static_cast<int>(std::count_if(gains.begin(), gains.end(), [](float gain) { return gain > 1.0e-6f; }));
+}
+
+float power(const std::vector<float> &gains)
+{
+	float sum = 0.0f;
+	for (float gain : gains)
+		sum += gain * gain;
+	return sum;
+}
+} // namespace
+
+
+TEST(VBAPGainTable, SourceOnASpeakerPlaysOnlyThatSpeaker)
+{
+	for (const auto *layout : {&surround51, &surround714})
+	{
+		VBAPGainTable<float> table;
+		table.build(*layout);
+		std::vector<float> gains(layout->size());
+
+		for (size_t speaker = 0; speaker < layout->size(); ++speaker)
+		{
+			table.getGains(static_cast<float>((*layout)[speaker].azimuth), static_cast<float>((*layout)[speaker].elevation), gains.data());
+
+			for (size_t other = 0; other < layout->size(); ++other)
+				EXPECT_NEAR(gains[other], other == speaker ? 1.0f : 0.0f, 1.0e-5f) << "speaker " << speaker << ", gain " << other;
+		}
+	}
+}
+
+
+TEST(VBAPGainTable, HorizontalLayoutsUseAdjacentPairs)
+{
+	VBAPGainTable<float> table;
+	table.build(surround51);
+	EXPECT_FALSE(table.isThreeDimensional());
+
+	std::vector<float> gains(surround51.size());
+
+	// Halfway between the right front (30) and the right surround (110), not L + Rs which also enclose it
+	table.getGains(70.0f, 0.0f, gains.data());
+	EXPECT_NEAR(gains[1], std::sqrt(0.5f), 1.0e-4f);
+	EXPECT_NEAR(gains[4], std::sqrt(0.5f), 1.0e-4f);
+	EXPECT_EQ(countActive(gains), 2);
+
+	// Behind the listener, -180 and 180 are the same direction
+	table.getGains(180.0f, 0.0f, gains.data());
+	EXPECT_NEAR(gains[3], std::sqrt(0.5f), 1.0e-4f);
+	EXPECT_NEAR(gains[4], std::sqrt(0.5f), 1.0e-4f);
+
+	std::vector<float> wrapped(surround51.size());
+	table.getGains(-180.0f, 0.0f, wrapped.data());
+	for (size_t speaker = 0; speaker < gains.size(); ++speaker)
+		EXPECT_NEAR(wrapped[speaker], gains[speaker], 1.0e-6f);
+}
+
+
+TEST(VBAPGainTable, InterpolatedGainsKeepTheirPower)
+{
+	for (const auto *layout : {&surround51, &surround714})
+	{
+		VBAPGainTable<float> table;
+		table.build(*layout);
+
+		std::vector<float>	gains(layout->size());
+		std::vector<double> exact(layout->size());
+		float				maxPowerError = 0.0f, maxGainError = 0.0f;
+
+		// Between the grid points of both axes
+		for (float elevation = 0.0f; elevation <= 90.0f; elevation += table.isThreeDimensional() ? 3.7f : 100.0f)
+		{
+			for (float azimuth = -180.0f; azimuth < 180.0f; azimuth += 0.37f)
+			{
+				table.getGains(azimuth, elevation, gains.data());
+				VBAPGainTable<float>::computeGains(*layout, azimuth, elevation, exact.data());
+
+				maxPowerError = std::max(maxPowerError, std::abs(10.0f * std::log10(power(gains))));
+
+				for (size_t speaker = 0; speaker < gains.size(); ++speaker)
+					maxGainError = std::max(maxGainError, std::abs(gains[speaker] - static_cast<float>(exact[speaker])));
+			}
+		}
+
+		RecordProperty(table.isThreeDimensional() ? "MaxGainError714" : "MaxGainError51", std::to_string(maxGainError));
+		EXPECT_LT(maxPowerError, 0.1f);
+	}
+}
+
+
+TEST(VBAPGainTable, HeightLayoutReachesTheZenith)
+{
+	VBAPGainTable<float> table;
+	table.build(surround714);
+	EXPECT_TRUE(table.isThreeDimensional());
+
+	std::vector<float> gains(surround714.size());
+	table.getGains(0.0f, 90.0f, gains.data());
+
+	// Only the height speakers play, the ear level is silent
+	for (size_t speaker = 0; speaker < 7; ++speaker)
+		EXPECT_NEAR(gains[speaker], 0.0f, 1.0e-6f);
+
+	EXPECT_NEAR(power(gains), 1.0f, 1.0e-3f);
+}